@@ -0,0 +1,119 @@
+#include "channel_render_cache.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+namespace elda::ui
+{
+
+namespace
+{
+const ImVec4 k_default_trace_color = ImVec4(0.10f, 0.80f, 0.95f, 1.0f);
+
+ImVec4 parse_hex_color(const std::string& hex, const ImVec4& fallback)
+{
+    auto hv = [](char c) -> int
+    {
+        if (c >= '0' && c <= '9')
+            return c - '0';
+        if (c >= 'a' && c <= 'f')
+            return 10 + (c - 'a');
+        if (c >= 'A' && c <= 'F')
+            return 10 + (c - 'A');
+        return 0;
+    };
+    if (hex.empty())
+        return fallback;
+    const char* s = hex.c_str();
+    if (*s == '#')
+        ++s;
+    const size_t n = std::strlen(s);
+    auto to01 = [&](int hi, int lo) -> float
+    {
+        return float((hi << 4) | lo) / 255.0f;
+    };
+    float r = fallback.x, g = fallback.y, b = fallback.z, a = fallback.w;
+    if (n == 3)
+    {
+        r = hv(s[0]) / 15.0f;
+        g = hv(s[1]) / 15.0f;
+        b = hv(s[2]) / 15.0f;
+        a = 1.0f;
+    }
+    else if (n == 6 || n == 8)
+    {
+        r = to01(hv(s[0]), hv(s[1]));
+        g = to01(hv(s[2]), hv(s[3]));
+        b = to01(hv(s[4]), hv(s[5]));
+        a = (n == 8) ? to01(hv(s[6]), hv(s[7])) : 1.0f;
+    }
+    return ImVec4(r, g, b, a);
+}
+}  // namespace
+
+void ChannelRenderCache::rebuild(const std::vector<const models::Channel*>& selected, int ring_channels)
+{
+    const bool use_selected = !selected.empty();
+    const int rows = std::max(1, use_selected ? static_cast<int>(selected.size()) : ring_channels);
+
+    rows_.assign(static_cast<size_t>(rows), ChannelRenderDescriptor{});
+    for (int row = 0; row < rows; ++row)
+    {
+        ChannelRenderDescriptor& descriptor = rows_[row];
+        const models::Channel* meta = use_selected ? selected[row] : nullptr;
+
+        // A valid amplifier index places the channel; otherwise rows map one-to-one onto ring channels
+        int channel = row;
+        if (meta && meta->amplifier_channel >= 0 && meta->amplifier_channel < ring_channels)
+        {
+            channel = meta->amplifier_channel;
+        }
+        descriptor.channel = channel < ring_channels ? channel : -1;
+
+        descriptor.color = (meta && !meta->color.empty()) ? parse_hex_color(meta->color, k_default_trace_color)
+                                                          : k_default_trace_color;
+
+        char text[64];
+        if (meta && !meta->name.empty())
+        {
+            descriptor.trace_id = meta->name;
+            descriptor.previous_id = "##prev_" + meta->name;
+            descriptor.label = meta->name;
+        }
+        else
+        {
+            std::snprintf(text, sizeof(text), "Ch%02d", row + 1);
+            descriptor.trace_id = text;
+            std::snprintf(text, sizeof(text), "##prev_ch%02d", row + 1);
+            descriptor.previous_id = text;
+            std::snprintf(text, sizeof(text), "ch%02d", row + 1);
+            descriptor.label = text;
+        }
+    }
+
+    std::printf("[ChartCache] %d rows resolved (%d ring channels)\n", rows, ring_channels);
+}
+
+void ChannelRenderCache::rebuild(const dsp::Montage& montage, const std::vector<ChannelRenderDescriptor>& electrodes)
+{
+    const int rows = montage.rows();
+    rows_.assign(static_cast<size_t>(rows), ChannelRenderDescriptor{});
+    for (int row = 0; row < rows; ++row)
+    {
+        ChannelRenderDescriptor& descriptor = rows_[row];
+        const int electrode = montage.electrode(row);
+        descriptor.channel = montage.empty(row) ? -1 : row;
+        descriptor.color = electrode >= 0 && electrode < static_cast<int>(electrodes.size())
+                               ? electrodes[electrode].color
+                               : k_default_trace_color;
+        descriptor.label = montage.label(row);
+        descriptor.trace_id = descriptor.label;
+        descriptor.previous_id = "##prev_" + descriptor.label;
+    }
+
+    std::printf(
+        "[ChartCache] %d %s rows resolved (%d terms)\n", rows, dsp::montage_to_string(montage.kind()), montage.terms());
+}
+
+}  // namespace elda::ui
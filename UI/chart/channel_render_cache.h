@@ -0,0 +1,58 @@
+#pragma once
+
+#include "core/dsp/montage.h"
+#include "imgui.h"
+#include "models/channel.h"
+
+#include <string>
+#include <vector>
+
+namespace elda::ui
+{
+
+/**
+ * Everything draw_chart() needs to know about one row besides its samples
+ */
+struct ChannelRenderDescriptor
+{
+    int channel = -1;         // Ring channel (montage row) shown in the row (amplifier index resolved); -1 = empty row
+    ImVec4 color;             // Trace colour, parsed from the channel's hex string
+    std::string trace_id;     // PlotLineG label of the current-cycle segment
+    std::string previous_id;  // Hidden label ("##prev_...") of the previous-cycle segment
+    std::string label;        // Left margin text
+};
+
+/**
+ * ChannelRenderCache - per-row render descriptors, resolved once per configuration
+ *
+ * Colours, labels and plot IDs only change when the channel group or the ring
+ * shape does, so the owner rebuilds this on those state changes and the chart's
+ * per-row loop is left with sample work only.
+ */
+class ChannelRenderCache
+{
+  public:
+    /**
+     * Re-resolve every row
+     * @param selected Channels of the active group, one row each; empty = one row per ring channel
+     * @param ring_channels Channels held by the ring; rows whose channel falls outside it stay empty
+     */
+    void rebuild(const std::vector<const models::Channel*>& selected, int ring_channels);
+
+    /**
+     * Re-resolve for a montage: row r shows montage row r, labelled by the montage and
+     * coloured like its electrode
+     * @param electrodes Rows of the referential rebuild() the montage was built from
+     */
+    void rebuild(const dsp::Montage& montage, const std::vector<ChannelRenderDescriptor>& electrodes);
+
+    const std::vector<ChannelRenderDescriptor>& rows() const
+    {
+        return rows_;
+    }
+
+  private:
+    std::vector<ChannelRenderDescriptor> rows_;
+};
+
+}  // namespace elda::ui
@@ -1,111 +1,106 @@
 // chart.cpp — Fixed time base, fixed gain (px/µV), pixel-locked Y BEFORE any locking calls
 #include "chart.h"
 
+#include "channel_render_cache.h"
+#include "core/worker_pool.h"
+#include "gl_trace_renderer.h"
 #include "imgui.h"
 #include "implot.h"
-#include "models/channel.h"
+#include "row_pager.h"
+#include "sweep_trace.h"
+#include "trace_decimator.h"
 
 #include <algorithm>
 #include <cmath>
-#include <cstdio>
-#include <cstring>
-#include <string>
 #include <vector>
 
 static constexpr float k_left_label_inset_px = 20.0f;
 static constexpr float k_left_spacing_px = 56.0f;
-static constexpr float k_top_pad_px = 8.0f;
-static constexpr float k_preferred_row_px = 120.0f;
-static constexpr float k_min_row_px = 8.0f;
 static constexpr int k_wiper_width_px = 10;
 
 static const ImVec4 k_label_color_normal = ImVec4(0.72f, 0.76f, 0.80f, 1.0f);
 
-static ImVec4 parse_hex_color(const std::string& hex, const ImVec4& fallback)
+// PlotLineG payload: one cached envelope segment, two points per pixel column
+struct EnvelopeSeries
 {
-    auto hv = [](char c) -> int
-    {
-        if (c >= '0' && c <= '9')
-            return c - '0';
-        if (c >= 'a' && c <= 'f')
-            return 10 + (c - 'a');
-        if (c >= 'A' && c <= 'F')
-            return 10 + (c - 'A');
-        return 0;
-    };
-    if (hex.empty())
-        return fallback;
-    const char* s = hex.c_str();
-    if (*s == '#')
-        ++s;
-    const size_t n = std::strlen(s);
-    auto to01 = [&](int hi, int lo) -> float
-    {
-        return float((hi << 4) | lo) / 255.0f;
-    };
-    float r = fallback.x, g = fallback.y, b = fallback.z, a = fallback.w;
-    if (n == 3)
-    {
-        r = hv(s[0]) / 15.0f;
-        g = hv(s[1]) / 15.0f;
-        b = hv(s[2]) / 15.0f;
-        a = 1.0f;
-    }
-    else if (n == 6 || n == 8)
-    {
-        r = to01(hv(s[0]), hv(s[1]));
-        g = to01(hv(s[2]), hv(s[3]));
-        b = to01(hv(s[4]), hv(s[5]));
-        a = (n == 8) ? to01(hv(s[6]), hv(s[7])) : 1.0f;
-    }
-    return ImVec4(r, g, b, a);
-}
+    const elda::ui::EnvelopeSegment* segment;
+    double y_base;
+    double gain;
+};
 
-struct PlotBuffers
+static ImPlotPoint envelope_point(int idx, void* user_data)
 {
-    std::vector<float> xs_prev;
-    std::vector<float> ys_prev;
-    std::vector<float> xs_cur;
-    std::vector<float> ys_cur;
-
-    void clear()
-    {
-        xs_prev.clear();
-        ys_prev.clear();
-        xs_cur.clear();
-        ys_cur.clear();
-    }
+    const EnvelopeSeries& series = *static_cast<const EnvelopeSeries*>(user_data);
+    const elda::ui::EnvelopeSegment& segment = *series.segment;
+    const int column = segment.first + idx / 2;
+    const elda::ui::EnvelopeColumn& extremes = column == segment.first ? segment.head : segment.columns[column];
+    const float value = (idx & 1) ? extremes.second : extremes.first;
+    // FIXED gain: value is µV; multiply by px/µV
+    return ImPlotPoint(segment.grid.column_x(column), series.y_base + series.gain * value);
+}
 
-    void reserve(int n)
-    {
-        xs_prev.reserve(n);
-        ys_prev.reserve(n);
-        xs_cur.reserve(n);
-        ys_cur.reserve(n);
-    }
+// PlotLineG payload: raw samples [first, first + count) of one channel (montage row), read in place from the ring
+struct RawSeries
+{
+    const elda::SampleRing* ring;
+    const elda::dsp::Montage* montage;  // nullptr = referential
+    const elda::SampleRing* average;
+    int channel;
+    uint64_t first;
+    uint64_t origin;  // Sample index at x = 0
+    double y_base;
+    double gain;
 };
 
-static inline int
-resolve_channel_index(int v, const std::vector<const elda::models::Channel*>& selected, const elda::ChartData& data)
+static ImPlotPoint raw_point(int idx, void* user_data)
 {
-    int c = v;
-    const elda::models::Channel* meta = (v < static_cast<int>(selected.size())) ? selected[v] : nullptr;
+    const RawSeries& series = *static_cast<const RawSeries*>(user_data);
+    const elda::SampleRing& ring = *series.ring;
+    const uint64_t n = series.first + static_cast<uint64_t>(idx);
+    const double x = static_cast<double>(n - series.origin) / ring.sample_rate_hz();
+    const float value = series.montage ? series.montage->sample(ring, series.average, series.channel, n)
+                                       : ring.sample(series.channel, ring.slot_of(n));
+    return ImPlotPoint(x, series.y_base + series.gain * value);
+}
 
-    if (meta && meta->amplifier_channel >= 0 && meta->amplifier_channel < static_cast<int>(data.ring.data.size()))
-    {
-        c = meta->amplifier_channel;
-    }
-    return c;
+elda::WorkerPool& chart_worker_pool()
+{
+    static elda::WorkerPool pool(elda::WorkerPool::default_workers());
+    return pool;
+}
+
+elda::ui::RowPager& chart_row_pager()
+{
+    static elda::ui::RowPager pager;
+    return pager;
 }
 
-void draw_chart(const elda::ChartData& data, const std::vector<const elda::models::Channel*>& selected_channels)
+void draw_chart(const elda::ChartData& data)
 {
-    static PlotBuffers plot_buffers;
+    // Per-row envelope caches; only columns the cursor moved through are reduced each frame
+    static std::vector<elda::ui::SweepTrace> traces;
+    // Optional GPU backend for the envelope traces (ChartBackend::OpenGL)
+    static elda::ui::GlTraceRenderer gl_renderer;
 
-    const bool use_selected = !selected_channels.empty();
-    const int total_channels = data.num_channels;
-    const int visible_count = use_selected ? static_cast<int>(selected_channels.size()) : total_channels;
-    const int rows = std::max(1, visible_count);
+    if (!data.ring.source || !data.channels)
+    {
+        return;
+    }
+    const elda::SampleRing& ring = *data.ring.source;
+
+    // Colours, labels and IDs were resolved when the channel configuration last changed
+    const std::vector<elda::ui::ChannelRenderDescriptor>& descriptors = data.channels->rows();
+    const int rows = static_cast<int>(descriptors.size());
+    const elda::dsp::Montage* montage = data.montage;
+    auto row_channel = [&](int row)
+    {
+        const int channel = descriptors[row].channel;
+        if (montage)
+        {
+            return channel < montage->rows() && !montage->empty(channel) ? channel : -1;
+        }
+        return channel < ring.channels() ? channel : -1;  // ring is re-shaped when monitoring starts
+    };
 
     ImGui::BeginChild("##eegchild", ImVec2(0, 0), false, ImGuiWindowFlags_NoScrollbar);
 
@@ -117,6 +112,11 @@ void draw_chart(const elda::ChartData& data, const std::vector<const elda::model
     const double x_min = -left_padding_time;
     const double x_max = window_sec;
 
+    // Rows outside the page are neither prepared nor submitted
+    const elda::ui::RowPage page = chart_row_pager().layout(rows, avail_height);
+    const int first_row = page.first;
+    const int visible_rows = page.count;
+
     // Style
     ImPlot::PushStyleVar(ImPlotStyleVar_PlotPadding, ImVec2(0, 0));
     ImPlot::PushStyleVar(ImPlotStyleVar_LabelPadding, ImVec2(2, 2));
@@ -140,114 +140,160 @@ void draw_chart(const elda::ChartData& data, const std::vector<const elda::model
         ImPlot::SetupAxis(ImAxis_Y1, nullptr, axis_flags);
         ImPlot::SetupFinish();  // ---- lock: no more Setup* below this line ----
 
-        // Row spacing (auto-pack to fit)
-        const double row_height_px = std::min<double>(
-            k_preferred_row_px, std::max<double>(k_min_row_px, (avail_height - k_top_pad_px) / std::max(1, rows)));
-
-        // Sweep timing
-        const double smoothed_cursor = data.playhead_seconds;
-        const double cycle_cur = std::floor(smoothed_cursor / window_sec);
-        const double cursor_x = smoothed_cursor - cycle_cur * window_sec;
-        const double eps = 0.5 / std::max(1, data.sample_rate_hz);
-
-        const double prev_cycle_start = (cycle_cur - 1.0) * window_sec;
-        const double prev_cycle_end = cycle_cur * window_sec;
-        const double cur_cycle_start = cycle_cur * window_sec;
-        const double cur_cycle_end = (cycle_cur + 1.0) * window_sec;
-        const double cursor_abs_time = cur_cycle_start + cursor_x;
+        // Sweep timing in exact 64-bit sample indices; seconds only appear relative to a cycle start
+        const double rate = ring.sample_rate_hz();
+        const auto window_samples = static_cast<uint64_t>(std::max<long long>(1, std::llround(window_sec * rate)));
+        const uint64_t published = data.ring.published;
+        const uint64_t oldest = published - static_cast<uint64_t>(data.ring.size());
+
+        const uint64_t cur_cycle_start = (published / window_samples) * window_samples;
+        const uint64_t cursor_offset = published - cur_cycle_start;  // samples already swept this cycle
+        const double cursor_x = static_cast<double>(cursor_offset) / rate;
+
+        // Previous cycle is visible only ahead of the cursor
+        const bool has_prev_cycle = cur_cycle_start >= window_samples;
+        const uint64_t prev_cycle_start = has_prev_cycle ? cur_cycle_start - window_samples : 0;
+        const uint64_t prev_begin = has_prev_cycle ? std::max(oldest, prev_cycle_start + cursor_offset) : cur_cycle_start;
+        const uint64_t cur_begin = std::max(oldest, cur_cycle_start);
+
+        // Samples per horizontal pixel; at >= 1 each channel is reduced to a min/max envelope
+        const double px_per_second = std::max(1.0f, avail_width) / (x_max - x_min);
+        const double samples_per_px = rate / px_per_second;
+        const bool decimate = samples_per_px >= 1.0;
+
+        // The GL backend draws envelopes only; below one sample per pixel ImPlot plots the raw samples
+        const bool use_gl = decimate && data.backend == elda::ChartBackend::OpenGL && gl_renderer.available();
+        if (use_gl)
+        {
+            // +1: a snapped column edge can start one extra column before the cycle end
+            gl_renderer.begin_frame(visible_rows, static_cast<int>(std::ceil(window_samples / samples_per_px)) + 1);
+        }
 
-        const int estimated_points = static_cast<int>(window_sec * data.sample_rate_hz * 1.1);
+        // Off-screen rows keep their caches as they were; they catch up (or rebuild) when scrolled back in
+        traces.resize(static_cast<size_t>(rows));
+        if (decimate)
+        {
+            // One pyramid snapshot shared by every trace of this frame; rows own their traces
+            // Preparation is fanned out per row; ImGui/ImPlot calls stay on this thread
+            const elda::ui::ColumnReducer reducer(ring, data.pyramid, montage, data.average);
+            chart_worker_pool().parallel_for(visible_rows,
+                                             [&](int slot)
+                                             {
+                                                 const int row = first_row + slot;
+                                                 const int channel = row_channel(row);
+                                                 if (channel >= 0)
+                                                 {
+                                                     traces[row].update(reducer,
+                                                                        channel,
+                                                                        published,
+                                                                        oldest,
+                                                                        window_samples,
+                                                                        samples_per_px);
+                                                 }
+                                             });
+        }
 
         // Plot channels (fixed gain px/µV)
-        for (int row = 0; row < rows; ++row)
+        for (int slot = 0; slot < visible_rows; ++slot)
         {
-            const int visible_index = row;
-            const int channel_index =
-                use_selected ? resolve_channel_index(visible_index, selected_channels, data) : visible_index;
+            const int row = first_row + slot;
+            const elda::ui::ChannelRenderDescriptor& descriptor = descriptors[row];
+            const int channel_index = row_channel(row);
+            if (channel_index < 0)
+            {
+                if (use_gl)
+                {
+                    gl_renderer.clear_row(slot);
+                }
+                continue;
+            }
 
-            const double y_base = k_top_pad_px + (row + 0.5) * row_height_px;
+            const double y_base = page.baseline(slot);
+            const ImVec4& line_color = descriptor.color;
 
-            plot_buffers.clear();
-            plot_buffers.reserve(estimated_points);
+            if (use_gl)
+            {
+                gl_renderer.stage_row(slot, row, traces[row], line_color.x, line_color.y, line_color.z, line_color.w);
+                continue;
+            }
 
-            const int start_index = data.ring.filled ? data.ring.write : 0;
-            const int total_samples = data.ring.filled ? data.buffer_size : data.ring.write;
+            const char* id_prev = descriptor.previous_id.c_str();
+            const char* id_cur = descriptor.trace_id.c_str();
 
-            for (int offset = 0; offset < total_samples; ++offset)
+            if (decimate)
             {
-                const int i = (start_index + offset) % data.buffer_size;
-                const double t = data.ring.t_abs[i];
-                if (t < prev_cycle_start)
-                    continue;
-                if (t > cur_cycle_end)
-                    break;
-
-                // FIXED gain: sample is µV; multiply by px/µV
-                const double y = y_base + data.gain_multiplier * data.ring.data[channel_index][i];
+                const elda::ui::SweepTrace& trace = traces[row];
+                EnvelopeSeries prev{&trace.previous(), y_base, data.gain_multiplier};
+                EnvelopeSeries cur{&trace.current(), y_base, data.gain_multiplier};
 
-                if (t >= cur_cycle_start && t < cur_cycle_end)
+                ImPlot::SetNextLineStyle(line_color, 1.0f);
+                if (prev.segment->points() > 0)
                 {
-                    if (t < cursor_abs_time - eps)
-                    {
-                        plot_buffers.xs_cur.push_back(static_cast<float>(t - cur_cycle_start));
-                        plot_buffers.ys_cur.push_back(static_cast<float>(y));
-                    }
+                    ImPlot::PlotLineG(id_prev, envelope_point, &prev, prev.segment->points());
                 }
-                else if (t >= prev_cycle_start && t < prev_cycle_end)
+
+                ImPlot::SetNextLineStyle(line_color, 1.0f);
+                if (cur.segment->points() > 0)
                 {
-                    const float relative_x = static_cast<float>(t - prev_cycle_start);
-                    if (relative_x >= cursor_x - eps)
-                    {
-                        plot_buffers.xs_prev.push_back(relative_x);
-                        plot_buffers.ys_prev.push_back(static_cast<float>(y));
-                    }
+                    ImPlot::PlotLineG(id_cur, envelope_point, &cur, cur.segment->points());
                 }
             }
-
-            const elda::models::Channel* meta =
-                (use_selected && row < static_cast<int>(selected_channels.size())) ? selected_channels[row] : nullptr;
-
-            const ImVec4 k_cyan = ImVec4(0.10f, 0.80f, 0.95f, 1.0f);
-            ImVec4 line_color = (meta && !meta->color.empty()) ? parse_hex_color(meta->color, k_cyan) : k_cyan;
-
-            const char* base_name = (meta && !meta->name.empty()) ? meta->name.c_str() : nullptr;
-
-            char id_prev[64];
-            char id_cur[64];
-            if (base_name)
-            {
-                std::snprintf(id_prev, sizeof(id_prev), "##prev_%s", base_name);
-                std::snprintf(id_cur, sizeof(id_cur), "%s", base_name);
-            }
             else
             {
-                std::snprintf(id_prev, sizeof(id_prev), "##prev_ch%02d", row + 1);
-                std::snprintf(id_cur, sizeof(id_cur), "Ch%02d", row + 1);
-            }
-
-            ImPlot::SetNextLineStyle(line_color, 1.0f);
-            if (!plot_buffers.xs_prev.empty())
-            {
-                ImPlot::PlotLine(id_prev,
-                                 plot_buffers.xs_prev.data(),
-                                 plot_buffers.ys_prev.data(),
-                                 static_cast<int>(plot_buffers.xs_prev.size()));
-            }
+                RawSeries prev{&ring,
+                               montage,
+                               data.average,
+                               channel_index,
+                               prev_begin,
+                               prev_cycle_start,
+                               y_base,
+                               data.gain_multiplier};
+                RawSeries cur{&ring,
+                              montage,
+                              data.average,
+                              channel_index,
+                              cur_begin,
+                              cur_cycle_start,
+                              y_base,
+                              data.gain_multiplier};
+
+                ImPlot::SetNextLineStyle(line_color, 1.0f);
+                if (cur_cycle_start > prev_begin)
+                {
+                    ImPlot::PlotLineG(id_prev, raw_point, &prev, static_cast<int>(cur_cycle_start - prev_begin));
+                }
 
-            ImPlot::SetNextLineStyle(line_color, 1.0f);
-            if (!plot_buffers.xs_cur.empty())
-            {
-                ImPlot::PlotLine(id_cur,
-                                 plot_buffers.xs_cur.data(),
-                                 plot_buffers.ys_cur.data(),
-                                 static_cast<int>(plot_buffers.xs_cur.size()));
+                ImPlot::SetNextLineStyle(line_color, 1.0f);
+                if (published > cur_begin)
+                {
+                    ImPlot::PlotLineG(id_cur, raw_point, &cur, static_cast<int>(published - cur_begin));
+                }
             }
         }
 
-        // Wiper (OK to use plot queries; NO Setup* calls below)
         ImDrawList* draw_list = ImPlot::GetPlotDrawList();
         ImVec2 plot_pos = ImPlot::GetPlotPos();
         ImVec2 plot_size = ImPlot::GetPlotSize();
+
+        if (use_gl)
+        {
+            // Same axes as the ImPlot path; drawn in order with the plot, under the wiper below
+            elda::ui::TraceLayout layout;
+            layout.plot_x = plot_pos.x;
+            layout.plot_y = plot_pos.y;
+            layout.plot_w = plot_size.x;
+            layout.plot_h = plot_size.y;
+            layout.x_min = x_min;
+            layout.x_max = x_max;
+            layout.y_max = std::max(1.0f, avail_height);
+            layout.seconds_per_column = samples_per_px / rate;
+            layout.row_base = page.baseline(0);
+            layout.row_height = page.row_height;
+            layout.gain = data.gain_multiplier;
+            gl_renderer.submit(draw_list, layout);
+        }
+
+        // Wiper (OK to use plot queries; NO Setup* calls below)
         ImVec2 cursor_pixels = ImPlot::PlotToPixels(ImPlotPoint(cursor_x, 0.0));
         int cursor_pixel_x = static_cast<int>(std::floor(cursor_pixels.x));
         int x0 = static_cast<int>(std::max(plot_pos.x, static_cast<float>(cursor_pixel_x)));
@@ -269,29 +315,19 @@ void draw_chart(const elda::ChartData& data, const std::vector<const elda::model
         // Left labels
         const ImPlotRect limits = ImPlot::GetPlotLimits();
         const double x_left = limits.X.Min;
-        for (int row = 0; row < rows; ++row)
+        ImPlot::PushStyleColor(ImPlotCol_InlayText, k_label_color_normal);
+        for (int slot = 0; slot < visible_rows; ++slot)
         {
-            const elda::models::Channel* meta =
-                (use_selected && row < static_cast<int>(selected_channels.size())) ? selected_channels[row] : nullptr;
-
-            char label[64];
-            if (meta && !meta->name.empty())
-            {
-                std::snprintf(label, sizeof(label), "%s", meta->name.c_str());
-            }
-            else
-            {
-                std::snprintf(label, sizeof(label), "ch%02d", row + 1);
-            }
-
-            const double row_height_for_label = std::min<double>(
-                k_preferred_row_px, std::max<double>(k_min_row_px, (avail_height - k_top_pad_px) / std::max(1, rows)));
-            const double y_base = k_top_pad_px + (row + 0.5) * row_height_for_label;
-
-            ImPlot::PushStyleColor(ImPlotCol_InlayText, k_label_color_normal);
-            ImPlot::PlotText(label, x_left, y_base, ImVec2(+k_left_label_inset_px, 0.0f), ImPlotTextFlags_None);
-            ImPlot::PopStyleColor();
+            ImPlot::PlotText(descriptors[first_row + slot].label.c_str(),
+                             x_left,
+                             page.baseline(slot),
+                             ImVec2(+k_left_label_inset_px, 0.0f),
+                             ImPlotTextFlags_None);
         }
+        ImPlot::PopStyleColor();
+
+        // Scroll position along the right edge when not every row fits
+        elda::ui::RowPager::draw_scroll_bar(draw_list, plot_pos, plot_size, page);
 
         ImPlot::EndPlot();
     }
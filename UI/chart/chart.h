@@ -1,5 +1,22 @@
 #pragma once
 #include "chart_data.h"
-#include "models/channel.h"
 
-void draw_chart(const elda::ChartData& data, const std::vector<const elda::models::Channel*>& selected_channels);
+namespace elda
+{
+class WorkerPool;
+namespace ui
+{
+class RowPager;
+}
+}  // namespace elda
+
+void draw_chart(const elda::ChartData& data);
+
+/**
+ * Scrolling per-row spectrogram of the same rows as draw_chart (ChartView::Spectrogram)
+ */
+void draw_spectrogram(const elda::ChartData& data);
+
+// Shared by both views: one pool for per-row preparation, one scroll position for the montage
+elda::WorkerPool& chart_worker_pool();
+elda::ui::RowPager& chart_row_pager();
@@ -1,11 +1,42 @@
 #ifndef ELDA_CHART_DATA_H
 #define ELDA_CHART_DATA_H
 
-#include <vector>
+#include "core/dsp/montage.h"
+#include "core/minmax_pyramid.h"
+#include "core/sample_ring.h"
+
+#include <cstdint>
 
 namespace elda
 {
 
+namespace ui
+{
+class ChannelRenderCache;
+}
+
+/**
+ * Trace renderer used by draw_chart
+ *  ImPlot - one PlotLineG per trace segment (CPU tessellation)
+ *  OpenGL - all envelope traces in one instanced draw (falls back to ImPlot if unavailable)
+ */
+enum class ChartBackend
+{
+    ImPlot = 0,
+    OpenGL
+};
+
+/**
+ * What the chart area shows
+ *  Sweep       - time-domain traces (draw_chart)
+ *  Spectrogram - scrolling per-row power spectra (draw_spectrogram)
+ */
+enum class ChartView
+{
+    Sweep = 0,
+    Spectrogram
+};
+
 /**
  * ChartData - Clean interface for draw_chart
  * This is what draw_chart needs, nothing more
@@ -15,21 +46,41 @@ struct ChartData
     // Display settings (extracted from your AppState)
     double amplitude_pp_uv;   // From st.ampPPuV()
     double window_seconds;    // From st.windowSec()
-    double playhead_seconds;  // From st.playheadSeconds
+    double playhead_seconds;  // Derived: ring.published / sample rate
     double gain_multiplier;   // From st.gainMul()
 
     int num_channels;
     int sample_rate_hz;
     int buffer_size;
 
-    // Ring buffer (extracted from st.ring)
+    // Read-only snapshot view over the live ring: no samples are copied per frame.
+    // Only indices below `published` are read; the producer keeps appending past it.
     struct
     {
-        std::vector<double> t_abs;              // Time absolute
-        std::vector<std::vector<double>> data;  // [channel][sample]
-        int write;
-        bool filled;
+        const SampleRing* source = nullptr;
+        uint64_t published = 0;  // Snapshot epoch: total samples visible to this frame
+        int write = 0;           // Slot of the next sample (== published % buffer_size)
+        bool filled = false;     // Ring has wrapped at least once
+
+        int size() const
+        {
+            return filled ? source->capacity() : write;
+        }
     } ring;
+
+    // Min/max summaries of the same ring (shared read-only); nullptr = decimate from raw samples
+    const MinMaxPyramid* pyramid = nullptr;
+
+    // Rows as montage combinations of ring channels (nullptr = referential: row channel is a ring channel)
+    const dsp::Montage* montage = nullptr;
+    // Common average of the EEG channels, same indices as ring (input of the average montage)
+    const SampleRing* average = nullptr;
+
+    // Per-row colours, labels and plot IDs; rebuilt by the owner on channel configuration changes
+    const ui::ChannelRenderCache* channels = nullptr;
+
+    ChartBackend backend = ChartBackend::ImPlot;
+    ChartView view = ChartView::Sweep;
 };
 
 }  // namespace elda
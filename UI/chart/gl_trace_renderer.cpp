@@ -0,0 +1,330 @@
+#include "gl_trace_renderer.h"
+
+#include "imgui.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <glad/glad.h>
+#include <limits>
+
+namespace elda::ui
+{
+
+namespace
+{
+constexpr float k_no_value = std::numeric_limits<float>::quiet_NaN();
+
+// instance = row, vertex = 2 * column + extreme; columns are stored [column][row]
+const char* const k_vertex_shader = R"(#version 150
+uniform samplerBuffer u_columns;
+uniform samplerBuffer u_colors;
+uniform int u_rows;
+uniform vec2 u_x_map;    // column -> NDC x (scale, offset)
+uniform vec2 u_y_map;    // plot y -> NDC y (scale, offset)
+uniform vec3 u_row_map;  // row 0 baseline, row step, px per uV
+out vec4 v_color;
+out float v_valid;
+void main()
+{
+    int column = gl_VertexID / 2;
+    vec2 extremes = texelFetch(u_columns, column * u_rows + gl_InstanceID).rg;
+    float value = (gl_VertexID % 2 == 0) ? extremes.x : extremes.y;
+    v_valid = isnan(value) ? 0.0 : 1.0;
+    float y = u_row_map.x + float(gl_InstanceID) * u_row_map.y + u_row_map.z * (isnan(value) ? 0.0 : value);
+    gl_Position = vec4(float(column) * u_x_map.x + u_x_map.y, y * u_y_map.x + u_y_map.y, 0.0, 1.0);
+    v_color = texelFetch(u_colors, gl_InstanceID);
+}
+)";
+
+// A segment touching a NaN column is dropped whole, like ImPlot's SkipNaN gaps
+const char* const k_fragment_shader = R"(#version 150
+in vec4 v_color;
+in float v_valid;
+out vec4 out_color;
+void main()
+{
+    if (v_valid < 0.999)
+        discard;
+    out_color = v_color;
+}
+)";
+
+GLuint compile_shader(GLenum type, const char* source)
+{
+    const GLuint shader = glCreateShader(type);
+    glShaderSource(shader, 1, &source, nullptr);
+    glCompileShader(shader);
+
+    GLint status = GL_FALSE;
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &status);
+    if (status != GL_TRUE)
+    {
+        char log[1024] = {};
+        glGetShaderInfoLog(shader, sizeof(log), nullptr, log);
+        std::printf("[Chart] trace shader failed to compile: %s\n", log);
+        glDeleteShader(shader);
+        return 0;
+    }
+    return shader;
+}
+}  // namespace
+
+bool GlTraceRenderer::available()
+{
+    if (!tried_)
+    {
+        tried_ = true;
+        ready_ = create();
+        std::printf("[Chart] OpenGL trace renderer %s\n", ready_ ? "ready" : "unavailable, using ImPlot");
+    }
+    return ready_;
+}
+
+bool GlTraceRenderer::create()
+{
+    if (!GLAD_GL_VERSION_3_2)
+    {
+        return false;  // glad not loaded or context too old
+    }
+
+    const GLuint vertex = compile_shader(GL_VERTEX_SHADER, k_vertex_shader);
+    const GLuint fragment = compile_shader(GL_FRAGMENT_SHADER, k_fragment_shader);
+    if (!vertex || !fragment)
+    {
+        return false;
+    }
+
+    program_ = glCreateProgram();
+    glAttachShader(program_, vertex);
+    glAttachShader(program_, fragment);
+    glLinkProgram(program_);
+    glDeleteShader(vertex);
+    glDeleteShader(fragment);
+
+    GLint status = GL_FALSE;
+    glGetProgramiv(program_, GL_LINK_STATUS, &status);
+    if (status != GL_TRUE)
+    {
+        char log[1024] = {};
+        glGetProgramInfoLog(program_, sizeof(log), nullptr, log);
+        std::printf("[Chart] trace program failed to link: %s\n", log);
+        return false;
+    }
+
+    u_columns_ = glGetUniformLocation(program_, "u_columns");
+    u_colors_ = glGetUniformLocation(program_, "u_colors");
+    u_rows_ = glGetUniformLocation(program_, "u_rows");
+    u_x_map_ = glGetUniformLocation(program_, "u_x_map");
+    u_y_map_ = glGetUniformLocation(program_, "u_y_map");
+    u_row_map_ = glGetUniformLocation(program_, "u_row_map");
+
+    // Core profile needs a bound VAO even though every input comes from gl_VertexID / gl_InstanceID
+    glGenVertexArrays(1, &vertex_array_);
+
+    glGenBuffers(1, &column_buffer_);
+    glGenBuffers(1, &color_buffer_);
+    glGenTextures(1, &column_texture_);
+    glGenTextures(1, &color_texture_);
+    return true;
+}
+
+// ===== STAGING =====
+
+void GlTraceRenderer::begin_frame(int rows, int columns)
+{
+    rows = std::max(0, rows);
+    columns = std::max(0, columns);
+    if (rows == rows_ && columns == columns_)
+    {
+        return;
+    }
+
+    rows_ = rows;
+    columns_ = columns;
+    image_.assign(static_cast<size_t>(rows_) * columns_ * 2, k_no_value);
+    colors_.assign(static_cast<size_t>(rows_) * 4, 0.0f);
+    row_state_.assign(static_cast<size_t>(rows_), RowState{});
+    dirty_begin_ = 0;
+    dirty_end_ = columns_;
+    resized_ = true;
+}
+
+void GlTraceRenderer::stage_row(int row, int source, const SweepTrace& trace, float r, float g, float b, float a)
+{
+    float* color = colors_.data() + static_cast<size_t>(row) * 4;
+    color[0] = r;
+    color[1] = g;
+    color[2] = b;
+    color[3] = a;
+
+    RowState& state = row_state_[row];
+    const std::vector<EnvelopeColumn>& current = trace.current_columns();
+
+    if (!state.mirrored || state.source != source || state.generation != trace.generation())
+    {
+        // Rebuilt or scrolled: the previous cycle ahead of the cursor, overwritten by the current one behind it
+        write_blank(row, 0);
+        write_columns(row, trace.previous_columns(), 0);
+        write_columns(row, current, 0);
+        state.mirrored = true;
+        state.source = source;
+        state.generation = trace.generation();
+        state.cycle_start = trace.current_start();
+        state.uploaded = static_cast<int>(current.size());
+        return;
+    }
+
+    // The last staged column may have been partial; restage it along with the new ones
+    if (state.cycle_start != trace.current_start())
+    {
+        // Cursor wrapped: finish the cycle that is now the previous one
+        write_columns(row, trace.previous_columns(), std::max(0, state.uploaded - 1));
+        state.cycle_start = trace.current_start();
+        state.uploaded = 0;
+    }
+    write_columns(row, current, std::max(0, state.uploaded - 1));
+    state.uploaded = static_cast<int>(current.size());
+}
+
+void GlTraceRenderer::clear_row(int row)
+{
+    RowState& state = row_state_[row];
+    if (state.mirrored)
+    {
+        write_blank(row, 0);
+        state = RowState{};
+    }
+}
+
+void GlTraceRenderer::write_columns(int row, const std::vector<EnvelopeColumn>& columns, int from)
+{
+    const int end = std::min(static_cast<int>(columns.size()), columns_);
+    if (from >= end)
+    {
+        return;
+    }
+    for (int c = from; c < end; ++c)
+    {
+        float* slot = image_.data() + (static_cast<size_t>(c) * rows_ + row) * 2;
+        slot[0] = columns[c].first;
+        slot[1] = columns[c].second;
+    }
+    dirty_begin_ = std::min(dirty_begin_, from);
+    dirty_end_ = std::max(dirty_end_, end);
+}
+
+void GlTraceRenderer::write_blank(int row, int from)
+{
+    for (int c = from; c < columns_; ++c)
+    {
+        float* slot = image_.data() + (static_cast<size_t>(c) * rows_ + row) * 2;
+        slot[0] = k_no_value;
+        slot[1] = k_no_value;
+    }
+    dirty_begin_ = std::min(dirty_begin_, from);
+    dirty_end_ = std::max(dirty_end_, columns_);
+}
+
+// ===== UPLOAD AND DRAW =====
+
+void GlTraceRenderer::submit(ImDrawList* draw_list, const TraceLayout& layout)
+{
+    if (!ready_ || rows_ == 0 || columns_ == 0)
+    {
+        return;
+    }
+
+    const size_t column_floats = static_cast<size_t>(rows_) * 2;
+    glBindBuffer(GL_TEXTURE_BUFFER, column_buffer_);
+    if (resized_)
+    {
+        glBufferData(
+            GL_TEXTURE_BUFFER, static_cast<GLsizeiptr>(image_.size() * sizeof(float)), image_.data(), GL_STREAM_DRAW);
+        glBindTexture(GL_TEXTURE_BUFFER, column_texture_);
+        glTexBuffer(GL_TEXTURE_BUFFER, GL_RG32F, column_buffer_);
+        resized_ = false;
+    }
+    else if (dirty_end_ > dirty_begin_)
+    {
+        // Column-major: this frame's new columns of every row are one contiguous range
+        const size_t offset = static_cast<size_t>(dirty_begin_) * column_floats;
+        const size_t count = static_cast<size_t>(dirty_end_ - dirty_begin_) * column_floats;
+        glBufferSubData(GL_TEXTURE_BUFFER,
+                        static_cast<GLintptr>(offset * sizeof(float)),
+                        static_cast<GLsizeiptr>(count * sizeof(float)),
+                        image_.data() + offset);
+    }
+    dirty_begin_ = columns_;
+    dirty_end_ = 0;
+
+    glBindBuffer(GL_TEXTURE_BUFFER, color_buffer_);
+    glBufferData(
+        GL_TEXTURE_BUFFER, static_cast<GLsizeiptr>(colors_.size() * sizeof(float)), colors_.data(), GL_STREAM_DRAW);
+    glBindTexture(GL_TEXTURE_BUFFER, color_texture_);
+    glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, color_buffer_);
+    glBindTexture(GL_TEXTURE_BUFFER, 0);
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+
+    layout_ = layout;
+    draw_list->AddCallback(&GlTraceRenderer::draw_callback, this);
+    draw_list->AddCallback(ImDrawCallback_ResetRenderState, nullptr);
+}
+
+void GlTraceRenderer::draw_callback(const ImDrawList* /*parent_list*/, const ImDrawCmd* cmd)
+{
+    static_cast<const GlTraceRenderer*>(cmd->UserCallbackData)->draw();
+}
+
+void GlTraceRenderer::draw() const
+{
+    const ImDrawData* draw_data = ImGui::GetDrawData();
+    if (!draw_data)
+    {
+        return;
+    }
+
+    // Plot rectangle in framebuffer pixels (GL origin is bottom-left)
+    const ImVec2 origin = draw_data->DisplayPos;
+    const ImVec2 scale = draw_data->FramebufferScale;
+    const float framebuffer_h = draw_data->DisplaySize.y * scale.y;
+    const auto x = static_cast<GLint>((layout_.plot_x - origin.x) * scale.x);
+    const auto y = static_cast<GLint>(framebuffer_h - (layout_.plot_y + layout_.plot_h - origin.y) * scale.y);
+    const auto w = static_cast<GLsizei>(layout_.plot_w * scale.x);
+    const auto h = static_cast<GLsizei>(layout_.plot_h * scale.y);
+    if (w <= 0 || h <= 0)
+    {
+        return;
+    }
+    glViewport(x, y, w, h);
+    glEnable(GL_SCISSOR_TEST);
+    glScissor(x, y, w, h);
+
+    const double x_span = layout_.x_max - layout_.x_min;
+    const double x_scale = 2.0 * layout_.seconds_per_column / x_span;
+    const double x_offset = -1.0 - 2.0 * layout_.x_min / x_span;
+
+    glUseProgram(program_);
+    glBindVertexArray(vertex_array_);
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_BUFFER, column_texture_);
+    glActiveTexture(GL_TEXTURE2);
+    glBindTexture(GL_TEXTURE_BUFFER, color_texture_);
+    glUniform1i(u_columns_, 1);
+    glUniform1i(u_colors_, 2);
+    glUniform1i(u_rows_, rows_);
+    glUniform2f(u_x_map_, static_cast<float>(x_scale), static_cast<float>(x_offset));
+    glUniform2f(u_y_map_, static_cast<float>(2.0 / layout_.y_max), -1.0f);
+    glUniform3f(u_row_map_,
+                static_cast<float>(layout_.row_base),
+                static_cast<float>(layout_.row_height),
+                static_cast<float>(layout_.gain));
+
+    glDrawArraysInstanced(GL_LINE_STRIP, 0, 2 * columns_, rows_);
+
+    glBindTexture(GL_TEXTURE_BUFFER, 0);
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_BUFFER, 0);
+    glActiveTexture(GL_TEXTURE0);
+}
+
+}  // namespace elda::ui
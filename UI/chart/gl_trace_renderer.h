@@ -0,0 +1,139 @@
+#pragma once
+
+#include "sweep_trace.h"
+
+#include <cstdint>
+#include <vector>
+
+struct ImDrawList;
+struct ImDrawCmd;
+
+namespace elda::ui
+{
+
+/**
+ * Placement of the traces inside the plot rectangle for one frame
+ * Mirrors the axes draw_chart() sets up, so both backends put every point on the same pixel.
+ */
+struct TraceLayout
+{
+    float plot_x = 0.0f;  // Plot rectangle in ImGui screen coordinates
+    float plot_y = 0.0f;
+    float plot_w = 1.0f;
+    float plot_h = 1.0f;
+
+    double x_min = 0.0;  // X axis range (seconds since the cycle start)
+    double x_max = 1.0;
+    double y_max = 1.0;  // Y axis range is [0, y_max] (pixels, row 0 at the bottom)
+
+    double seconds_per_column = 1.0;
+    double row_base = 0.0;    // y of row 0's baseline
+    double row_height = 1.0;  // y step between rows
+    double gain = 1.0;        // px per µV
+};
+
+/**
+ * GlTraceRenderer - draws every trace of the sweep with one instanced draw call
+ *
+ * The GPU holds a "sweep image" of the SweepTrace columns: one (first, second)
+ * pair per row and pixel column, stored column-major in a buffer texture. Slot c
+ * holds the current cycle's column c behind the cursor and the previous cycle's
+ * column c ahead of it, which is exactly what the sweep shows. Each frame only
+ * the columns the cursor moved through are staged and uploaded, and because the
+ * storage is column-major they form one contiguous glBufferSubData range across
+ * all rows. A rebuilt trace re-stages its row.
+ *
+ * The vertex shader expands instance = row, vertex = 2 * column + extreme into
+ * a line strip and applies the row offset and gain. NaN columns (samples no
+ * longer retained, or no previous cycle yet) are dropped in the fragment stage.
+ * The wiper gap is painted by draw_chart() over both backends.
+ *
+ * Needs a GL 3.2 core context with glad loaded (main() does this); if anything
+ * is missing, available() returns false and draw_chart() keeps using ImPlot.
+ * All calls must come from the thread that owns the GL context.
+ */
+class GlTraceRenderer
+{
+  public:
+    GlTraceRenderer() = default;
+
+    GlTraceRenderer(const GlTraceRenderer&) = delete;
+    GlTraceRenderer& operator=(const GlTraceRenderer&) = delete;
+
+    /**
+     * Create the GL objects on first use
+     * @return false if the context or loader cannot provide them (logged once)
+     */
+    bool available();
+
+    /**
+     * Size the sweep image for a frame; a change of shape clears it
+     * @param rows Visible rows (instances)
+     * @param columns Pixel columns of one sweep cycle
+     */
+    void begin_frame(int rows, int columns);
+
+    /**
+     * Stage the columns of one row that changed since its previous frame
+     * @param row Instance slot on screen
+     * @param source Montage row the trace belongs to; a slot that shows another row is staged in full
+     */
+    void stage_row(int row, int source, const SweepTrace& trace, float r, float g, float b, float a);
+
+    /**
+     * Blank a row that has no channel this frame
+     */
+    void clear_row(int row);
+
+    /**
+     * Upload the staged columns and queue the draw on a draw list
+     * The draw runs when ImGui renders that list, in order with the plot's other items.
+     */
+    void submit(ImDrawList* draw_list, const TraceLayout& layout);
+
+  private:
+    struct RowState
+    {
+        int source = -1;          // Montage row last mirrored into this slot
+        uint64_t generation = 0;  // SweepTrace::generation() last mirrored
+        uint64_t cycle_start = 0;
+        int uploaded = 0;      // Columns of that cycle already staged
+        bool mirrored = false; // false = row must be staged in full
+    };
+
+    static void draw_callback(const ImDrawList* parent_list, const ImDrawCmd* cmd);
+
+    bool create();
+    void draw() const;
+    void write_columns(int row, const std::vector<EnvelopeColumn>& columns, int from);
+    void write_blank(int row, int from);
+
+    int rows_ = 0;
+    int columns_ = 0;
+    std::vector<RowState> row_state_;
+    std::vector<float> image_;   // [column][row][2], mirror of the GPU buffer
+    std::vector<float> colors_;  // [row][4]
+    int dirty_begin_ = 0;        // Staged column range not uploaded yet
+    int dirty_end_ = 0;
+    bool resized_ = true;  // GPU buffer must be re-allocated
+
+    TraceLayout layout_;
+
+    // GL objects (released with the context)
+    bool tried_ = false;
+    bool ready_ = false;
+    unsigned program_ = 0;
+    unsigned vertex_array_ = 0;
+    unsigned column_buffer_ = 0;
+    unsigned column_texture_ = 0;
+    unsigned color_buffer_ = 0;
+    unsigned color_texture_ = 0;
+    int u_columns_ = -1;
+    int u_colors_ = -1;
+    int u_rows_ = -1;
+    int u_x_map_ = -1;
+    int u_y_map_ = -1;
+    int u_row_map_ = -1;
+};
+
+}  // namespace elda::ui
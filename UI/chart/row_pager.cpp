@@ -0,0 +1,68 @@
+#include "row_pager.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace elda::ui
+{
+
+namespace
+{
+constexpr float k_top_pad_px = 8.0f;
+constexpr float k_preferred_row_px = 120.0f;
+constexpr float k_min_row_px = 24.0f;  // Below this rows stop shrinking and the montage scrolls
+constexpr int k_wheel_rows = 3;        // Rows scrolled per mouse wheel notch
+constexpr float k_scroll_bar_px = 4.0f;
+}  // namespace
+
+RowPage RowPager::layout(int rows, float height)
+{
+    RowPage page;
+    page.rows = rows;
+    page.row_height = std::min<double>(
+        k_preferred_row_px, std::max<double>(k_min_row_px, (height - k_top_pad_px) / std::max(1, rows)));
+    page.first_base = k_top_pad_px + 0.5 * page.row_height;
+
+    const int page_rows = std::max(1, static_cast<int>((height - k_top_pad_px) / page.row_height));
+    const int max_first_row = std::max(0, rows - page_rows);
+
+    // Row 0 sits at the bottom, so scrolling up (wheel or Page Up) brings in higher rows
+    if (max_first_row > 0 && ImGui::IsWindowHovered(ImGuiHoveredFlags_ChildWindows))
+    {
+        first_row_ += static_cast<int>(std::round(ImGui::GetIO().MouseWheel * k_wheel_rows));
+        if (ImGui::IsKeyPressed(ImGuiKey_PageUp))
+        {
+            first_row_ += page_rows;
+        }
+        if (ImGui::IsKeyPressed(ImGuiKey_PageDown))
+        {
+            first_row_ -= page_rows;
+        }
+    }
+    first_row_ = std::clamp(first_row_, 0, max_first_row);
+
+    page.first = first_row_;
+    page.count = std::min(rows - first_row_, page_rows);
+    return page;
+}
+
+void RowPager::draw_scroll_bar(ImDrawList* draw_list, ImVec2 plot_pos, ImVec2 plot_size, const RowPage& page)
+{
+    if (!page.scrolls())
+    {
+        return;
+    }
+
+    const float track_x = plot_pos.x + plot_size.x - k_scroll_bar_px;
+    const float track_bottom = plot_pos.y + plot_size.y;
+    const float thumb_bottom = track_bottom - plot_size.y * static_cast<float>(page.first) / page.rows;
+    const float thumb_top = thumb_bottom - plot_size.y * static_cast<float>(page.count) / page.rows;
+    draw_list->AddRectFilled(ImVec2(track_x, plot_pos.y),
+                             ImVec2(track_x + k_scroll_bar_px, track_bottom),
+                             ImGui::GetColorU32(ImGuiCol_ScrollbarBg));
+    draw_list->AddRectFilled(ImVec2(track_x, thumb_top),
+                             ImVec2(track_x + k_scroll_bar_px, thumb_bottom),
+                             ImGui::GetColorU32(ImGuiCol_ScrollbarGrab));
+}
+
+}  // namespace elda::ui
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "imgui.h"
+
+namespace elda::ui
+{
+
+/**
+ * Rows of the montage that are on screen this frame
+ * Row 0 sits at the bottom of the plot; slot s (0 = bottom) shows row first + s.
+ */
+struct RowPage
+{
+    int rows = 0;              // Rows in the montage
+    int first = 0;             // Lowest row on screen
+    int count = 0;             // Rows on screen
+    double row_height = 1.0;   // Pixels between baselines
+    double first_base = 0.0;   // Baseline of slot 0, in pixels from the plot bottom
+
+    double baseline(int slot) const
+    {
+        return first_base + slot * row_height;
+    }
+
+    bool scrolls() const
+    {
+        return count < rows;
+    }
+};
+
+/**
+ * RowPager - fits the montage rows to a height, scrolling once they would become unreadable
+ *
+ * Rows shrink to fit down to a readable minimum; beyond that the view shows a page
+ * of rows and the mouse wheel (a few rows per notch) or Page Up / Page Down (a page)
+ * move it while the calling window is hovered. Shared by the sweep and the
+ * spectrogram, so both keep the same rows in view.
+ */
+class RowPager
+{
+  public:
+    /**
+     * Lay out this frame's rows and apply scroll input
+     * @param rows Rows in the montage
+     * @param height Plot height in pixels
+     */
+    RowPage layout(int rows, float height);
+
+    /**
+     * Thin scroll position bar along the right edge of a plot (nothing when every row fits)
+     */
+    static void draw_scroll_bar(ImDrawList* draw_list, ImVec2 plot_pos, ImVec2 plot_size, const RowPage& page);
+
+  private:
+    int first_row_ = 0;
+};
+
+}  // namespace elda::ui
@@ -0,0 +1,165 @@
+// spectrogram_chart.cpp — Per-row scrolling spectrogram of the montage rows (ChartView::Spectrogram)
+#include "channel_render_cache.h"
+#include "chart.h"
+#include "core/dsp/spectrogram.h"
+#include "imgui.h"
+#include "implot.h"
+#include "row_pager.h"
+#include "spectrogram_renderer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+static constexpr float k_left_label_inset_px = 20.0f;
+static constexpr float k_left_spacing_px = 56.0f;
+static constexpr float k_row_gap_px = 1.0f;
+static constexpr double k_max_hz = 100.0;           // Top of every row
+static constexpr int k_min_history = 16;            // Columns, even for short windows
+static constexpr int64_t k_frame_budget = 1 << 18;  // Samples transformed per UI frame (backlog is spread out)
+static constexpr float k_dynamic_range_db = 60.0f;  // Floor below the amplitude-derived ceiling
+
+static const ImVec4 k_label_color_normal = ImVec4(0.72f, 0.76f, 0.80f, 1.0f);
+
+void draw_spectrogram(const elda::ChartData& data)
+{
+    // Spectra of the montage rows; frames are transformed as the ring grows
+    static elda::dsp::StreamingSpectrogram spectrogram;
+    static elda::ui::SpectrogramRenderer renderer;
+
+    if (!data.ring.source || !data.channels)
+    {
+        return;
+    }
+    const elda::SampleRing& ring = *data.ring.source;
+
+    ImGui::BeginChild("##spectrogramchild", ImVec2(0, 0), false, ImGuiWindowFlags_NoScrollbar);
+    if (!renderer.available())
+    {
+        ImGui::TextDisabled("Spectrogram needs an OpenGL 3.2 context");
+        ImGui::EndChild();
+        return;
+    }
+
+    // Same rows as the sweep; the time span follows the sweep window
+    const std::vector<elda::ui::ChannelRenderDescriptor>& descriptors = data.channels->rows();
+    const int rows = static_cast<int>(descriptors.size());
+    const elda::dsp::Montage* montage = data.montage;
+    std::vector<int> channels(static_cast<size_t>(rows));
+    for (int row = 0; row < rows; ++row)
+    {
+        const int channel = descriptors[row].channel;
+        const int limit = montage ? montage->rows() : ring.channels();  // ring is re-shaped when monitoring starts
+        channels[row] = channel < limit ? channel : -1;
+    }
+
+    const double rate = ring.sample_rate_hz();
+    elda::dsp::SpectrogramShape shape = elda::dsp::SpectrogramShape::for_rate(rate, k_max_hz, k_min_history);
+    shape.history = std::max(k_min_history, static_cast<int>(std::ceil(data.window_seconds * rate / shape.hop)));
+    const bool same_montage = montage == spectrogram.montage() &&
+                              (!montage || montage->generation() == spectrogram.montage_generation());
+    if (channels != spectrogram.channels() || rate != spectrogram.sample_rate_hz() || shape != spectrogram.shape() ||
+        !same_montage)
+    {
+        spectrogram.configure(channels, rate, shape, montage);
+        std::printf("[Chart] spectrogram: %d rows, %d-point FFT, hop %d, %d bins, %d columns\n",
+                    rows,
+                    shape.fft_size,
+                    shape.hop,
+                    shape.bins,
+                    shape.history);
+    }
+
+    spectrogram.advance(ring, data.ring.published, k_frame_budget, chart_worker_pool(), data.average);
+
+    // Colour range follows the amplitude setting: a sine of the full peak-to-peak range in one bin tops the scale
+    const double half_pp = 0.5 * data.amplitude_pp_uv;
+    const auto ceiling_db = static_cast<float>(10.0 * std::log10(std::max(1e-6, 0.5 * half_pp * half_pp)));
+    const float floor_db = ceiling_db - k_dynamic_range_db;
+
+    // Time axis: seconds before the newest column
+    const float avail_width = ImGui::GetContentRegionAvail().x;
+    const float avail_height = ImGui::GetContentRegionAvail().y;
+    const double span_sec = static_cast<double>(shape.history) * shape.hop / rate;
+    const double left_padding_time = (k_left_spacing_px / std::max(1.0f, avail_width)) * span_sec;
+    const double x_min = -span_sec - left_padding_time;
+    const double x_max = 0.0;
+
+    const elda::ui::RowPage page = chart_row_pager().layout(rows, avail_height);
+    renderer.sync(spectrogram, floor_db, ceiling_db, page);
+
+    // Style
+    ImPlot::PushStyleVar(ImPlotStyleVar_PlotPadding, ImVec2(0, 0));
+    ImPlot::PushStyleVar(ImPlotStyleVar_LabelPadding, ImVec2(2, 2));
+    ImPlot::PushStyleVar(ImPlotStyleVar_MajorGridSize, ImVec2(0, 0));
+    ImPlot::PushStyleVar(ImPlotStyleVar_MinorGridSize, ImVec2(0, 0));
+    ImPlot::PushStyleVar(ImPlotStyleVar_PlotBorderSize, 0.0f);
+
+    ImPlotFlags plot_flags = ImPlotFlags_NoLegend | ImPlotFlags_NoMenus | ImPlotFlags_NoBoxSelect |
+                             ImPlotFlags_NoTitle | ImPlotFlags_NoMouseText;
+
+    ImPlotAxisFlags axis_flags = ImPlotAxisFlags_NoLabel | ImPlotAxisFlags_NoTickLabels | ImPlotAxisFlags_NoTickMarks |
+                                 ImPlotAxisFlags_Lock | ImPlotAxisFlags_NoHighlight;
+
+    if (ImPlot::BeginPlot("##spectrogram", ImVec2(-1, -1), plot_flags))
+    {
+        ImPlot::SetupAxisLimits(ImAxis_X1, x_min, x_max, ImGuiCond_Always);
+        ImPlot::SetupAxisLimits(ImAxis_Y1, 0.0, static_cast<double>(std::max(1.0f, avail_height)), ImGuiCond_Always);
+        ImPlot::SetupAxis(ImAxis_X1, nullptr, axis_flags);
+        ImPlot::SetupAxis(ImAxis_Y1, nullptr, axis_flags);
+        ImPlot::SetupFinish();
+
+        // One textured quad per visible row: DC at the bottom, k_max_hz at the top
+        const double half_row = 0.5 * page.row_height - k_row_gap_px;
+        for (int slot = 0; slot < page.count; ++slot)
+        {
+            const int row = page.first + slot;
+            const elda::ui::SpectrogramImage image = renderer.image(row);
+            const double y_base = page.baseline(slot);
+            ImPlot::PlotImage(descriptors[row].trace_id.c_str(),
+                              image.texture,
+                              ImPlotPoint(-span_sec, y_base - half_row),
+                              ImPlotPoint(0.0, y_base + half_row),
+                              image.uv0,
+                              image.uv1);
+        }
+
+        // Left labels
+        ImPlot::PushStyleColor(ImPlotCol_InlayText, k_label_color_normal);
+        for (int slot = 0; slot < page.count; ++slot)
+        {
+            ImPlot::PlotText(descriptors[page.first + slot].label.c_str(),
+                             x_min,
+                             page.baseline(slot),
+                             ImVec2(+k_left_label_inset_px, 0.0f),
+                             ImPlotTextFlags_None);
+        }
+        ImPlot::PopStyleColor();
+
+        ImDrawList* draw_list = ImPlot::GetPlotDrawList();
+        const ImVec2 plot_pos = ImPlot::GetPlotPos();
+        const ImVec2 plot_size = ImPlot::GetPlotSize();
+
+        // Scale legend, top right
+        char legend[96];
+        std::snprintf(legend,
+                      sizeof(legend),
+                      "0-%.0f Hz  %.1f s  %.0f..%.0f dB uV^2/Hz",
+                      (shape.bins - 1) * spectrogram.bin_hz(),
+                      span_sec,
+                      floor_db,
+                      ceiling_db);
+        const ImVec2 legend_size = ImGui::CalcTextSize(legend);
+        draw_list->AddText(ImVec2(plot_pos.x + plot_size.x - legend_size.x - 12.0f, plot_pos.y + 2.0f),
+                           ImGui::GetColorU32(k_label_color_normal),
+                           legend);
+
+        elda::ui::RowPager::draw_scroll_bar(draw_list, plot_pos, plot_size, page);
+
+        ImPlot::EndPlot();
+    }
+
+    ImPlot::PopStyleVar(5);
+    ImGui::EndChild();
+}
@@ -0,0 +1,159 @@
+#include "spectrogram_renderer.h"
+
+#include "UI/colormap/colormap.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <glad/glad.h>
+
+namespace elda::ui
+{
+
+bool SpectrogramRenderer::available()
+{
+    if (!tried_)
+    {
+        tried_ = true;
+        ready_ = GLAD_GL_VERSION_3_2 != 0;  // glad not loaded or context too old
+        std::printf("[Chart] spectrogram textures %s\n", ready_ ? "ready" : "unavailable");
+    }
+    return ready_;
+}
+
+void SpectrogramRenderer::reshape(int rows, int bins, int history)
+{
+    if (!textures_.empty())
+    {
+        glDeleteTextures(static_cast<GLsizei>(textures_.size()), textures_.data());
+    }
+    rows_ = rows;
+    bins_ = bins;
+    history_ = history;
+    textures_.assign(static_cast<size_t>(rows), 0u);
+    uploaded_.assign(static_cast<size_t>(rows), k_stale);
+    if (rows == 0)
+    {
+        return;
+    }
+
+    glGenTextures(rows, textures_.data());
+    for (unsigned texture : textures_)
+    {
+        glBindTexture(GL_TEXTURE_2D, texture);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);  // Scroll by offsetting u
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, history, bins, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    }
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+void SpectrogramRenderer::sync(const dsp::StreamingSpectrogram& spectrogram,
+                               float floor_db,
+                               float ceiling_db,
+                               const RowPage& page)
+{
+    if (!available())
+    {
+        return;
+    }
+
+    const dsp::SpectrogramShape& shape = spectrogram.shape();
+    bool full = false;
+    if (spectrogram.rows() != rows_ || shape.bins != bins_ || shape.history != history_)
+    {
+        reshape(spectrogram.rows(), shape.bins, shape.history);
+        full = true;
+    }
+    if (floor_db != floor_db_ || ceiling_db != ceiling_db_)
+    {
+        floor_db_ = floor_db;
+        ceiling_db_ = ceiling_db;
+        full = true;
+    }
+    if (spectrogram.generation() != generation_)
+    {
+        generation_ = spectrogram.generation();
+        full = true;
+    }
+
+    if (full)
+    {
+        std::fill(uploaded_.begin(), uploaded_.end(), k_stale);
+    }
+
+    next_frame_ = spectrogram.next_frame();
+    const auto history = static_cast<uint64_t>(history_);
+    const uint64_t first_kept = next_frame_ > history ? next_frame_ - history : 0;
+    const int last = std::min(rows_, page.first + page.count);
+    for (int row = std::max(0, page.first); row < last; ++row)
+    {
+        uint64_t& uploaded = uploaded_[row];
+        if (uploaded == k_stale || next_frame_ - std::max(uploaded, first_kept) >= history)
+        {
+            // Every slot, in slot order: slots never written by this generation hold the engine's floor
+            const uint64_t base = next_frame_ - next_frame_ % history;
+            upload(spectrogram, row, base, base + history);
+        }
+        else if (uploaded < next_frame_)
+        {
+            upload(spectrogram, row, std::max(uploaded, first_kept), next_frame_);
+        }
+        uploaded = next_frame_;
+    }
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+void SpectrogramRenderer::upload(const dsp::StreamingSpectrogram& spectrogram, int row, uint64_t first, uint64_t end)
+{
+    if (first >= end)
+    {
+        return;
+    }
+
+    const uint32_t* colormap = viridis_colormap();
+    const auto history = static_cast<uint64_t>(history_);
+    const size_t row_offset = static_cast<size_t>(row) * bins_;
+    glBindTexture(GL_TEXTURE_2D, textures_[row]);
+    while (first < end)
+    {
+        // Contiguous texel columns up to the end of the slot ring
+        const int slot = static_cast<int>(first % history);
+        const int run = static_cast<int>(std::min<uint64_t>(end - first, history - static_cast<uint64_t>(slot)));
+        staging_.resize(static_cast<size_t>(run) * bins_);
+
+        for (int i = 0; i < run; ++i)
+        {
+            const float* values = spectrogram.column(first + static_cast<uint64_t>(i)) + row_offset;
+            for (int bin = 0; bin < bins_; ++bin)
+            {
+                staging_[static_cast<size_t>(bin) * run + i] =
+                    colormap[colormap_index(values[bin], floor_db_, ceiling_db_)];
+            }
+        }
+        glTexSubImage2D(GL_TEXTURE_2D, 0, slot, 0, run, bins_, GL_RGBA, GL_UNSIGNED_BYTE, staging_.data());
+        first += static_cast<uint64_t>(run);
+    }
+}
+
+SpectrogramImage SpectrogramRenderer::image(int row) const
+{
+    SpectrogramImage image;
+    if (row < 0 || row >= rows_ || history_ == 0)
+    {
+        return image;
+    }
+
+    // Slot next % history holds the oldest retained frame; wrapping carries u past 1 to the newest.
+    // Texel row 0 is DC and the quad's top-left takes uv0, so v runs from 1 (top bin) down to 0.
+    const float u0 = static_cast<float>(next_frame_ % static_cast<uint64_t>(history_)) / history_;
+    image.texture = (ImTextureID)(intptr_t)textures_[row];
+    image.uv0 = ImVec2(u0, 1.0f);
+    image.uv1 = ImVec2(u0 + 1.0f, 0.0f);
+    return image;
+}
+
+}  // namespace elda::ui
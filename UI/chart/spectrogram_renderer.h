@@ -0,0 +1,93 @@
+#pragma once
+
+#include "UI/chart/row_pager.h"
+#include "core/dsp/spectrogram.h"
+#include "imgui.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace elda::ui
+{
+
+/**
+ * Texture and coordinates that show one row's history, oldest column on the left and DC at the bottom
+ * ImPlot::PlotImage puts uv0 at the top-left corner of the quad and uv1 at the bottom-right.
+ */
+struct SpectrogramImage
+{
+    ImTextureID texture = ImTextureID();
+    ImVec2 uv0;  // Oldest column, top bin
+    ImVec2 uv1;  // Newest column, DC
+};
+
+/**
+ * SpectrogramRenderer - mirrors a StreamingSpectrogram's columns into one scrolling texture per row
+ *
+ * Each row texture is history() texels wide and bins() tall; frame f lives in
+ * texel column f % history(), exactly like the engine's column ring. New frames
+ * are therefore written in place with one glTexSubImage2D per row and
+ * contiguous slot run, and scrolling costs nothing: the image is drawn with the
+ * u range starting at the oldest slot and S wrapping (GL_REPEAT).
+ *
+ * Only the rows on the current RowPage are recoloured and uploaded; a row
+ * keeps its own upload mark, so one that scrolls into view catches up with
+ * the columns it missed (or all of them, if it fell a whole history behind).
+ *
+ * dB values are mapped through the viridis colour table between a floor
+ * and a ceiling; changing that range, or a new engine generation, re-uploads
+ * every column of each row once it is on the page.
+ *
+ * Needs glad and a GL 3.2 context like GlTraceRenderer; all calls must come
+ * from the thread that owns the context. GL objects are released with the context.
+ */
+class SpectrogramRenderer
+{
+  public:
+    SpectrogramRenderer() = default;
+
+    SpectrogramRenderer(const SpectrogramRenderer&) = delete;
+    SpectrogramRenderer& operator=(const SpectrogramRenderer&) = delete;
+
+    /**
+     * @return false if the context or loader cannot provide textures (logged once)
+     */
+    bool available();
+
+    /**
+     * Upload the columns each row on the page is missing
+     * @param floor_db,ceiling_db dB mapped to the first and last colour
+     * @param page Rows drawn this frame
+     */
+    void sync(const dsp::StreamingSpectrogram& spectrogram, float floor_db, float ceiling_db, const RowPage& page);
+
+    /**
+     * Image of one row as of the last sync()
+     */
+    SpectrogramImage image(int row) const;
+
+  private:
+    void reshape(int rows, int bins, int history);
+    void upload(const dsp::StreamingSpectrogram& spectrogram, int row, uint64_t first, uint64_t end);
+
+    // Row upload mark of a row whose texture no longer matches the engine (shape, colour range or generation)
+    static constexpr uint64_t k_stale = ~uint64_t{0};
+
+    int rows_ = 0;
+    int bins_ = 0;
+    int history_ = 0;
+    std::vector<unsigned> textures_;
+    std::vector<uint64_t> uploaded_;  // Per row: frames below this are on the GPU (k_stale = none valid)
+    std::vector<uint32_t> staging_;   // [bin][column] RGBA8 of one row's run
+
+    float floor_db_ = 0.0f;
+    float ceiling_db_ = 0.0f;
+
+    uint64_t generation_ = 0;  // Engine generation mirrored (0 = none yet)
+    uint64_t next_frame_ = 0;  // Engine next_frame() at the last sync
+
+    bool tried_ = false;
+    bool ready_ = false;
+};
+
+}  // namespace elda::ui
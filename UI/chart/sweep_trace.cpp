@@ -0,0 +1,157 @@
+#include "sweep_trace.h"
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+namespace elda::ui
+{
+
+namespace
+{
+constexpr float k_no_value = std::numeric_limits<float>::quiet_NaN();
+constexpr float k_empty_lo = std::numeric_limits<float>::infinity();
+constexpr float k_empty_hi = -std::numeric_limits<float>::infinity();
+}  // namespace
+
+void SweepTrace::update(const ColumnReducer& reducer,
+                        int channel,
+                        uint64_t published,
+                        uint64_t oldest,
+                        uint64_t window_samples,
+                        double samples_per_column)
+{
+    window_samples = std::max<uint64_t>(1, window_samples);
+    const uint64_t cycle_index = published / window_samples;
+    const uint64_t snap = reducer.grid(0, samples_per_column).snap;
+
+    const bool same_geometry = valid_ && channel == channel_ && window_samples == window_samples_ &&
+                               samples_per_column == samples_per_column_ && snap == snap_ &&
+                               reducer.source() == source_;
+    const bool continues = same_geometry && published >= last_published_ && cycle_index <= cycle_index_ + 1;
+
+    if (!continues)
+    {
+        channel_ = channel;
+        window_samples_ = window_samples;
+        samples_per_column_ = samples_per_column;
+        snap_ = snap;
+        source_ = reducer.source();
+        rebuild(reducer, published, oldest);
+    }
+    else if (cycle_index == cycle_index_ + 1)
+    {
+        // The cursor wrapped: finish the cycle that just ended, it becomes the previous one
+        extend(reducer, current_, current_.start + window_samples_, oldest);
+        std::swap(previous_, current_);
+        current_.start = cycle_index * window_samples_;
+        current_.grid = reducer.grid(current_.start, samples_per_column_);
+        current_.columns.clear();
+        current_.complete = 0;
+        cycle_index_ = cycle_index;
+    }
+
+    extend(reducer, current_, published, oldest);
+    last_published_ = published;
+
+    // Behind the cursor: this cycle up to published. Ahead of it: the previous cycle from the cursor on.
+    current_segment_ = segment(reducer, current_, std::max(oldest, current_.start), published);
+    previous_segment_ = EnvelopeSegment{};
+    if (current_.start >= window_samples_)
+    {
+        const uint64_t cursor_offset = published - current_.start;
+        previous_segment_ =
+            segment(reducer, previous_, std::max(oldest, previous_.start + cursor_offset), current_.start);
+    }
+}
+
+void SweepTrace::rebuild(const ColumnReducer& reducer, uint64_t published, uint64_t oldest)
+{
+    cycle_index_ = published / window_samples_;
+
+    current_.start = cycle_index_ * window_samples_;
+    current_.grid = reducer.grid(current_.start, samples_per_column_);
+    current_.columns.clear();
+    current_.complete = 0;
+
+    previous_.columns.clear();
+    previous_.complete = 0;
+    if (current_.start >= window_samples_)
+    {
+        previous_.start = current_.start - window_samples_;
+        previous_.grid = reducer.grid(previous_.start, samples_per_column_);
+        extend(reducer, previous_, current_.start, oldest);
+    }
+
+    ++generation_;
+    valid_ = true;
+}
+
+void SweepTrace::extend(const ColumnReducer& reducer, Cycle& cycle, uint64_t end, uint64_t oldest) const
+{
+    const uint64_t cycle_end = cycle.start + window_samples_;
+    end = std::min(end, cycle_end);
+
+    // Drop the partial tail column, then reduce from the first column that is not complete yet
+    cycle.columns.resize(static_cast<size_t>(cycle.complete));
+    float previous = cycle.columns.empty() ? k_no_value : cycle.columns.back().second;
+
+    for (int64_t c = cycle.complete;; ++c)
+    {
+        const uint64_t column_begin = std::max(cycle.grid.column_begin(c), cycle.start);
+        if (column_begin >= end)
+        {
+            break;
+        }
+        const uint64_t column_end = std::min(cycle.grid.column_begin(c + 1), cycle_end);
+        const uint64_t first = std::max(column_begin, oldest);
+        const uint64_t last = std::min(column_end, end);
+
+        EnvelopeColumn column{k_no_value, k_no_value};  // overwritten before it is ever visible
+        if (first < last)
+        {
+            float lo = k_empty_lo;
+            float hi = k_empty_hi;
+            reducer.reduce(channel_, first, last, lo, hi);
+            column = order_extremes(lo, hi, previous);
+            previous = column.second;
+        }
+        cycle.columns.push_back(column);
+
+        if (column_end <= end)
+        {
+            cycle.complete = static_cast<int>(c + 1);
+        }
+    }
+}
+
+EnvelopeSegment
+SweepTrace::segment(const ColumnReducer& reducer, const Cycle& cycle, uint64_t begin, uint64_t end) const
+{
+    EnvelopeSegment segment;
+    segment.grid = cycle.grid;
+    segment.columns = cycle.columns.data();
+    if (begin >= end || cycle.columns.empty())
+    {
+        return segment;
+    }
+
+    segment.first = static_cast<int>(cycle.grid.column_of(begin));
+    const auto cached = static_cast<int>(cycle.columns.size());
+    segment.end = std::min(static_cast<int>(cycle.grid.column_of(end - 1)) + 1, cached);
+    if (segment.first >= segment.end)
+    {
+        segment.first = segment.end = 0;
+        return segment;
+    }
+
+    // The segment may start mid-column (cursor, retention edge): reduce just the visible part, ordered to
+    // end on the same extreme as the cached column so the next column's stroke still joins up
+    float lo = k_empty_lo;
+    float hi = k_empty_hi;
+    reducer.reduce(channel_, begin, std::min(end, cycle.grid.column_begin(segment.first + 1)), lo, hi);
+    segment.head = order_extremes(lo, hi, cycle.columns[segment.first].first);
+    return segment;
+}
+
+}  // namespace elda::ui
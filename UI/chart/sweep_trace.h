@@ -0,0 +1,127 @@
+#pragma once
+
+#include "trace_decimator.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace elda::ui
+{
+
+/**
+ * Visible run of cached columns for one sweep segment
+ * Column `first` is a partial column and is drawn from head instead of columns[first].
+ */
+struct EnvelopeSegment
+{
+    const EnvelopeColumn* columns = nullptr;  // Indexed by grid column
+    int first = 0;                            // First visible column
+    int end = 0;                              // One past the last visible column
+    EnvelopeColumn head;                      // Extremes of the visible part of column `first`
+    ColumnGrid grid;
+
+    int points() const
+    {
+        return 2 * (end - first);
+    }
+};
+
+/**
+ * SweepTrace - persistent min/max envelope of one channel for the sweep display
+ *
+ * Keeps one EnvelopeColumn per pixel column for the current and the previous
+ * sweep cycle. Between frames only the columns the cursor moved through are
+ * reduced (plus the partial column at the start of the previous-cycle
+ * segment); a cycle wrap swaps the two buffers. A change of geometry
+ * (channel, window, plot width, pyramid level, montage) or a rewound ring rebuilds
+ * both cycles, which with a pyramid is O(columns).
+ *
+ * Values stay in µV: row placement and gain are applied when the vertices are
+ * generated, so re-layouts and gain changes never invalidate the cache.
+ * Traces are independent; different channels may be updated concurrently.
+ */
+class SweepTrace
+{
+  public:
+    /**
+     * Bring the cache up to one frame
+     * @param reducer Frame-wide reducer (ring + pyramid snapshot)
+     * @param channel Ring channel (montage row when the reducer has a montage)
+     * @param published Ring snapshot of this frame (samples below it are readable)
+     * @param oldest Oldest sample still retained in the snapshot
+     * @param window_samples Sweep length in samples
+     * @param samples_per_column Samples per pixel column (>= 1)
+     */
+    void update(const ColumnReducer& reducer,
+                int channel,
+                uint64_t published,
+                uint64_t oldest,
+                uint64_t window_samples,
+                double samples_per_column);
+
+    // Segment behind the cursor (this cycle)
+    const EnvelopeSegment& current() const
+    {
+        return current_segment_;
+    }
+
+    // Segment ahead of the cursor (previous cycle); points() == 0 when there is none
+    const EnvelopeSegment& previous() const
+    {
+        return previous_segment_;
+    }
+
+    // Cached columns of each cycle, indexed by grid column (NaN = no retained samples)
+    const std::vector<EnvelopeColumn>& current_columns() const
+    {
+        return current_.columns;
+    }
+
+    const std::vector<EnvelopeColumn>& previous_columns() const
+    {
+        return previous_.columns;
+    }
+
+    // First sample index of the current cycle
+    uint64_t current_start() const
+    {
+        return current_.start;
+    }
+
+    // Bumped on every rebuild: consumers mirroring the columns must re-read both cycles
+    uint64_t generation() const
+    {
+        return generation_;
+    }
+
+  private:
+    struct Cycle
+    {
+        ColumnGrid grid;
+        uint64_t start = 0;
+        std::vector<EnvelopeColumn> columns;
+        int complete = 0;  // Leading columns whose samples are all in (never recomputed)
+    };
+
+    void rebuild(const ColumnReducer& reducer, uint64_t published, uint64_t oldest);
+    void extend(const ColumnReducer& reducer, Cycle& cycle, uint64_t end, uint64_t oldest) const;
+    EnvelopeSegment segment(const ColumnReducer& reducer, const Cycle& cycle, uint64_t begin, uint64_t end) const;
+
+    // Geometry the cache was built for
+    int channel_ = -1;
+    uint64_t window_samples_ = 0;
+    double samples_per_column_ = 0.0;
+    uint64_t snap_ = 0;
+    uint64_t source_ = 0;  // ColumnReducer::source()
+    uint64_t cycle_index_ = 0;
+    uint64_t last_published_ = 0;
+    uint64_t generation_ = 0;
+    bool valid_ = false;
+
+    Cycle current_;
+    Cycle previous_;
+    EnvelopeSegment current_segment_;
+    EnvelopeSegment previous_segment_;
+};
+
+}  // namespace elda::ui
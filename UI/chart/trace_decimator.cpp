@@ -0,0 +1,67 @@
+#include "trace_decimator.h"
+
+#include "core/simd.h"
+
+#include <algorithm>
+
+namespace elda::ui
+{
+
+namespace
+{
+constexpr int k_montage_block = 256;  // Montage samples evaluated per fold (stack buffer)
+}  // namespace
+
+ColumnReducer::ColumnReducer(const SampleRing& ring,
+                             const MinMaxPyramid* pyramid,
+                             const dsp::Montage* montage,
+                             const SampleRing* average)
+    : ring_(ring),
+      pyramid_(montage ? nullptr : pyramid),
+      montage_(montage),
+      average_(average),
+      snapshot_(pyramid_ ? pyramid_->snapshot() : MinMaxPyramid::Snapshot{})
+{
+}
+
+ColumnGrid ColumnReducer::grid(uint64_t origin, double samples_per_column) const
+{
+    ColumnGrid grid;
+    grid.origin = origin;
+    grid.samples_per_column = samples_per_column;
+    grid.sample_rate_hz = ring_.sample_rate_hz();
+    grid.snap = pyramid_ ? MinMaxPyramid::bin_samples(pyramid_->level_for_span(samples_per_column)) : 1;
+    return grid;
+}
+
+void ColumnReducer::reduce(int channel, uint64_t first, uint64_t last, float& lo, float& hi) const
+{
+    if (pyramid_)
+    {
+        pyramid_->query(snapshot_, ring_, channel, first, last, lo, hi);
+        return;
+    }
+    if (montage_)
+    {
+        alignas(16) float block[k_montage_block];
+        while (first < last)
+        {
+            const int count = static_cast<int>(std::min<uint64_t>(k_montage_block, last - first));
+            montage_->evaluate(ring_, average_, channel, first, count, block);
+            simd::fold_minmax(block, count, lo, hi);
+            first += static_cast<uint64_t>(count);
+        }
+        return;
+    }
+
+    while (first < last)
+    {
+        int length = 0;
+        const float* src = ring_.run(channel, ring_.slot_of(first), length);
+        const int count = static_cast<int>(std::min<uint64_t>(static_cast<uint64_t>(length), last - first));
+        simd::fold_minmax(src, count, lo, hi);
+        first += static_cast<uint64_t>(count);
+    }
+}
+
+}  // namespace elda::ui
@@ -0,0 +1,125 @@
+#pragma once
+
+#include "core/dsp/montage.h"
+#include "core/minmax_pyramid.h"
+#include "core/sample_ring.h"
+
+#include <cmath>
+#include <cstdint>
+
+namespace elda::ui
+{
+
+/**
+ * ColumnGrid - maps sample indices of one sweep cycle to horizontal pixel columns
+ *
+ * Columns are anchored at origin (the sweep cycle start), so the samples that
+ * fall into a column never change as new data arrives and the envelope does
+ * not shimmer from frame to frame. Column edges snap down to multiples of
+ * snap (a pyramid bin width), so a column folds whole pre-built bins.
+ */
+struct ColumnGrid
+{
+    uint64_t origin = 0;              // Sample index at x = 0
+    double samples_per_column = 1.0;  // Samples per horizontal pixel (>= 4 * snap when snapping)
+    double sample_rate_hz = 1.0;
+    uint64_t snap = 1;  // Edge alignment in samples (1 = exact edges)
+
+    // First sample index of a column
+    uint64_t column_begin(int64_t column) const
+    {
+        const auto offset = static_cast<uint64_t>(std::ceil(static_cast<double>(column) * samples_per_column));
+        return (origin + offset) / snap * snap;
+    }
+
+    // Column containing a sample index (index >= column_begin(0))
+    int64_t column_of(uint64_t index) const
+    {
+        const auto column = static_cast<int64_t>(std::floor(static_cast<double>(index - origin) / samples_per_column));
+        return column_begin(column + 1) <= index ? column + 1 : column;
+    }
+
+    // Plot x (seconds since origin) of a column's left edge
+    double column_x(int64_t column) const
+    {
+        return static_cast<double>(column) * samples_per_column / sample_rate_hz;
+    }
+};
+
+/**
+ * Extremes of one pixel column in µV, in drawing order
+ */
+struct EnvelopeColumn
+{
+    float first = 0.0f;
+    float second = 0.0f;
+};
+
+/**
+ * Order a column's min and max so the line continues from the extreme nearest
+ * to the previous column's last point (previous = NaN: min first). A
+ * single-sample spike then always reaches full height without a stray stroke.
+ */
+inline EnvelopeColumn order_extremes(float lo, float hi, float previous)
+{
+    if (std::abs(previous - hi) < std::abs(previous - lo))
+    {
+        return {hi, lo};
+    }
+    return {lo, hi};
+}
+
+/**
+ * ColumnReducer - min/max of one channel over a sample range for one frame
+ *
+ * Holds the pyramid snapshot every trace of the frame shares. Without a pyramid
+ * the range is scanned from raw ring samples. With a montage, "channel" is a
+ * montage row: its samples are evaluated from the ring in short blocks and
+ * folded as they come (the pyramid only summarises ring channels).
+ */
+class ColumnReducer
+{
+  public:
+    /**
+     * @param ring Source ring
+     * @param pyramid Summaries of ring (nullptr = scan raw samples)
+     * @param montage Rows to reduce instead of ring channels (nullptr = referential)
+     * @param average Common average ring read by the montage
+     */
+    ColumnReducer(const SampleRing& ring,
+                  const MinMaxPyramid* pyramid,
+                  const dsp::Montage* montage = nullptr,
+                  const SampleRing* average = nullptr);
+
+    /**
+     * Grid for one cycle; edges snap to the pyramid level that fits a column
+     * (moves an edge by under a quarter column)
+     */
+    ColumnGrid grid(uint64_t origin, double samples_per_column) const;
+
+    /**
+     * Fold samples [first, last) of a channel (montage row) into lo / hi
+     * [first, last) must be published and retained in the frame's ring snapshot.
+     */
+    void reduce(int channel, uint64_t first, uint64_t last, float& lo, float& hi) const;
+
+    const SampleRing& ring() const
+    {
+        return ring_;
+    }
+
+    // What a channel index reads: 0 = ring channels, else the montage generation
+    uint64_t source() const
+    {
+        return montage_ ? montage_->generation() : 0;
+    }
+
+  private:
+    const SampleRing& ring_;
+    const MinMaxPyramid* pyramid_;
+    const dsp::Montage* montage_;
+    const SampleRing* average_;
+    MinMaxPyramid::Snapshot snapshot_;
+};
+
+}  // namespace elda::ui
@@ -0,0 +1,54 @@
+#include "colormap.h"
+
+#include "imgui.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace elda::ui
+{
+
+namespace
+{
+// Viridis, sampled every 1/8
+constexpr unsigned char k_viridis[9][3] = {
+    {68, 1, 84},
+    {71, 44, 122},
+    {59, 81, 139},
+    {44, 113, 142},
+    {33, 144, 141},
+    {39, 173, 129},
+    {92, 200, 99},
+    {170, 220, 50},
+    {253, 231, 37},
+};
+
+struct Table
+{
+    uint32_t entries[k_colormap_size];
+
+    Table()
+    {
+        for (int i = 0; i < k_colormap_size; ++i)
+        {
+            const float t = static_cast<float>(i) / (k_colormap_size - 1) * 8.0f;
+            const int stop = std::min(7, static_cast<int>(t));
+            const float f = t - stop;
+            const unsigned char* a = k_viridis[stop];
+            const unsigned char* b = k_viridis[stop + 1];
+            const auto red = static_cast<unsigned>(std::lround(a[0] + (b[0] - a[0]) * f));
+            const auto green = static_cast<unsigned>(std::lround(a[1] + (b[1] - a[1]) * f));
+            const auto blue = static_cast<unsigned>(std::lround(a[2] + (b[2] - a[2]) * f));
+            entries[i] = IM_COL32(red, green, blue, 255);
+        }
+    }
+};
+}  // namespace
+
+const uint32_t* viridis_colormap()
+{
+    static const Table table;
+    return table.entries;
+}
+
+}  // namespace elda::ui
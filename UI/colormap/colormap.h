@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstdint>
+
+namespace elda::ui
+{
+
+// Entries in a colour table
+static constexpr int k_colormap_size = 256;
+
+/**
+ * Viridis (perceptually uniform, dark blue to yellow) as packed IM_COL32 values, opaque
+ * Built on first use; ready to upload as GL_RGBA / GL_UNSIGNED_BYTE texels.
+ */
+const uint32_t* viridis_colormap();
+
+/**
+ * Table index of value in [low, high], clamped
+ */
+inline int colormap_index(float value, float low, float high)
+{
+    const float t = (value - low) / (high > low ? high - low : 1.0f);
+    const float index = t * (k_colormap_size - 1) + 0.5f;
+    return index <= 0.0f ? 0 : (index >= k_colormap_size - 1 ? k_colormap_size - 1 : static_cast<int>(index));
+}
+
+}  // namespace elda::ui
@@ -0,0 +1,149 @@
+#include "topomap_renderer.h"
+
+#include "UI/colormap/colormap.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <glad/glad.h>
+
+namespace elda::ui
+{
+
+namespace
+{
+constexpr int k_grid = 64;  // Texels across the outline
+constexpr double k_half_pi = 1.5707963267948966192313216916398;
+
+// Cap-normalized disk offset (outline at 1) to the sphere: the distance from the vertex is the polar angle
+dsp::SpherePoint disk_to_sphere(double ux, double uy)
+{
+    const double r = std::sqrt(ux * ux + uy * uy);
+    if (r <= 0.0)
+    {
+        return {};
+    }
+    const double polar = r * k_half_pi;
+    const double s = std::sin(polar) / r;
+    return {ux * s, uy * s, std::cos(polar)};
+}
+}  // namespace
+
+bool TopomapRenderer::available()
+{
+    if (!tried_)
+    {
+        tried_ = true;
+        ready_ = GLAD_GL_VERSION_3_2 != 0;  // glad not loaded or context too old
+        if (ready_)
+        {
+            glGenTextures(1, &texture_);
+            glBindTexture(GL_TEXTURE_2D, texture_);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, k_grid, k_grid, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+            glBindTexture(GL_TEXTURE_2D, 0);
+        }
+        std::printf("[Topomap] renderer %s\n", ready_ ? "ready" : "unavailable");
+    }
+    return ready_;
+}
+
+bool TopomapRenderer::set_layout(const std::vector<ImVec2>& electrodes)
+{
+    const bool same = electrodes.size() == layout_.size() &&
+                      std::equal(electrodes.begin(),
+                                 electrodes.end(),
+                                 layout_.begin(),
+                                 [](const ImVec2& a, const ImVec2& b)
+                                 {
+                                     return a.x == b.x && a.y == b.y;
+                                 });
+    if (same)
+    {
+        return layout_valid_;
+    }
+    layout_ = electrodes;
+    uploaded_ = false;
+
+    std::vector<dsp::SpherePoint> sensors;
+    sensors.reserve(electrodes.size());
+    for (const ImVec2& p : electrodes)
+    {
+        sensors.push_back(disk_to_sphere((p.x - 0.5) * 2.0, (p.y - 0.5) * 2.0));
+    }
+
+    // Texels inside the outline, and one texel beyond it so bilinear filtering fades out with the right colour
+    const double texel = 2.0 / k_grid;
+    const double rim = 1.0 + 1.5 * texel;
+    std::vector<dsp::SpherePoint> targets;
+    target_texels_.clear();
+    target_alpha_.clear();
+    for (int j = 0; j < k_grid; ++j)
+    {
+        for (int i = 0; i < k_grid; ++i)
+        {
+            const double ux = (i + 0.5) * texel - 1.0;
+            const double uy = (j + 0.5) * texel - 1.0;
+            const double r = std::sqrt(ux * ux + uy * uy);
+            if (r > rim)
+            {
+                continue;
+            }
+            targets.push_back(disk_to_sphere(ux, uy));
+            target_texels_.push_back(j * k_grid + i);
+            target_alpha_.push_back(r <= 1.0 ? 255 : 0);
+        }
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    layout_valid_ = !sensors.empty() && spline_.build(sensors, targets);
+    const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::printf("[Topomap] layout: %zu electrodes -> %zu texels (%.1f ms)%s\n",
+                sensors.size(),
+                targets.size(),
+                ms,
+                layout_valid_ ? "" : " - no map");
+    return layout_valid_;
+}
+
+void TopomapRenderer::update(const std::vector<float>& values, float low, float high)
+{
+    if (!available() || !layout_valid_ || static_cast<int>(values.size()) != spline_.electrodes())
+    {
+        return;
+    }
+
+    interpolated_.resize(static_cast<size_t>(spline_.targets()));
+    spline_.interpolate(values.data(), interpolated_.data());
+
+    const uint32_t* colormap = viridis_colormap();
+    texels_.assign(static_cast<size_t>(k_grid) * k_grid, 0u);
+    for (size_t t = 0; t < interpolated_.size(); ++t)
+    {
+        const uint32_t color = colormap[colormap_index(interpolated_[t], low, high)] & ~IM_COL32_A_MASK;
+        texels_[target_texels_[t]] = color | (static_cast<uint32_t>(target_alpha_[t]) << IM_COL32_A_SHIFT);
+    }
+
+    glBindTexture(GL_TEXTURE_2D, texture_);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, k_grid, k_grid, GL_RGBA, GL_UNSIGNED_BYTE, texels_.data());
+    glBindTexture(GL_TEXTURE_2D, 0);
+    uploaded_ = true;
+}
+
+void TopomapRenderer::draw(ImDrawList* draw_list, ImVec2 center, float radius) const
+{
+    if (!uploaded_)
+    {
+        return;
+    }
+    // Texel rows run top to bottom like the cap's y, so the texture maps straight onto the outline square
+    draw_list->AddImage((ImTextureID)(intptr_t)texture_,
+                        ImVec2(center.x - radius, center.y - radius),
+                        ImVec2(center.x + radius, center.y + radius));
+}
+
+}  // namespace elda::ui
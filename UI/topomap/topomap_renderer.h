@@ -0,0 +1,78 @@
+#pragma once
+
+#include "core/dsp/spherical_spline.h"
+#include "imgui.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace elda::ui
+{
+
+/**
+ * TopomapRenderer - head-shaped map of per-electrode values, interpolated with spherical splines
+ *
+ * Electrodes come in the impedance cap's normalized coordinates: (0.5, 0.5) is
+ * the vertex and the cap outline is at distance 0.5. The disk is read as an
+ * azimuthal projection, so the outline is the sphere's equator. A square grid
+ * of texels covers the outline; the spline matrix from every electrode to every
+ * texel inside (plus a one-texel rim for clean filtering) is built once per
+ * layout, and each update is one matrix-vector product and a texture upload.
+ *
+ * Needs glad and a GL 3.2 context like the chart renderers; all calls must come
+ * from the thread that owns the context. GL objects are released with the context.
+ */
+class TopomapRenderer
+{
+  public:
+    TopomapRenderer() = default;
+
+    TopomapRenderer(const TopomapRenderer&) = delete;
+    TopomapRenderer& operator=(const TopomapRenderer&) = delete;
+
+    /**
+     * @return false if the context or loader cannot provide textures (logged once)
+     */
+    bool available();
+
+    /**
+     * Rebuild the interpolation for a new electrode layout; unchanged layouts cost a comparison
+     * @param electrodes Cap-normalized positions
+     * @return false if no map can be built (no electrodes, or coincident electrodes)
+     */
+    bool set_layout(const std::vector<ImVec2>& electrodes);
+
+    /**
+     * Interpolate and upload a new map
+     * @param values One per layout electrode
+     * @param low,high Values mapped to the ends of the colour table
+     */
+    void update(const std::vector<float>& values, float low, float high);
+
+    /**
+     * Draw the map over the cap outline
+     * @param radius Outline radius in pixels
+     */
+    void draw(ImDrawList* draw_list, ImVec2 center, float radius) const;
+
+    bool has_map() const
+    {
+        return uploaded_;
+    }
+
+  private:
+    std::vector<ImVec2> layout_;
+    bool layout_valid_ = false;
+    dsp::SphericalSpline spline_;
+    std::vector<int> target_texels_;     // Texel of each spline target
+    std::vector<uint8_t> target_alpha_;  // 0 on the rim outside the outline
+    std::vector<float> interpolated_;
+    std::vector<uint32_t> texels_;
+
+    bool tried_ = false;
+    bool ready_ = false;
+    bool uploaded_ = false;
+    unsigned texture_ = 0;
+};
+
+}  // namespace elda::ui
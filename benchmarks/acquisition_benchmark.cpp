@@ -0,0 +1,221 @@
+#include "bench.h"
+#include "core/acquisition/nvx136_simulator.h"
+#include "core/acquisition/synth_eeg.h"
+#include "core/core.h"
+#include "core/sample_ring.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+namespace elda::bench
+{
+
+namespace
+{
+// Worst-case session: NVX136 at its top rate
+constexpr int k_channels = MAX_CHANNELS;
+constexpr float k_rate_hz = MAX_SAMPLE_RATE_HZ;
+constexpr int k_frames_per_tick = 25;  // 1 ms acquisition tick at 25 kHz
+constexpr int k_stream_seconds = 2;
+constexpr int k_repeats = 5;
+constexpr double k_link_seconds = 2.0;
+
+// Real-time run of the simulated NVX136 link with the acquisition thread's 1 ms drain
+void run_link(const AcquisitionFormat& format, const acquisition::LinkFaults& faults, const char* label)
+{
+    SampleRing ring(format.channels, format.buffer_size(), format.sample_rate_hz, RING_LAYOUT, RING_TILE_SAMPLES);
+    double busy_seconds = 0.0;
+
+    acquisition::SimulatedNvx136Source source(acquisition::SynthEEG::k_default_seed);
+    source.set_faults(faults);
+    if (!source.open() || !source.configure(format) || !source.start())
+    {
+        std::printf("  %-40s could not start the simulator\n", label);
+        return;
+    }
+
+    using clock = std::chrono::steady_clock;
+    const auto begin = clock::now();
+    const auto end = begin + std::chrono::duration_cast<clock::duration>(std::chrono::duration<double>(k_link_seconds));
+    while (clock::now() < end)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        const auto t0 = clock::now();
+        while (source.read_into(ring, 4096) > 0)
+        {
+        }
+        busy_seconds += std::chrono::duration<double>(clock::now() - t0).count();
+    }
+    source.stop();
+    source.close();
+
+    const acquisition::SourceStats stats = source.get_stats();
+    const double expected = format.sample_rate_hz * std::chrono::duration<double>(clock::now() - begin).count();
+    std::printf("  %-40s %6.1f%% of frames delivered, %llu lost packets, %llu concealed frames, "
+                "drain %.1f%% of one core\n",
+                label,
+                100.0 * static_cast<double>(ring.published()) / expected,
+                static_cast<unsigned long long>(stats.packets_lost),
+                static_cast<unsigned long long>(stats.frames_concealed),
+                100.0 * busy_seconds / k_link_seconds);
+}
+
+// Reader at the overwrite horizon while the producer pushes whole read-sized blocks: every sample read() returns
+// must still hold the value of its own index (value = index, exact in float below 2^24)
+void run_tear_check()
+{
+    constexpr int channels = 4;
+    constexpr int capacity = 4096;
+    constexpr int block_frames = 1024;  // k_min_read_frames in the acquisition thread
+    constexpr int read_frames = 512;
+    constexpr uint64_t k_index_mask = (1u << 24) - 1;
+
+    SampleRing ring(channels, capacity, k_rate_hz, RING_LAYOUT, RING_TILE_SAMPLES);
+    std::atomic<bool> stop{false};
+    std::thread producer(
+        [&]
+        {
+            while (!stop.load(std::memory_order_relaxed))
+            {
+                const uint64_t first = ring.published();
+                ring.push_with(block_frames,
+                               [&](int src_offset, int count, float* dst, size_t stride)
+                               {
+                                   for (int c = 0; c < channels; ++c)
+                                   {
+                                       for (int k = 0; k < count; ++k)
+                                       {
+                                           const uint64_t index = first + static_cast<uint64_t>(src_offset + k);
+                                           dst[c * stride + k] = static_cast<float>(index & k_index_mask);
+                                       }
+                                   }
+                               });
+            }
+        });
+
+    std::vector<float> out(static_cast<size_t>(channels) * read_frames);
+    uint64_t reads = 0;
+    uint64_t torn = 0;
+    uint64_t dropped = 0;
+    const auto until = std::chrono::steady_clock::now() + std::chrono::milliseconds(500);
+    while (std::chrono::steady_clock::now() < until)
+    {
+        // Start on the oldest retained sample, the one the next block overwrites first
+        SampleRing::ReadCursor cursor;
+        const uint64_t head = ring.published();
+        cursor.next = head > capacity ? head - capacity : 0;
+        const int got = ring.read(cursor, out.data(), read_frames, read_frames);
+        const uint64_t first = cursor.next - static_cast<uint64_t>(got);
+        for (int c = 0; c < channels; ++c)
+        {
+            for (int k = 0; k < got; ++k)
+            {
+                if (out[static_cast<size_t>(c) * read_frames + k] !=
+                    static_cast<float>((first + static_cast<uint64_t>(k)) & k_index_mask))
+                {
+                    ++torn;
+                }
+            }
+        }
+        dropped += cursor.overruns;
+        ++reads;
+    }
+    stop.store(true, std::memory_order_relaxed);
+    producer.join();
+
+    std::printf("  tear check: %llu reads at the horizon, %llu samples dropped as overruns, %llu torn\n",
+                static_cast<unsigned long long>(reads),
+                static_cast<unsigned long long>(dropped),
+                static_cast<unsigned long long>(torn));
+    check("ring read under 1024-frame pushes", torn == 0);
+}
+}  // namespace
+
+void run_acquisition_benchmarks()
+{
+    AcquisitionFormat format;
+    format.channels = k_channels;
+    format.sample_rate_hz = k_rate_hz;
+
+    const double required = format.samples_per_second();
+    const int total_frames = static_cast<int>(k_rate_hz) * k_stream_seconds;
+    const double total_samples = static_cast<double>(total_frames) * k_channels;
+
+    std::printf("[Bench] acquisition: %d ch @ %.0f Hz (%.2f M samples/s required, ring %.1f MiB)\n",
+                format.channels,
+                format.sample_rate_hz,
+                required / 1e6,
+                SampleRing::bytes_required(format.channels, format.buffer_size(), RING_LAYOUT, RING_TILE_SAMPLES) /
+                    (1024.0 * 1024.0));
+
+    SampleRing ring(format.channels, format.buffer_size(), format.sample_rate_hz, RING_LAYOUT, RING_TILE_SAMPLES);
+    std::vector<float> block(static_cast<size_t>(k_frames_per_tick) * k_channels);
+    for (size_t i = 0; i < block.size(); ++i)
+    {
+        block[i] = static_cast<float>(i % 97);
+    }
+
+    // Ring ingest alone: interleaved 1 ms ticks
+    double seconds = time_best_of(k_repeats,
+                                  [&]
+                                  {
+                                      for (int f = 0; f < total_frames; f += k_frames_per_tick)
+                                      {
+                                          ring.push_block(block.data(), k_frames_per_tick, FrameFormat::Interleaved);
+                                      }
+                                  });
+    report("ring push_block (interleaved)", total_samples, seconds, required);
+
+    // Generator alone, then the full producer path as run by AcquisitionThread
+    acquisition::SynthEEG synth(format.channels, format.sample_rate_hz);
+    seconds = time_best_of(k_repeats,
+                           [&]
+                           {
+                               for (int f = 0; f < total_frames; f += k_frames_per_tick)
+                               {
+                                   synth.next_block(block.data(), k_frames_per_tick);
+                               }
+                           });
+    report("synth next_block", total_samples, seconds, required);
+
+    seconds = time_best_of(k_repeats,
+                           [&]
+                           {
+                               for (int f = 0; f < total_frames; f += k_frames_per_tick)
+                               {
+                                   synth.next_block(block.data(), k_frames_per_tick);
+                                   ring.push_block(block.data(), k_frames_per_tick, FrameFormat::Interleaved);
+                               }
+                           });
+    report("synth + push (producer thread)", total_samples, seconds, required);
+
+    // Consumer drain: one cursor reading everything the producer published
+    std::vector<float> planar(static_cast<size_t>(k_channels) * total_frames);
+    seconds = time_best_of(k_repeats,
+                           [&]
+                           {
+                               SampleRing::ReadCursor cursor;
+                               cursor.next = ring.published() - static_cast<uint64_t>(total_frames);
+                               int remaining = total_frames;
+                               while (remaining > 0)
+                               {
+                                   const int got = ring.read(cursor, planar.data(), total_frames, remaining);
+                                   if (got <= 0)
+                                   {
+                                       break;
+                                   }
+                                   remaining -= got;
+                               }
+                           });
+    report("ring read (planar consumer)", total_samples, seconds, required);
+    run_tear_check();
+
+    // Simulated NVX136 over a local pipe: encode -> pipe -> reframe -> decode -> ring, in real time
+    run_link(format, {}, "nvx136 link (clean)");
+    run_link(format, {0.01f, 0}, "nvx136 link (1% loss)");
+    run_link(format, {0.0f, 2000}, "nvx136 link (2 ms jitter)");
+}
+
+}  // namespace elda::bench
@@ -0,0 +1,170 @@
+#pragma once
+
+#include "core/sample_ring.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+namespace elda::bench
+{
+
+/**
+ * Best-of-N wall time of fn() in seconds
+ * Best (not mean) filters out scheduler noise on a desktop machine.
+ */
+template <typename Fn>
+double time_best_of(int repeats, Fn&& fn)
+{
+    using clock = std::chrono::steady_clock;
+    double best = 1e30;
+    for (int r = 0; r < repeats; ++r)
+    {
+        const auto start = clock::now();
+        fn();
+        best = std::min(best, std::chrono::duration<double>(clock::now() - start).count());
+    }
+    return best;
+}
+
+/**
+ * Print one result line: throughput and headroom over the rate the app needs
+ * @param name Case name
+ * @param items Work items processed per run (samples, bytes, ...)
+ * @param seconds Best run time
+ * @param required Items per second the worst-case session needs (0 = no target)
+ * @param unit Unit label for items
+ */
+inline void report(const char* name, double items, double seconds, double required, const char* unit = "samples")
+{
+    const double rate = items / seconds;
+    if (required > 0.0)
+    {
+        std::printf("  %-40s %10.2f M %s/s   headroom %6.1fx\n", name, rate / 1e6, unit, rate / required);
+    }
+    else
+    {
+        std::printf("  %-40s %10.2f M %s/s\n", name, rate / 1e6, unit);
+    }
+}
+
+/**
+ * Next sample of the benchmarks' uniform noise: one LCG step, scaled to [-amplitude, amplitude)
+ * @param state LCG state, advanced in place so consecutive calls continue the stream
+ */
+inline float uniform_noise(uint32_t& state, float amplitude = 50.0f)
+{
+    state = state * 1664525u + 1013904223u;
+    return static_cast<float>(state >> 8) * (2.0f * amplitude / 16777216.0f) - amplitude;
+}
+
+/**
+ * Uniform noise in [-50, 50) µV for every channel of the next `frames` ring slots (runs the ring's stage)
+ * @param state LCG state, advanced in place so consecutive calls continue the stream
+ */
+inline void push_noise(SampleRing& ring, int frames, uint32_t& state)
+{
+    const int channels = ring.channels();
+    ring.push_with(frames,
+                   [&](int /*src_offset*/, int count, float* dst, size_t stride)
+                   {
+                       for (int c = 0; c < channels; ++c)
+                       {
+                           for (int k = 0; k < count; ++k)
+                           {
+                               dst[c * stride + k] = uniform_noise(state);
+                           }
+                       }
+                   });
+}
+
+/**
+ * Push a channel-major recording (ring.channels() x frames) into the ring in device-sized packets
+ * @param packet_frames Frames per push, as the acquisition thread receives them
+ */
+inline void push_planar_packets(SampleRing& ring, const float* planar, int frames, int packet_frames)
+{
+    const int channels = ring.channels();
+    for (int first = 0; first < frames; first += packet_frames)
+    {
+        ring.push_with(std::min(packet_frames, frames - first),
+                       [&](int src_offset, int count, float* dst, size_t stride)
+                       {
+                           for (int c = 0; c < channels; ++c)
+                           {
+                               std::copy_n(planar + static_cast<size_t>(c) * frames + first + src_offset,
+                                           count,
+                                           dst + c * stride);
+                           }
+                       });
+    }
+}
+
+/**
+ * Best-of-N time of fn() with a stage on the ring, to set against the same run without it
+ * The ring is reset and setup() re-arms the stage before every run, outside the timed region.
+ * @param setup Reconfigures the stage (and any rings it writes) for a fresh stream
+ */
+template <typename Setup, typename Fn>
+double time_with_stage(int repeats, SampleRing& ring, IRingStage& stage, Setup&& setup, Fn&& fn)
+{
+    double best = 1e30;
+    for (int r = 0; r < repeats; ++r)
+    {
+        ring.reset();
+        setup();
+        ring.set_stage(&stage);
+        best = std::min(best, time_best_of(1, fn));
+        ring.set_stage(nullptr);
+    }
+    return best;
+}
+
+/**
+ * Failed check() calls so far; main() exits non-zero if any
+ */
+inline int& check_failures()
+{
+    static int failures = 0;
+    return failures;
+}
+
+/**
+ * Print one correctness check next to the throughput lines and count a failure
+ * @param name What was checked
+ * @param passed Outcome
+ */
+inline void check(const char* name, bool passed)
+{
+    std::printf("  %-40s %s\n", name, passed ? "ok" : "FAILED");
+    if (!passed)
+    {
+        ++check_failures();
+    }
+}
+
+// ===== Suites =====
+
+void run_acquisition_benchmarks();
+
+void run_decoder_benchmarks();
+
+void run_chart_benchmarks();
+
+void run_spectrogram_benchmarks();
+
+void run_topomap_benchmarks();
+
+void run_filter_benchmarks();
+
+void run_montage_benchmarks();
+
+void run_gradient_benchmarks();
+
+void run_pulse_benchmarks();
+
+void run_resample_benchmarks();
+
+}  // namespace elda::bench
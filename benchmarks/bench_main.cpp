@@ -0,0 +1,19 @@
+#include "bench.h"
+
+// Throughput ceilings for the acquisition / DSP / render-prep paths.
+// Build with -DALDA_BUILD_BENCHMARKS=ON and run in Release.
+int main()
+{
+    std::printf("[Bench] ALDA throughput benchmarks\n");
+    elda::bench::run_acquisition_benchmarks();
+    elda::bench::run_decoder_benchmarks();
+    elda::bench::run_chart_benchmarks();
+    elda::bench::run_spectrogram_benchmarks();
+    elda::bench::run_topomap_benchmarks();
+    elda::bench::run_filter_benchmarks();
+    elda::bench::run_montage_benchmarks();
+    elda::bench::run_gradient_benchmarks();
+    elda::bench::run_pulse_benchmarks();
+    elda::bench::run_resample_benchmarks();
+    return elda::bench::check_failures() == 0 ? 0 : 1;
+}
@@ -0,0 +1,221 @@
+#include "bench.h"
+#include "UI/chart/sweep_trace.h"
+#include "UI/chart/trace_decimator.h"
+#include "core/core.h"
+#include "core/minmax_pyramid.h"
+#include "core/sample_ring.h"
+#include "core/worker_pool.h"
+
+#include <memory>
+#include <vector>
+
+namespace elda::bench
+{
+
+namespace
+{
+// Worst-case monitoring frame: every channel over a 20 s window at the top rate, ~1800 px plot
+constexpr int k_channels = MAX_CHANNELS;
+constexpr float k_rate_hz = MAX_SAMPLE_RATE_HZ;
+constexpr int k_window_seconds = 20;
+constexpr int k_plot_px = 1800;
+constexpr double k_target_fps = 60.0;
+constexpr int k_repeats = 5;
+constexpr int k_streamed_frames = 120;
+constexpr int k_scaling_channels[] = {64, MAX_CHANNELS, 256};
+
+/**
+ * Envelope preparation for one frame of `channels` rows, serial and on the pool
+ * The ring holds just the window (+1 s) so 256 ch fits in memory.
+ */
+void run_frame_scaling(int channels, WorkerPool& pool)
+{
+    const auto window_samples = static_cast<uint64_t>(k_rate_hz) * k_window_seconds;
+    const double samples_per_px = static_cast<double>(window_samples) / k_plot_px;
+    const auto capacity = static_cast<int>(window_samples) + static_cast<int>(k_rate_hz);
+
+    auto ring = std::make_unique<SampleRing>(channels, capacity, k_rate_hz, RING_LAYOUT, RING_TILE_SAMPLES);
+    uint32_t state = 0x2545F491u;
+    push_noise(*ring, static_cast<int>(window_samples), state);
+    auto pyramid = std::make_unique<MinMaxPyramid>(*ring);
+    pyramid->update(*ring);
+
+    std::vector<ui::SweepTrace> traces(static_cast<size_t>(channels));
+    auto prepare = [&](bool parallel, bool rebuild)
+    {
+        const ui::ColumnReducer reducer(*ring, pyramid.get());
+        const uint64_t head = ring->published();
+        const uint64_t oldest = head - std::min<uint64_t>(head, static_cast<uint64_t>(ring->capacity()));
+        auto row = [&](int c)
+        {
+            if (rebuild)
+            {
+                traces[static_cast<size_t>(c)] = ui::SweepTrace();
+            }
+            traces[static_cast<size_t>(c)].update(reducer, c, head, oldest, window_samples, samples_per_px);
+        };
+        if (parallel)
+        {
+            pool.parallel_for(channels, row);
+        }
+        else
+        {
+            for (int c = 0; c < channels; ++c)
+            {
+                row(c);
+            }
+        }
+    };
+
+    const double rebuild_serial = time_best_of(k_repeats, [&] { prepare(false, true); });
+    const double rebuild_pool = time_best_of(k_repeats, [&] { prepare(true, true); });
+
+    // Streaming: one display frame of new samples between updates
+    const auto frame_advance = static_cast<int>(k_rate_hz / k_target_fps);
+    double stream_serial = 0.0;
+    double stream_pool = 0.0;
+    for (int f = 0; f < k_streamed_frames; ++f)
+    {
+        push_noise(*ring, frame_advance, state);
+        pyramid->update(*ring);
+        const bool parallel = (f & 1) != 0;
+        (parallel ? stream_pool : stream_serial) += time_best_of(1, [&] { prepare(parallel, false); });
+    }
+    stream_serial /= k_streamed_frames / 2;
+    stream_pool /= k_streamed_frames / 2;
+
+    std::printf("  %3d ch   rebuild %8.2f / %8.2f ms   incremental %7.3f / %7.3f ms   (serial / pool)\n",
+                channels,
+                rebuild_serial * 1e3,
+                rebuild_pool * 1e3,
+                stream_serial * 1e3,
+                stream_pool * 1e3);
+}
+}  // namespace
+
+void run_chart_benchmarks()
+{
+    AcquisitionFormat format;
+    format.channels = k_channels;
+    format.sample_rate_hz = k_rate_hz;
+
+    const auto window_samples = static_cast<uint64_t>(k_rate_hz) * k_window_seconds;
+    const double frame_samples = static_cast<double>(window_samples) * k_channels;
+    const double required = frame_samples * k_target_fps;
+    const double samples_per_px = static_cast<double>(window_samples) / k_plot_px;
+
+    std::printf("[Bench] chart prep: %d ch x %d s window @ %.0f Hz on %d px (%.0f samples/px, %.0f fps target)\n",
+                k_channels,
+                k_window_seconds,
+                k_rate_hz,
+                k_plot_px,
+                samples_per_px,
+                k_target_fps);
+
+    SampleRing ring(format.channels, format.buffer_size(), format.sample_rate_hz, RING_LAYOUT, RING_TILE_SAMPLES);
+    uint32_t state = 0x9E3779B9u;
+    push_noise(ring, static_cast<int>(window_samples), state);
+
+    std::vector<float> xs;
+    std::vector<float> ys;
+    xs.reserve(window_samples + 1);
+    ys.reserve(window_samples + 1);
+
+    // Raw path: one plot point per sample (previous draw_chart behaviour)
+    double seconds = time_best_of(k_repeats,
+                                  [&]
+                                  {
+                                      for (int c = 0; c < k_channels; ++c)
+                                      {
+                                          xs.clear();
+                                          ys.clear();
+                                          for (uint64_t n = 0; n < window_samples; ++n)
+                                          {
+                                              xs.push_back(static_cast<float>(static_cast<double>(n) / k_rate_hz));
+                                              ys.push_back(60.0f + 0.5f * ring.sample(c, ring.slot_of(n)));
+                                          }
+                                      }
+                                  });
+    report("raw points (all samples)", frame_samples, seconds, required);
+    std::printf("  %-40s %10.2f ms/frame, %llu points/channel\n",
+                "",
+                seconds * 1e3,
+                static_cast<unsigned long long>(xs.size()));
+
+    // Min/max envelope rebuilt from scratch every frame: ~2 points per pixel column
+    // published == window_samples: the cursor sits at x = 0 with the whole previous cycle ahead of it
+    const uint64_t published = ring.published();
+    int points = 0;
+    auto rebuild_all = [&](const ui::ColumnReducer& reducer)
+    {
+        for (int c = 0; c < k_channels; ++c)
+        {
+            ui::SweepTrace trace;
+            trace.update(reducer, c, published, 0, window_samples, samples_per_px);
+            points = trace.previous().points();
+        }
+    };
+
+    seconds = time_best_of(k_repeats, [&] { rebuild_all(ui::ColumnReducer(ring, nullptr)); });
+    report("min/max envelope (raw scan)", frame_samples, seconds, required);
+    std::printf("  %-40s %10.2f ms/frame, %d points/channel\n", "", seconds * 1e3, points);
+
+    // Pyramid maintenance as done by the producer after each 1 ms tick (same data, rebuilt from scratch)
+    MinMaxPyramid pyramid(ring);
+    seconds = time_best_of(k_repeats,
+                           [&]
+                           {
+                               pyramid.reset();
+                               pyramid.update(ring);
+                           });
+    report("pyramid build (window, one pass)", frame_samples, seconds, format.samples_per_second());
+    std::printf("  %-40s %10.2f MiB for %d levels\n",
+                "",
+                pyramid.memory_bytes() / (1024.0 * 1024.0),
+                pyramid.levels());
+
+    // Envelope answered from the pyramid: O(columns), independent of the window length
+    seconds = time_best_of(k_repeats, [&] { rebuild_all(ui::ColumnReducer(ring, &pyramid)); });
+    report("min/max envelope (pyramid)", frame_samples, seconds, required);
+    std::printf("  %-40s %10.2f ms/frame, %d points/channel\n", "", seconds * 1e3, points);
+
+    // Streaming: persistent traces, one display frame of new data (rate / fps samples) between updates
+    std::vector<ui::SweepTrace> traces(static_cast<size_t>(k_channels));
+    const auto frame_advance = static_cast<int>(k_rate_hz / k_target_fps);
+    auto update_all = [&]
+    {
+        const ui::ColumnReducer reducer(ring, &pyramid);
+        const uint64_t head = ring.published();
+        const uint64_t oldest = head - std::min<uint64_t>(head, static_cast<uint64_t>(ring.capacity()));
+        for (int c = 0; c < k_channels; ++c)
+        {
+            traces[static_cast<size_t>(c)].update(reducer, c, head, oldest, window_samples, samples_per_px);
+        }
+    };
+    update_all();
+
+    double streamed = 0.0;
+    for (int f = 0; f < k_streamed_frames; ++f)
+    {
+        push_noise(ring, frame_advance, state);
+        pyramid.update(ring);
+        streamed += time_best_of(1, update_all);
+    }
+    seconds = streamed / k_streamed_frames;
+    report("min/max envelope (incremental)", frame_samples, seconds, required);
+    std::printf("  %-40s %10.3f ms/frame, %d new samples/channel/frame\n", "", seconds * 1e3, frame_advance);
+
+    // Per-frame envelope prep vs channel count, on the chart's worker pool
+    WorkerPool pool(WorkerPool::default_workers());
+    std::printf("[Bench] chart prep scaling: %d s window @ %.0f Hz on %d px, %d pool workers + caller\n",
+                k_window_seconds,
+                k_rate_hz,
+                k_plot_px,
+                pool.workers());
+    for (int channels : k_scaling_channels)
+    {
+        run_frame_scaling(channels, pool);
+    }
+}
+
+}  // namespace elda::bench
@@ -0,0 +1,112 @@
+#include "bench.h"
+#include "core/acquisition/adc_decoder.h"
+#include "core/acquisition/nvx_packet.h"
+#include "core/core.h"
+#include "core/sample_ring.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace elda::bench
+{
+
+namespace nvx = acquisition::nvx;
+
+namespace
+{
+// Worst-case session: NVX136 at its top rate, ~1 ms packets
+constexpr int k_channels = MAX_CHANNELS;
+constexpr float k_rate_hz = MAX_SAMPLE_RATE_HZ;
+constexpr int k_packet_frames = 25;
+constexpr int k_packets = 2000;  // 2 s of stream
+constexpr int k_repeats = 5;
+}  // namespace
+
+void run_decoder_benchmarks()
+{
+    AcquisitionFormat format;
+    format.channels = k_channels;
+    format.sample_rate_hz = k_rate_hz;
+
+    const size_t packet_values = static_cast<size_t>(k_packet_frames) * k_channels;
+    const size_t payload_bytes = packet_values * nvx::k_bytes_per_sample;
+    const double total_bytes = static_cast<double>(payload_bytes) * k_packets;
+    const double required_bytes = format.samples_per_second() * nvx::k_bytes_per_sample;
+
+    std::printf("[Bench] 24-bit decode: %d ch, %d-frame packets (%.2f MB/s of payload required)\n",
+                k_channels,
+                k_packet_frames,
+                required_bytes / 1e6);
+
+    // One payload reused for every packet (+4 bytes of slack for the SIMD overread)
+    std::vector<float> source(packet_values);
+    for (size_t i = 0; i < source.size(); ++i)
+    {
+        source[i] = static_cast<float>(static_cast<int>(i % 2001) - 1000) * 3.7f;
+    }
+    std::vector<uint8_t> payload(payload_bytes + 4);
+    nvx::encode_int24(source.data(), packet_values, nvx::k_uv_per_lsb, payload.data());
+
+    SampleRing ring(format.channels, format.buffer_size(), format.sample_rate_hz, RING_LAYOUT, RING_TILE_SAMPLES);
+    // Touch the whole slab once so neither case pays first-touch page faults
+    ring.push_with(ring.capacity(),
+                   [](int /*src_offset*/, int count, float* dst, size_t stride)
+                   {
+                       for (int c = 0; c < k_channels; ++c)
+                       {
+                           std::fill_n(dst + c * stride, count, 0.0f);
+                       }
+                   });
+
+    // Previous path: scalar decode to interleaved µV, then transpose into the ring
+    const uint8_t* packet = payload.data();
+    std::vector<float> block(packet_values);
+    double seconds = time_best_of(k_repeats,
+                                  [&]
+                                  {
+                                      for (int p = 0; p < k_packets; ++p)
+                                      {
+                                          nvx::decode_int24(packet, packet_values, nvx::k_uv_per_lsb, block.data());
+                                          ring.push_block(block.data(), k_packet_frames, FrameFormat::Interleaved);
+                                      }
+                                  });
+    report("scalar decode + push_block", total_bytes, seconds, required_bytes, "bytes");
+
+    // Fused path: unpack + calibrate + transpose straight into the ring slab
+    std::vector<acquisition::ChannelCalibration> calibration(k_channels);
+    for (int c = 0; c < k_channels; ++c)
+    {
+        calibration[c].gain = 1.0f + 0.01f * static_cast<float>(c);
+        calibration[c].offset = 0.5f;
+        calibration[c].unit_scale = c % 8 == 7 ? 1e-3f : 1.0f;
+    }
+    acquisition::AdcDecoder decoder;
+    decoder.configure(k_channels, nvx::k_uv_per_lsb, calibration);
+
+    // Decoder alone into a cache-resident packet buffer (per-core decode ceiling)
+    std::vector<float> planar(packet_values);
+    seconds = time_best_of(k_repeats,
+                           [&]
+                           {
+                               for (int p = 0; p < k_packets; ++p)
+                               {
+                                   decoder.decode_planar(packet, k_packet_frames, planar.data(), k_packet_frames);
+                               }
+                           });
+    report("AdcDecoder alone (in cache)", total_bytes, seconds, required_bytes, "bytes");
+
+    const size_t frame_bytes = static_cast<size_t>(k_channels) * nvx::k_bytes_per_sample;
+    auto decode_into_ring = [&](int src_offset, int count, float* dst, size_t stride)
+    { decoder.decode_planar(packet + src_offset * frame_bytes, count, dst, stride); };
+    seconds = time_best_of(k_repeats,
+                           [&]
+                           {
+                               for (int p = 0; p < k_packets; ++p)
+                               {
+                                   ring.push_with(k_packet_frames, decode_into_ring);
+                               }
+                           });
+    report("AdcDecoder -> ring (calibrated)", total_bytes, seconds, required_bytes, "bytes");
+}
+
+}  // namespace elda::bench
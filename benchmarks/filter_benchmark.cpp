@@ -0,0 +1,193 @@
+#include "bench.h"
+#include "core/core.h"
+#include "core/dsp/iir_filter_bank.h"
+#include "core/sample_ring.h"
+#include "models/channel.h"
+#include "views/admin_settings/tabs/channels_config/channels_config_model.h"
+
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace elda::bench
+{
+
+namespace
+{
+// Worst-case session: NVX136 at its top rate, every channel on the full cascade, ~1 ms packets
+constexpr int k_channels = MAX_CHANNELS;
+constexpr float k_rate_hz = MAX_SAMPLE_RATE_HZ;
+constexpr int k_packet_frames = 25;
+constexpr int k_packets = 2000;  // 2 s of stream
+constexpr int k_repeats = 5;
+constexpr double k_offset_uv = 5000.0;  // Electrode offset under the signal
+
+const dsp::FilterSpec k_full_spec{0.001, 250.0, 50.0};
+
+void fill_packet(std::vector<float>& planar, int frames)
+{
+    for (int c = 0; c < k_channels; ++c)
+    {
+        for (int k = 0; k < frames; ++k)
+        {
+            const double t = k / static_cast<double>(k_rate_hz);
+            planar[static_cast<size_t>(c) * frames + k] =
+                static_cast<float>(k_offset_uv + 20.0 * std::sin(2.0 * 3.14159265358979 * (10.0 + c) * t));
+        }
+    }
+}
+
+// Per-channel scalar cascade in double, the straightforward alternative to the lane groups
+void filter_scalar(const dsp::FilterDesign& design, std::vector<double>& state, float* data, size_t stride, int count)
+{
+    const std::vector<dsp::BiquadSection>& sections = design.sections();
+    for (int c = 0; c < k_channels; ++c)
+    {
+        double* s = state.data() + static_cast<size_t>(c) * sections.size() * 2;
+        float* row = data + static_cast<size_t>(c) * stride;
+        for (int k = 0; k < count; ++k)
+        {
+            double x = row[k];
+            for (size_t i = 0; i < sections.size(); ++i)
+            {
+                const dsp::BiquadSection& q = sections[i];
+                const double y = q.b0 * x + s[2 * i];
+                s[2 * i] = q.b1 * x - q.a1 * y + s[2 * i + 1];
+                s[2 * i + 1] = q.b2 * x - q.a2 * y;
+                x = y;
+            }
+            row[k] = static_cast<float>(x);
+        }
+    }
+}
+
+// Corner the 0.001 Hz high-pass actually gets with float vs double coefficients (pole p: fc = (1 - p) fs / 2 pi)
+void run_precision_check()
+{
+    const dsp::FilterDesign& design = *dsp::FilterDesign::plan(k_rate_hz, dsp::FilterSpec{0.001, 0.0, 0.0});
+    const double a1 = design.sections().front().a1;
+    const double scale = k_rate_hz / (2.0 * 3.14159265358979);
+    std::printf("  0.001 Hz high-pass corner: %.6f Hz with double coefficients, %.6f Hz with float\n",
+                (1.0 + a1) * scale,
+                (1.0 + static_cast<double>(static_cast<float>(a1))) * scale);
+}
+
+// Admin HPF / LPF / ADF choices -> the spec AppStateManager::build_filters hands AcquisitionThread::set_filters
+void run_channel_config_check()
+{
+    using namespace views::channels_config;
+
+    ChannelConfig config;
+    config.hpf = HPFOption::DC;
+    config.lpf = LPFOption::NONE;
+    config.adf = ADFOption::OFF;
+    models::Channel channel(std::string("ch_0"), "Fp1");
+    channel.amplifier_channel = 0;
+    apply_filtering(config, channel);
+    check("admin DC / None / Off -> no filters", !channel.filtered && dsp::filter_for(channel) == dsp::FilterSpec{});
+
+    config.hpf = HPFOption::HPF_01;
+    config.lpf = LPFOption::LPF_250;
+    config.adf = ADFOption::ADF_50;
+    apply_filtering(config, channel);
+    check("admin 0.1 Hz / 250 Hz / 50 Hz -> spec", dsp::filter_for(channel) == dsp::FilterSpec{0.1, 250.0, 50.0});
+
+    config.hpf = HPFOption::DC;
+    config.lpf = LPFOption::NONE;
+    config.adf = ADFOption::ADF_60;
+    apply_filtering(config, channel);
+    check("admin notch only -> spec", dsp::filter_for(channel) == dsp::FilterSpec{0.0, 0.0, 60.0});
+}
+}  // namespace
+
+void run_filter_benchmarks()
+{
+    AcquisitionFormat format;
+    format.channels = k_channels;
+    format.sample_rate_hz = k_rate_hz;
+    const double total = static_cast<double>(k_packet_frames) * k_packets * k_channels;
+
+    std::printf("[Bench] IIR filter bank: %d ch @ %.0f Hz, HPF %.3f Hz + notch %.0f Hz + LPF %.0f Hz (%zu sections)\n",
+                k_channels,
+                k_rate_hz,
+                k_full_spec.high_pass_hz,
+                k_full_spec.notch_hz,
+                k_full_spec.low_pass_hz,
+                dsp::FilterDesign::plan(k_rate_hz, k_full_spec)->sections().size());
+
+    std::vector<float> packet(static_cast<size_t>(k_packet_frames) * k_channels);
+    fill_packet(packet, k_packet_frames);
+    std::vector<float> work(packet.size());
+    const std::vector<dsp::FilterSpec> specs(k_channels, k_full_spec);
+
+    const std::shared_ptr<const dsp::FilterDesign> design = dsp::FilterDesign::plan(k_rate_hz, k_full_spec);
+    std::vector<double> scalar_state(static_cast<size_t>(k_channels) * design->sections().size() * 2);
+    double seconds = time_best_of(k_repeats,
+                                  [&]
+                                  {
+                                      for (int p = 0; p < k_packets; ++p)
+                                      {
+                                          work = packet;
+                                          filter_scalar(
+                                              *design, scalar_state, work.data(), k_packet_frames, k_packet_frames);
+                                      }
+                                  });
+    report("scalar double, one channel at a time", total, seconds, format.samples_per_second());
+
+    dsp::IirFilterBank bank;
+    bank.configure(specs, k_rate_hz);
+    seconds = time_best_of(k_repeats,
+                           [&]
+                           {
+                               for (int p = 0; p < k_packets; ++p)
+                               {
+                                   work = packet;
+                                   bank.process(static_cast<uint64_t>(p) * k_packet_frames,
+                                                work.data(),
+                                                k_packet_frames,
+                                                k_packet_frames);
+                               }
+                           });
+    report("IirFilterBank, 4 channels per group", total, seconds, format.samples_per_second());
+
+    // In place as the ring's producer stage, as the acquisition thread runs it
+    SampleRing ring(format.channels, format.buffer_size(), format.sample_rate_hz, RING_LAYOUT, RING_TILE_SAMPLES);
+    auto copy_packet = [&](int src_offset, int count, float* dst, size_t stride)
+    {
+        for (int c = 0; c < k_channels; ++c)
+        {
+            std::copy_n(packet.data() + static_cast<size_t>(c) * k_packet_frames + src_offset, count, dst + c * stride);
+        }
+    };
+    seconds = time_best_of(k_repeats,
+                           [&]
+                           {
+                               for (int p = 0; p < k_packets; ++p)
+                               {
+                                   ring.push_with(k_packet_frames, copy_packet);
+                               }
+                           });
+    report("packet -> ring, no stage", total, seconds, format.samples_per_second());
+
+    ring.set_stage(&bank);
+    seconds = time_best_of(k_repeats,
+                           [&]
+                           {
+                               for (int p = 0; p < k_packets; ++p)
+                               {
+                                   ring.push_with(k_packet_frames, copy_packet);
+                               }
+                           });
+    ring.set_stage(nullptr);
+    report("packet -> ring, filter stage", total, seconds, format.samples_per_second());
+
+    // Session start: every channel shares one cached design
+    seconds = time_best_of(k_repeats, [&] { bank.configure(specs, k_rate_hz); });
+    std::printf("  %-40s %10.3f ms\n", "configure (cached design)", seconds * 1e3);
+
+    run_precision_check();
+    run_channel_config_check();
+}
+
+}  // namespace elda::bench
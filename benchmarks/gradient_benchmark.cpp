@@ -0,0 +1,162 @@
+#include "bench.h"
+#include "core/core.h"
+#include "core/dsp/gradient_artifact.h"
+#include "core/sample_ring.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace elda::bench
+{
+
+namespace
+{
+// EEG-fMRI session: 64 EEG channels + the scanner's volume trigger at 5 kHz, ~1 ms packets
+constexpr int k_eeg_channels = 64;
+constexpr int k_channels = k_eeg_channels + 1;
+constexpr int k_trigger_channel = k_eeg_channels;
+constexpr float k_rate_hz = 5000.0f;
+constexpr int k_packet_frames = 5;
+constexpr double k_tr_ms = 1950.23;  // 9751.15 samples: onsets drift across the sample grid
+constexpr int k_volumes = 30;
+constexpr int k_warmup_volumes = dsp::GradientArtifactCorrector::k_min_epochs + 1;
+constexpr int k_repeats = 3;
+constexpr double k_pi = 3.14159265358979;
+
+struct Recording
+{
+    int frames = 0;
+    std::vector<float> eeg;       // Channel-major, k_eeg_channels x frames
+    std::vector<float> recorded;  // Channel-major, k_channels x frames: EEG + artifact, and the trigger
+};
+
+// Gradient waveform of one channel at time t (s) after a volume onset: slice-rate and readout components
+double artifact(int channel, double t)
+{
+    const double tr = k_tr_ms / 1000.0;
+    const double envelope = std::sin(k_pi * t / tr);
+    const double amplitude = 2000.0 * (1.0 + static_cast<double>(channel) / k_eeg_channels);
+    return amplitude * envelope * envelope *
+           (std::sin(2.0 * k_pi * 15.4 * t) + 0.5 * std::sin(2.0 * k_pi * 123.0 * t + 1.0) +
+            0.2 * std::sin(2.0 * k_pi * 703.0 * t + 0.3 * channel));
+}
+
+Recording make_recording()
+{
+    const double period = k_tr_ms * k_rate_hz / 1000.0;
+    Recording recording;
+    recording.frames = static_cast<int>(period * k_volumes);
+    const auto frames = static_cast<size_t>(recording.frames);
+    recording.eeg.resize(k_eeg_channels * frames);
+    recording.recorded.resize(k_channels * frames);
+
+    uint32_t state = 0x2545F491u;
+    for (int n = 0; n < recording.frames; ++n)
+    {
+        // Onsets at v * period; the trigger edge (a 4-sample ramp) passes 0.5 exactly at the onset
+        const double since = std::fmod(static_cast<double>(n), period);
+        const double t = since / k_rate_hz;
+        const double edge = since < period * 0.5 ? since : since - period;
+        const float trigger = edge < 10.0 ? static_cast<float>(std::clamp(edge / 4.0 + 0.5, 0.0, 1.0)) : 0.0f;
+        recording.recorded[k_trigger_channel * frames + n] = trigger;
+        for (int c = 0; c < k_eeg_channels; ++c)
+        {
+            const float eeg = uniform_noise(state);
+            recording.eeg[c * frames + n] = eeg;
+            recording.recorded[c * frames + n] = eeg + static_cast<float>(artifact(c, t));
+        }
+    }
+    return recording;
+}
+
+// Correct the recording in packets; residual artifact after the warm-up, relative to the artifact
+double residual_ratio(const Recording& recording, dsp::GradientArtifactCorrector& corrector)
+{
+    std::vector<float> data = recording.recorded;
+    const auto frames = static_cast<size_t>(recording.frames);
+    for (int first = 0; first < recording.frames; first += k_packet_frames)
+    {
+        const int count = std::min(k_packet_frames, recording.frames - first);
+        corrector.process(static_cast<uint64_t>(first), data.data() + first, frames, count);
+    }
+
+    const auto from = static_cast<size_t>(k_tr_ms * k_rate_hz / 1000.0 * k_warmup_volumes);
+    double residual = 0.0;
+    double before = 0.0;
+    for (int c = 0; c < k_eeg_channels; ++c)
+    {
+        for (size_t n = from; n < frames; ++n)
+        {
+            const double eeg = recording.eeg[c * frames + n];
+            const double error = data[c * frames + n] - eeg;
+            const double gradient = recording.recorded[c * frames + n] - eeg;
+            residual += error * error;
+            before += gradient * gradient;
+        }
+    }
+    return std::sqrt(residual / before);
+}
+}  // namespace
+
+void run_gradient_benchmarks()
+{
+    std::printf("[Bench] gradient artifact: %d EEG ch @ %.0f Hz, TR %.2f ms, %d volumes, %d-frame packets\n",
+                k_eeg_channels,
+                k_rate_hz,
+                k_tr_ms,
+                k_volumes,
+                k_packet_frames);
+
+    const Recording recording = make_recording();
+    std::vector<int> channels(k_eeg_channels);
+    for (int c = 0; c < k_eeg_channels; ++c)
+    {
+        channels[c] = c;
+    }
+
+    dsp::GradientCorrectionSpec spec;
+    spec.enabled = true;
+    spec.tr_ms = k_tr_ms;
+    dsp::GradientArtifactCorrector corrector;
+
+    // Quality: artifact left after subtraction, onsets from the period and from the trigger edge
+    const char* modes[] = {"TR period", "trigger channel"};
+    for (int mode = 0; mode < 2; ++mode)
+    {
+        spec.trigger_channel = mode == 0 ? -1 : k_trigger_channel;
+        corrector.configure(spec, channels, k_rate_hz);
+        const double ratio = residual_ratio(recording, corrector);
+        const dsp::GradientCorrectionStats stats = corrector.stats();
+        std::printf("  onsets from %-16s residual %.4f of the artifact (%.1f dB), %llu volumes, template of %d\n",
+                    modes[mode],
+                    ratio,
+                    20.0 * std::log10(ratio),
+                    static_cast<unsigned long long>(stats.volumes),
+                    stats.template_epochs);
+    }
+
+    // Throughput: the recording pushed through the ring with and without the stage
+    SampleRing ring(k_channels, static_cast<int>(k_rate_hz) * 5, k_rate_hz, RING_LAYOUT, RING_TILE_SAMPLES);
+    auto stream = [&] { push_planar_packets(ring, recording.recorded.data(), recording.frames, k_packet_frames); };
+
+    const double total = static_cast<double>(recording.frames) * k_channels;
+    const double required = static_cast<double>(k_rate_hz) * k_channels;
+    report("recording -> ring, no stage", total, time_best_of(k_repeats, stream), required);
+
+    spec.trigger_channel = k_trigger_channel;
+    const double corrected = time_with_stage(
+        k_repeats, ring, corrector, [&] { corrector.configure(spec, channels, k_rate_hz); }, stream);
+    report("recording -> ring, gradient stage", total, corrected, required);
+
+    // Per-TR template work (fold + shifted template) is one burst on the producer thread
+    const dsp::GradientCorrectionStats stats = corrector.stats();
+    std::printf("  template update per TR: mean %.2f ms, max %.2f ms (%d ch x %d samples, %d-volume window)\n",
+                stats.mean_update_ms,
+                stats.max_update_ms,
+                k_eeg_channels,
+                corrector.template_length(),
+                corrector.epochs());
+}
+
+}  // namespace elda::bench
@@ -0,0 +1,204 @@
+#include "bench.h"
+#include "UI/chart/sweep_trace.h"
+#include "UI/chart/trace_decimator.h"
+#include "core/core.h"
+#include "core/dsp/montage.h"
+#include "core/minmax_pyramid.h"
+#include "core/sample_ring.h"
+
+#include <cmath>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace elda::bench
+{
+
+namespace
+{
+// Worst-case session on a 10 s sweep: every channel at the top rate, one page of rows on a ~1800 px plot
+constexpr int k_channels = MAX_CHANNELS;
+constexpr float k_rate_hz = MAX_SAMPLE_RATE_HZ;
+constexpr int k_window_seconds = 10;
+constexpr int k_plot_px = 1800;
+constexpr int k_visible_rows = 32;
+constexpr double k_target_fps = 60.0;
+constexpr int k_packet_frames = 25;
+constexpr int k_packets = 2000;
+constexpr int k_repeats = 5;
+constexpr int k_streamed_frames = 60;
+
+// 10-20 electrodes with approximate positions on the unit disc; the remaining channels spiral around them
+struct NamedSite
+{
+    const char* name;
+    float x;
+    float y;
+};
+constexpr NamedSite k_sites[] = {
+    {"Fp1", -0.3f, 0.95f}, {"Fp2", 0.3f, 0.95f}, {"F7", -0.8f, 0.6f}, {"F3", -0.4f, 0.5f}, {"Fz", 0.0f, 0.45f},
+    {"F4", 0.4f, 0.5f}, {"F8", 0.8f, 0.6f}, {"T3", -1.0f, 0.0f}, {"C3", -0.5f, 0.0f}, {"Cz", 0.0f, 0.0f},
+    {"C4", 0.5f, 0.0f}, {"T4", 1.0f, 0.0f}, {"T5", -0.8f, -0.6f}, {"P3", -0.4f, -0.5f}, {"Pz", 0.0f, -0.45f},
+    {"P4", 0.4f, -0.5f}, {"T6", 0.8f, -0.6f}, {"O1", -0.3f, -0.95f}, {"O2", 0.3f, -0.95f},
+};
+
+std::vector<dsp::MontageElectrode> make_electrodes(int channels)
+{
+    std::vector<dsp::MontageElectrode> electrodes(static_cast<size_t>(channels));
+    for (int c = 0; c < channels; ++c)
+    {
+        dsp::MontageElectrode& electrode = electrodes[c];
+        electrode.channel = c;
+        if (c < static_cast<int>(std::size(k_sites)))
+        {
+            electrode.name = k_sites[c].name;
+            electrode.x = 1.0f + k_sites[c].x;  // (0, 0) means "not placed"
+            electrode.y = 1.0f + k_sites[c].y;
+            continue;
+        }
+        // Golden-angle spiral over the unit disc
+        const float r = std::sqrt((c + 0.5f) / channels);
+        const float a = 2.39996323f * static_cast<float>(c);
+        electrode.name = "E" + std::to_string(c + 1);
+        electrode.x = 1.0f + r * std::cos(a);
+        electrode.y = 1.0f + r * std::sin(a);
+    }
+    return electrodes;
+}
+}  // namespace
+
+void run_montage_benchmarks()
+{
+    AcquisitionFormat format;
+    format.channels = k_channels;
+    format.sample_rate_hz = k_rate_hz;
+
+    const auto window_samples = static_cast<uint64_t>(k_rate_hz) * k_window_seconds;
+    const double samples_per_px = static_cast<double>(window_samples) / k_plot_px;
+    const auto capacity = static_cast<int>(window_samples) + static_cast<int>(k_rate_hz);
+
+    std::printf("[Bench] montage: %d ch @ %.0f Hz, %d s window on %d px, %d visible rows\n",
+                k_channels,
+                k_rate_hz,
+                k_window_seconds,
+                k_plot_px,
+                k_visible_rows);
+
+    auto ring = std::make_unique<SampleRing>(k_channels, capacity, k_rate_hz, RING_LAYOUT, RING_TILE_SAMPLES);
+    auto average = std::make_unique<SampleRing>(1, capacity, k_rate_hz, RING_LAYOUT, RING_TILE_SAMPLES);
+    std::vector<int> averaged(static_cast<size_t>(k_channels));
+    for (int c = 0; c < k_channels; ++c)
+    {
+        averaged[c] = c;
+    }
+    dsp::AverageReference reference;
+    reference.configure(averaged, average.get());
+    ring->set_stage(&reference);
+
+    // Producer side: the common average of every channel, per 1 ms packet
+    uint32_t state = 0x2545F491u;
+    const double total = static_cast<double>(k_packet_frames) * k_packets * k_channels;
+    double seconds = time_best_of(k_repeats,
+                                  [&]
+                                  {
+                                      for (int p = 0; p < k_packets; ++p)
+                                      {
+                                          push_noise(*ring, k_packet_frames, state);
+                                      }
+                                  });
+    ring->set_stage(nullptr);
+    const double with_average = seconds;
+    seconds = time_best_of(k_repeats,
+                           [&]
+                           {
+                               for (int p = 0; p < k_packets; ++p)
+                               {
+                                   push_noise(*ring, k_packet_frames, state);
+                               }
+                           });
+    report("noise -> ring, no stage", total, seconds, format.samples_per_second());
+    report("noise -> ring, average stage", total, with_average, format.samples_per_second());
+    ring->set_stage(&reference);
+
+    // Fill the window so every row reads retained samples
+    push_noise(*ring, static_cast<int>(window_samples), state);
+    auto pyramid = std::make_unique<MinMaxPyramid>(*ring);
+    pyramid->update(*ring);
+
+    const std::vector<dsp::MontageElectrode> electrodes = make_electrodes(k_channels);
+    const dsp::MontageKind kinds[] = {dsp::MontageKind::Referential,
+                                      dsp::MontageKind::CommonAverage,
+                                      dsp::MontageKind::Bipolar,
+                                      dsp::MontageKind::Laplacian};
+    std::printf("  %-6s %5s %6s   %12s   %12s   %14s\n", "", "rows", "terms", "switch", "frame", "block apply");
+
+    dsp::Montage montage;
+    std::vector<float> block(static_cast<size_t>(k_channels) * k_packet_frames);
+    for (const dsp::MontageKind kind : kinds)
+    {
+        montage.build(kind, electrodes, k_channels);
+        const int rows = std::min(k_visible_rows, montage.rows());
+
+        // Referential rows are read through the pyramid, as draw_chart does
+        const dsp::Montage* rows_from = kind == dsp::MontageKind::Referential ? nullptr : &montage;
+        std::vector<ui::SweepTrace> traces(static_cast<size_t>(rows));
+        auto prepare = [&](bool rebuild)
+        {
+            const ui::ColumnReducer reducer(*ring, pyramid.get(), rows_from, average.get());
+            const uint64_t head = ring->published();
+            const uint64_t oldest = head - std::min<uint64_t>(head, static_cast<uint64_t>(ring->capacity()));
+            for (int row = 0; row < rows; ++row)
+            {
+                if (rebuild)
+                {
+                    traces[static_cast<size_t>(row)] = ui::SweepTrace();
+                }
+                traces[static_cast<size_t>(row)].update(reducer, row, head, oldest, window_samples, samples_per_px);
+            }
+        };
+
+        // Switching montages: every visible row re-read over the whole window
+        const double rebuild = time_best_of(k_repeats, [&] { prepare(true); });
+
+        // Steady state: one display frame of new samples between updates
+        const auto frame_advance = static_cast<int>(k_rate_hz / k_target_fps);
+        double stream = 0.0;
+        for (int f = 0; f < k_streamed_frames; ++f)
+        {
+            push_noise(*ring, frame_advance, state);
+            pyramid->update(*ring);
+            stream += time_best_of(1, [&] { prepare(false); });
+        }
+        stream /= k_streamed_frames;
+
+        // Every row of one packet, the sparse matrix x sample block
+        const uint64_t first = ring->published() - k_packet_frames;
+        const double apply = time_best_of(k_repeats,
+                                          [&]
+                                          {
+                                              for (int p = 0; p < k_packets; ++p)
+                                              {
+                                                  montage.apply(*ring,
+                                                                average.get(),
+                                                                first,
+                                                                k_packet_frames,
+                                                                block.data(),
+                                                                k_packet_frames);
+                                              }
+                                          });
+        const double row_samples = static_cast<double>(montage.rows()) * k_packet_frames * k_packets;
+
+        std::printf("  %-6s %5d %6d   %9.2f ms   %9.3f ms   %8.1f M/s %4.0fx\n",
+                    dsp::montage_to_string(kind),
+                    montage.rows(),
+                    montage.terms(),
+                    rebuild * 1e3,
+                    stream * 1e3,
+                    row_samples / apply / 1e6,
+                    row_samples / apply / (montage.rows() * static_cast<double>(k_rate_hz)));
+    }
+    ring->set_stage(nullptr);
+}
+
+}  // namespace elda::bench
@@ -0,0 +1,254 @@
+#include "bench.h"
+#include "core/core.h"
+#include "core/dsp/pulse_artifact.h"
+#include "core/sample_ring.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace elda::bench
+{
+
+namespace
+{
+// In-scanner session: 64 EEG channels + one ECG lead at 5 kHz, ~1 ms packets
+constexpr int k_eeg_channels = 64;
+constexpr int k_channels = k_eeg_channels + 1;
+constexpr int k_ecg_channel = k_eeg_channels;
+constexpr float k_rate_hz = 5000.0f;
+constexpr int k_packet_frames = 5;
+constexpr double k_seconds = 60.0;
+constexpr double k_warmup_seconds = 30.0;
+constexpr double k_mean_rr_s = 0.9;       // 67 bpm
+constexpr double k_rr_jitter_s = 0.08;    // +/- uniform
+constexpr double k_match_s = 0.05;        // A detection within this of a true R-peak is a hit
+constexpr int k_repeats = 3;
+constexpr double k_pi = 3.14159265358979;
+
+struct Recording
+{
+    int frames = 0;
+    std::vector<double> peaks;     // True R-peaks (s)
+    std::vector<float> gains;      // Pulse artifact amplitude of each beat
+    std::vector<float> recorded;   // Channel-major, k_channels x frames: EEG + pulse artifact, and the ECG
+};
+
+double gaussian(double t, double centre, double width)
+{
+    const double u = (t - centre) / width;
+    return std::exp(-0.5 * u * u);
+}
+
+// Pulse artifact of one channel t seconds after an R-peak (µV): lags the R-peak by ~200 ms, ~0.6 s long
+double pulse(int channel, double t)
+{
+    if (t < 0.0 || t > 1.0)
+    {
+        return 0.0;
+    }
+    const double amplitude = (channel % 2 ? -1.0 : 1.0) * (80.0 + 80.0 * channel / k_eeg_channels);
+    return amplitude * (gaussian(t, 0.22, 0.04) - 0.7 * gaussian(t, 0.35, 0.06) + 0.3 * gaussian(t, 0.5, 0.08));
+}
+
+// ECG lead t seconds after an R-peak (mV): Q, R, S and T waves
+double heartbeat(double t)
+{
+    return -0.1 * gaussian(t, -0.02, 0.006) + 1.0 * gaussian(t, 0.0, 0.008) - 0.2 * gaussian(t, 0.02, 0.008) +
+           0.3 * gaussian(t, 0.25, 0.04);
+}
+
+// First beat whose pulse artifact can still reach time t (beats are in time order)
+size_t first_beat(const Recording& recording, size_t beat, double t)
+{
+    while (beat < recording.peaks.size() && recording.peaks[beat] + 1.0 < t)
+    {
+        ++beat;
+    }
+    return beat;
+}
+
+// Pulse artifact of a channel at time t, summed over the beats from `beat` on
+double artifact_at(const Recording& recording, size_t beat, int channel, double t)
+{
+    double value = 0.0;
+    for (size_t b = beat; b < recording.peaks.size() && recording.peaks[b] <= t; ++b)
+    {
+        value += recording.gains[b] * pulse(channel, t - recording.peaks[b]);
+    }
+    return value;
+}
+
+// EEG sample without the artifact: alpha plus uniform noise (µV)
+float clean_eeg(int channel, int n, uint32_t& state)
+{
+    const double t = n / static_cast<double>(k_rate_hz);
+    return static_cast<float>(10.0 * std::sin(2.0 * k_pi * 10.0 * t + channel) + uniform_noise(state, 20.0f));
+}
+
+Recording make_recording()
+{
+    Recording recording;
+    recording.frames = static_cast<int>(k_seconds * k_rate_hz);
+    uint32_t jitter = 0x9E3779B9u;
+    double peak = 0.5;
+    while (peak < k_seconds)
+    {
+        jitter = jitter * 1664525u + 1013904223u;
+        const double u = static_cast<double>(jitter >> 8) / 16777216.0;
+        recording.peaks.push_back(peak);
+        recording.gains.push_back(static_cast<float>(0.9 + 0.2 * u));
+        peak += k_mean_rr_s + k_rr_jitter_s * (2.0 * u - 1.0);
+    }
+
+    const auto frames = static_cast<size_t>(recording.frames);
+    recording.recorded.resize(k_channels * frames);
+    uint32_t state = 0x2545F491u;
+    size_t beat = 0;
+    for (int n = 0; n < recording.frames; ++n)
+    {
+        const double t = n / static_cast<double>(k_rate_hz);
+        beat = first_beat(recording, beat, t);
+        double ecg = 0.2 * std::sin(2.0 * k_pi * 0.2 * t);  // Baseline wander
+        for (size_t b = beat; b < recording.peaks.size() && recording.peaks[b] < t + 0.1; ++b)
+        {
+            ecg += heartbeat(t - recording.peaks[b]);
+        }
+        recording.recorded[k_ecg_channel * frames + n] = static_cast<float>(ecg);
+        for (int c = 0; c < k_eeg_channels; ++c)
+        {
+            recording.recorded[c * frames + n] =
+                clean_eeg(c, n, state) + static_cast<float>(artifact_at(recording, beat, c, t));
+        }
+    }
+    return recording;
+}
+
+// Hits and false detections of the R-peak detector, and its mean offset from the true R-peak
+void detection_check(const Recording& recording)
+{
+    const auto frames = static_cast<size_t>(recording.frames);
+    dsp::RPeakDetector detector;
+    detector.configure(k_rate_hz);
+    std::vector<double> detected;
+    for (int n = 0; n < recording.frames; ++n)
+    {
+        uint64_t peak = 0;
+        if (detector.push(static_cast<uint64_t>(n), recording.recorded[k_ecg_channel * frames + n], peak))
+        {
+            detected.push_back(static_cast<double>(peak) / k_rate_hz);
+        }
+    }
+
+    int hits = 0;
+    int expected = 0;
+    double offset = 0.0;
+    for (const double peak : recording.peaks)
+    {
+        if (peak < 2.5)
+        {
+            continue;  // Learning the QRS level
+        }
+        ++expected;
+        const auto it = std::lower_bound(detected.begin(), detected.end(), peak - k_match_s);
+        if (it != detected.end() && *it <= peak + k_match_s)
+        {
+            ++hits;
+            offset += *it - peak;
+        }
+    }
+    const auto counted = std::count_if(detected.begin(), detected.end(), [](double t) { return t >= 2.5; });
+    std::printf("  R-peaks: %d of %d found, %d false, R-peak located %+.1f ms from the true one on average\n",
+                hits,
+                expected,
+                static_cast<int>(counted) - hits,
+                hits > 0 ? offset / hits * 1e3 : 0.0);
+}
+
+// Correct the recording in packets; artifact left after the warm-up, relative to the artifact
+double residual_ratio(const Recording& recording, dsp::PulseArtifactCorrector& corrector)
+{
+    std::vector<float> data = recording.recorded;
+    const auto frames = static_cast<size_t>(recording.frames);
+    for (int first = 0; first < recording.frames; first += k_packet_frames)
+    {
+        const int count = std::min(k_packet_frames, recording.frames - first);
+        corrector.process(static_cast<uint64_t>(first), data.data() + first, frames, count);
+    }
+
+    const auto from = static_cast<size_t>(k_warmup_seconds * k_rate_hz);
+    double residual = 0.0;
+    double before = 0.0;
+    for (int c = 0; c < k_eeg_channels; ++c)
+    {
+        size_t beat = 0;
+        for (size_t n = from; n < frames; ++n)
+        {
+            const double t = n / static_cast<double>(k_rate_hz);
+            beat = first_beat(recording, beat, t);
+            const double artifact = artifact_at(recording, beat, c, t);
+            const double error = data[c * frames + n] - (recording.recorded[c * frames + n] - artifact);
+            residual += error * error;
+            before += artifact * artifact;
+        }
+    }
+    return std::sqrt(residual / before);
+}
+}  // namespace
+
+void run_pulse_benchmarks()
+{
+    std::printf("[Bench] pulse artifact: %d EEG ch + ECG @ %.0f Hz, %.0f s at %.0f bpm, %d-frame packets\n",
+                k_eeg_channels,
+                k_rate_hz,
+                k_seconds,
+                60.0 / k_mean_rr_s,
+                k_packet_frames);
+
+    const Recording recording = make_recording();
+    detection_check(recording);
+
+    std::vector<int> channels(k_eeg_channels);
+    for (int c = 0; c < k_eeg_channels; ++c)
+    {
+        channels[c] = c;
+    }
+    dsp::PulseCorrectionSpec spec;
+    spec.enabled = true;
+    spec.ecg_channel = k_ecg_channel;
+    dsp::PulseArtifactCorrector corrector;
+    corrector.configure(spec, channels, k_rate_hz);
+    const double ratio = residual_ratio(recording, corrector);
+    dsp::PulseCorrectionStats stats = corrector.stats();
+    std::printf("  residual %.3f of the artifact (%.1f dB), %llu beats at %.0f bpm, detection delay %.1f ms "
+                "(max %.1f)\n",
+                ratio,
+                20.0 * std::log10(ratio),
+                static_cast<unsigned long long>(stats.beats),
+                stats.heart_rate_bpm,
+                stats.last_delay_ms,
+                stats.max_delay_ms);
+
+    // Throughput: the recording pushed through the ring with and without the stage
+    SampleRing ring(k_channels, static_cast<int>(k_rate_hz) * 5, k_rate_hz, RING_LAYOUT, RING_TILE_SAMPLES);
+    auto stream = [&] { push_planar_packets(ring, recording.recorded.data(), recording.frames, k_packet_frames); };
+
+    const double total = static_cast<double>(recording.frames) * k_channels;
+    const double required = static_cast<double>(k_rate_hz) * k_channels;
+    report("recording -> ring, no stage", total, time_best_of(k_repeats, stream), required);
+
+    const double corrected = time_with_stage(
+        k_repeats, ring, corrector, [&] { corrector.configure(spec, channels, k_rate_hz); }, stream);
+    report("recording -> ring, pulse stage", total, corrected, required);
+
+    // Per-beat template work is one burst on the producer thread
+    stats = corrector.stats();
+    std::printf("  template update per beat: mean %.2f ms, max %.2f ms (%d ch x %d samples, %d-beat window)\n",
+                stats.mean_update_ms,
+                stats.max_update_ms,
+                k_eeg_channels,
+                corrector.template_length(),
+                corrector.beats());
+}
+
+}  // namespace elda::bench
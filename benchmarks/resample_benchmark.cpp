@@ -0,0 +1,167 @@
+#include "bench.h"
+#include "core/core.h"
+#include "core/dsp/polyphase_resampler.h"
+#include "core/minmax_pyramid.h"
+#include "core/sample_ring.h"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+namespace elda::bench
+{
+
+namespace
+{
+// NVX136 at its top rate, viewed at 500 Hz and stored at 1 kHz, 1 ms packets
+constexpr int k_channels = 136;
+constexpr float k_rate_hz = 25000.0f;
+constexpr float k_display_hz = 500.0f;
+constexpr float k_storage_hz = 1000.0f;
+constexpr int k_packet_frames = 25;
+constexpr double k_seconds = 4.0;
+constexpr int k_repeats = 3;
+constexpr double k_pi = 3.14159265358979;
+
+// Display and storage streams off one ring, as the acquisition thread runs them
+struct Streams final : IRingStage
+{
+    dsp::PolyphaseResampler display;
+    dsp::PolyphaseResampler storage;
+
+    void process(uint64_t first, float* data, size_t channel_stride, int count) override
+    {
+        display.process(first, data, channel_stride, count);
+        storage.process(first, data, channel_stride, count);
+    }
+};
+
+// Resample a tone of one channel in packets; RMS of the output after the warm-up, against a tone at the output times
+double tone_rms(double input_hz, double output_hz, double tone_hz, double reference_hz, bool error)
+{
+    const int frames = static_cast<int>(input_hz * 2.0);
+    std::vector<float> tone(static_cast<size_t>(frames));
+    for (int n = 0; n < frames; ++n)
+    {
+        tone[n] = static_cast<float>(std::sin(2.0 * k_pi * tone_hz * n / input_hz));
+    }
+
+    SampleRing target(1, static_cast<int>(output_hz * 2.0), output_hz, RING_LAYOUT, RING_TILE_SAMPLES);
+    dsp::PolyphaseResampler resampler;
+    resampler.configure(1, input_hz, &target);
+    for (int first = 0; first < frames; first += k_packet_frames)
+    {
+        const int count = std::min(k_packet_frames, frames - first);
+        resampler.process(static_cast<uint64_t>(first), tone.data() + first, static_cast<size_t>(frames), count);
+    }
+
+    // Skip the first half second: the history was primed with the first sample
+    const uint64_t published = target.published();
+    double sum = 0.0;
+    int counted = 0;
+    for (uint64_t j = static_cast<uint64_t>(output_hz * 0.5); j < published; ++j)
+    {
+        const double expected = error ? std::sin(2.0 * k_pi * reference_hz * static_cast<double>(j) / output_hz) : 0.0;
+        const double difference = target.sample(0, target.slot_of(j)) - expected;
+        sum += difference * difference;
+        ++counted;
+    }
+    return std::sqrt(sum / std::max(1, counted)) * std::sqrt(2.0);  // Relative to the tone's amplitude
+}
+
+void quality_check(double input_hz, double output_hz)
+{
+    const std::shared_ptr<const dsp::ResampleDesign> design = dsp::ResampleDesign::plan(input_hz, output_hz);
+    const double passband = tone_rms(input_hz, output_hz, 0.3 * output_hz, 0.3 * output_hz, true);
+    const double alias = tone_rms(input_hz, output_hz, 0.75 * output_hz, 0.0, false);
+    std::printf("  %5.0f -> %4.0f Hz (%d/%d, %4d taps/phase): passband error %6.1f dB, alias at 0.75 fs %6.1f dB, "
+                "lag %.1f ms\n",
+                input_hz,
+                output_hz,
+                design->up(),
+                design->down(),
+                design->taps(),
+                20.0 * std::log10(passband),
+                20.0 * std::log10(alias),
+                1e3 * design->delay() / (design->up() * input_hz));
+}
+}  // namespace
+
+void run_resample_benchmarks()
+{
+    std::printf("[Bench] resampling: %d ch @ %.0f Hz -> %.0f Hz display + %.0f Hz storage, %d-frame packets\n",
+                k_channels,
+                k_rate_hz,
+                k_display_hz,
+                k_storage_hz,
+                k_packet_frames);
+
+    // Quality: a passband tone against the ideal samples at the output times (gain, ripple and alignment), and
+    // the tone that would alias onto 0.25 x the output rate
+    quality_check(25000.0, 500.0);
+    quality_check(25000.0, 1000.0);
+    quality_check(5000.0, 2000.0);
+    quality_check(1000.0, 250.0);
+
+    // Throughput: a recording pushed through the ring with and without the streams
+    const int frames = static_cast<int>(k_seconds * k_rate_hz);
+    std::vector<float> recording(static_cast<size_t>(k_channels) * frames);
+    uint32_t state = 0x2545F491u;
+    for (float& sample : recording)
+    {
+        sample = uniform_noise(state);
+    }
+
+    const int capacity = static_cast<int>(k_rate_hz * k_seconds) + k_packet_frames;
+    auto ring = std::make_unique<SampleRing>(k_channels, capacity, k_rate_hz, RING_LAYOUT, RING_TILE_SAMPLES);
+    auto display_ring = std::make_unique<SampleRing>(
+        k_channels, static_cast<int>(k_display_hz * k_seconds), k_display_hz, RING_LAYOUT, RING_TILE_SAMPLES);
+    auto storage_ring = std::make_unique<SampleRing>(
+        k_channels, static_cast<int>(k_storage_hz * k_seconds), k_storage_hz, RING_LAYOUT, RING_TILE_SAMPLES);
+    auto stream = [&] { push_planar_packets(*ring, recording.data(), frames, k_packet_frames); };
+
+    const double total = static_cast<double>(frames) * k_channels;
+    const double required = static_cast<double>(k_rate_hz) * k_channels;
+    report("recording -> ring, no stage", total, time_best_of(k_repeats, stream), required);
+
+    Streams streams;
+    const char* names[] = {"recording -> ring + display", "recording -> ring + display + storage"};
+    for (int mode = 0; mode < 2; ++mode)
+    {
+        auto setup = [&]
+        {
+            display_ring->reset();
+            storage_ring->reset();
+            streams.display.configure(k_channels, k_rate_hz, display_ring.get());
+            streams.storage.configure(k_channels, k_rate_hz, mode == 1 ? storage_ring.get() : nullptr);
+        };
+        const double best = time_with_stage(k_repeats, *ring, streams, setup, stream);
+        report(names[mode], total, best, required);
+    }
+
+    // Downstream: the chart's min/max pyramid over the same seconds, from the ADC-rate ring and the display ring
+    MinMaxPyramid raw_pyramid(*ring);
+    MinMaxPyramid display_pyramid(*display_ring);
+    const double raw = time_best_of(k_repeats,
+                                    [&]
+                                    {
+                                        raw_pyramid.reset();
+                                        raw_pyramid.update(*ring);
+                                    });
+    const double display = time_best_of(k_repeats,
+                                        [&]
+                                        {
+                                            display_pyramid.reset();
+                                            display_pyramid.update(*display_ring);
+                                        });
+    std::printf("  pyramid build over %.0f s: %.2f ms from the %.0f Hz ring, %.3f ms from the %.0f Hz stream (%.0fx)\n",
+                k_seconds,
+                raw * 1e3,
+                k_rate_hz,
+                display * 1e3,
+                k_display_hz,
+                raw / display);
+}
+
+}  // namespace elda::bench
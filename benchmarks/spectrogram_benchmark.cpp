@@ -0,0 +1,141 @@
+#include "bench.h"
+#include "core/core.h"
+#include "core/dsp/real_fft.h"
+#include "core/dsp/spectrogram.h"
+#include "core/sample_ring.h"
+#include "core/worker_pool.h"
+
+#include <memory>
+#include <vector>
+
+namespace elda::bench
+{
+
+namespace
+{
+// Spectrogram view of a 64-channel montage over a 10 s window, as draw_spectrogram configures it
+constexpr int k_channels = 64;
+constexpr float k_rates_hz[] = {1000.0f, 5000.0f};
+constexpr int k_window_seconds = 10;
+constexpr double k_max_hz = 100.0;
+constexpr int64_t k_frame_budget = 1 << 18;  // Same per-UI-frame cap as draw_spectrogram
+constexpr double k_target_fps = 60.0;
+constexpr int k_repeats = 5;
+constexpr int k_streamed_frames = 600;
+constexpr int k_fft_sizes[] = {1024, 8192};
+
+void run_fft_throughput()
+{
+    for (int size : k_fft_sizes)
+    {
+        const std::shared_ptr<const dsp::RealFft> fft = dsp::RealFft::plan(size);
+        std::vector<float> input(static_cast<size_t>(size));
+        std::vector<float> power(static_cast<size_t>(fft->bins()));
+        uint32_t state = 0x1234567u;
+        for (float& x : input)
+        {
+            state = state * 1664525u + 1013904223u;
+            x = static_cast<float>(state >> 8) * (1.0f / 16777216.0f) - 0.5f;
+        }
+
+        dsp::RealFft::Workspace workspace;
+        const int transforms = (1 << 22) / size;
+        const double seconds = time_best_of(k_repeats,
+                                            [&]
+                                            {
+                                                for (int t = 0; t < transforms; ++t)
+                                                {
+                                                    fft->power(input.data(), power.data(), fft->bins(), workspace);
+                                                }
+                                            });
+        char name[64];
+        std::snprintf(name, sizeof(name), "real FFT %d points (%.2f us each)", size, seconds / transforms * 1e6);
+        report(name, static_cast<double>(transforms) * size, seconds, 0.0);
+    }
+}
+
+void run_stream(float rate_hz, WorkerPool& pool)
+{
+    const dsp::SpectrogramShape base = dsp::SpectrogramShape::for_rate(rate_hz, k_max_hz, 1);
+    dsp::SpectrogramShape shape = base;
+    shape.history = (k_window_seconds * static_cast<int>(rate_hz) + shape.hop - 1) / shape.hop;
+
+    const int capacity = static_cast<int>(rate_hz) * (k_window_seconds + 5);
+    auto ring = std::make_unique<SampleRing>(k_channels, capacity, rate_hz, RING_LAYOUT, RING_TILE_SAMPLES);
+    uint32_t state = 0x2545F491u;
+    push_noise(*ring, static_cast<int>(rate_hz) * k_window_seconds, state);
+
+    std::vector<int> channels(static_cast<size_t>(k_channels));
+    for (int c = 0; c < k_channels; ++c)
+    {
+        channels[c] = c;
+    }
+
+    std::printf("  %5.0f Hz: %d-point FFT, hop %d, %d bins, %d columns\n",
+                rate_hz,
+                shape.fft_size,
+                shape.hop,
+                shape.bins,
+                shape.history);
+
+    // Whole window at once (view opened after minutes of monitoring, no budget)
+    dsp::StreamingSpectrogram spectrogram;
+    const double backfill = time_best_of(k_repeats,
+                                         [&]
+                                         {
+                                             spectrogram.configure(channels, rate_hz, shape);
+                                             spectrogram.advance(*ring, ring->published(), INT64_MAX, pool);
+                                         });
+    const double backfill_samples = static_cast<double>(shape.history) * shape.fft_size * k_channels;
+    const double required = static_cast<double>(k_channels) * rate_hz * shape.fft_size / shape.hop;
+    report("backfill (whole window, one call)", backfill_samples, backfill, required);
+    std::printf("  %-40s %10.2f ms for %d columns\n", "", backfill * 1e3, shape.history);
+
+    // Live: one UI frame of new samples between budgeted calls
+    spectrogram.configure(channels, rate_hz, shape);
+    while (spectrogram.advance(*ring, ring->published(), k_frame_budget, pool) > 0)
+    {
+    }
+    const auto frame_advance = static_cast<int>(rate_hz / k_target_fps);
+    double total = 0.0;
+    double worst = 0.0;
+    int frames = 0;
+    for (int f = 0; f < k_streamed_frames; ++f)
+    {
+        push_noise(*ring, frame_advance, state);
+        const double seconds = time_best_of(
+            1, [&] { frames += spectrogram.advance(*ring, ring->published(), k_frame_budget, pool); });
+        total += seconds;
+        worst = std::max(worst, seconds);
+    }
+    report("live (budgeted per UI frame)",
+           static_cast<double>(frames) * shape.fft_size * k_channels,
+           total,
+           required);
+    std::printf("  %-40s %10.3f ms/frame mean, %.3f ms worst, %d columns in %d frames\n",
+                "",
+                total / k_streamed_frames * 1e3,
+                worst * 1e3,
+                frames,
+                k_streamed_frames);
+}
+}  // namespace
+
+void run_spectrogram_benchmarks()
+{
+    std::printf("[Bench] spectrogram: real FFT throughput\n");
+    run_fft_throughput();
+
+    WorkerPool pool(WorkerPool::default_workers());
+    std::printf("[Bench] spectrogram: %d ch, %d s window, 0-%.0f Hz, %d pool workers + caller\n",
+                k_channels,
+                k_window_seconds,
+                k_max_hz,
+                pool.workers());
+    for (float rate_hz : k_rates_hz)
+    {
+        run_stream(rate_hz, pool);
+    }
+}
+
+}  // namespace elda::bench
@@ -0,0 +1,156 @@
+#include "bench.h"
+#include "core/core.h"
+#include "core/dsp/spectrogram.h"
+#include "core/dsp/spherical_spline.h"
+#include "core/sample_ring.h"
+#include "core/worker_pool.h"
+
+#include <cmath>
+#include <memory>
+#include <vector>
+
+namespace elda::bench
+{
+
+namespace
+{
+// Full NVX136 cap mapped on the 64 x 64 texel grid TopomapRenderer uses, refreshed at >= 10 Hz
+constexpr int k_electrodes = MAX_CHANNELS;
+constexpr int k_grid = 64;
+constexpr double k_target_hz = 10.0;
+constexpr float k_rates_hz[] = {1000.0f, 5000.0f};
+constexpr double k_max_hz = 45.0;
+constexpr int k_welch_frames = 8;
+constexpr int k_repeats = 5;
+constexpr double k_half_pi = 1.5707963267948966192313216916398;
+
+dsp::SpherePoint disk_to_sphere(double ux, double uy)
+{
+    const double r = std::sqrt(ux * ux + uy * uy);
+    if (r <= 0.0)
+    {
+        return {};
+    }
+    const double s = std::sin(r * k_half_pi) / r;
+    return {ux * s, uy * s, std::cos(r * k_half_pi)};
+}
+
+// Concentric rings of electrodes out to just inside the outline, like a dense cap
+std::vector<dsp::SpherePoint> cap_layout()
+{
+    std::vector<dsp::SpherePoint> electrodes;
+    for (int ring = 0; static_cast<int>(electrodes.size()) < k_electrodes; ++ring)
+    {
+        const int count = ring == 0 ? 1 : 8 * ring;
+        for (int k = 0; k < count && static_cast<int>(electrodes.size()) < k_electrodes; ++k)
+        {
+            const double angle = 4.0 * k_half_pi * k / count;
+            electrodes.push_back(disk_to_sphere(0.16 * ring * std::cos(angle), 0.16 * ring * std::sin(angle)));
+        }
+    }
+    return electrodes;
+}
+
+std::vector<dsp::SpherePoint> grid_targets()
+{
+    std::vector<dsp::SpherePoint> targets;
+    for (int j = 0; j < k_grid; ++j)
+    {
+        for (int i = 0; i < k_grid; ++i)
+        {
+            const double ux = (i + 0.5) * 2.0 / k_grid - 1.0;
+            const double uy = (j + 0.5) * 2.0 / k_grid - 1.0;
+            if (ux * ux + uy * uy <= 1.0)
+            {
+                targets.push_back(disk_to_sphere(ux, uy));
+            }
+        }
+    }
+    return targets;
+}
+}  // namespace
+
+void run_topomap_benchmarks()
+{
+    const std::vector<dsp::SpherePoint> electrodes = cap_layout();
+    const std::vector<dsp::SpherePoint> targets = grid_targets();
+    std::printf("[Bench] topomap: %d electrodes -> %zu texels (%d x %d grid), %.0f Hz target\n",
+                k_electrodes,
+                targets.size(),
+                k_grid,
+                k_grid,
+                k_target_hz);
+
+    // Once per electrode layout
+    dsp::SphericalSpline spline;
+    const double build = time_best_of(k_repeats, [&] { spline.build(electrodes, targets); });
+    std::printf("  %-40s %10.2f ms\n", "spline matrix build (per layout)", build * 1e3);
+
+    // Every update: one matrix-vector product
+    std::vector<float> values(static_cast<size_t>(k_electrodes));
+    for (int e = 0; e < k_electrodes; ++e)
+    {
+        values[e] = static_cast<float>(electrodes[e].x * 3.0 + electrodes[e].y);
+    }
+    std::vector<float> map(targets.size());
+    const int products = 200;
+    const double interpolate = time_best_of(k_repeats,
+                                            [&]
+                                            {
+                                                for (int p = 0; p < products; ++p)
+                                                {
+                                                    spline.interpolate(values.data(), map.data());
+                                                }
+                                            }) /
+                               products;
+    std::printf("  %-40s %10.3f ms   headroom %6.0fx\n",
+                "interpolation (per update)",
+                interpolate * 1e3,
+                1.0 / (interpolate * k_target_hz));
+
+    // Band power of every electrode: the frames that completed since the previous update, then the band sums
+    WorkerPool pool(WorkerPool::default_workers());
+    for (float rate_hz : k_rates_hz)
+    {
+        const dsp::SpectrogramShape shape = dsp::SpectrogramShape::for_rate(rate_hz, k_max_hz, k_welch_frames);
+        auto ring = std::make_unique<SampleRing>(
+            k_electrodes, static_cast<int>(rate_hz) * 4, rate_hz, RING_LAYOUT, RING_TILE_SAMPLES);
+        uint32_t state = 0x2545F491u;
+        push_noise(*ring, static_cast<int>(rate_hz) * 2, state);
+
+        std::vector<int> channels(static_cast<size_t>(k_electrodes));
+        for (int c = 0; c < k_electrodes; ++c)
+        {
+            channels[c] = c;
+        }
+        dsp::StreamingSpectrogram spectrogram;
+        spectrogram.configure(channels, rate_hz, shape);
+        spectrogram.advance(*ring, ring->published(), INT64_MAX, pool);
+
+        const auto update_samples = static_cast<int>(rate_hz / k_target_hz);
+        const int updates = 20;
+        double total = 0.0;
+        for (int u = 0; u < updates; ++u)
+        {
+            push_noise(*ring, update_samples, state);
+            total += time_best_of(1,
+                                  [&]
+                                  {
+                                      spectrogram.advance(*ring, ring->published(), INT64_MAX, pool);
+                                      for (int e = 0; e < k_electrodes; ++e)
+                                      {
+                                          const double alpha = spectrogram.band_power(e, 8.0, 13.0, k_welch_frames);
+                                          values[e] = static_cast<float>(alpha);
+                                      }
+                                  });
+        }
+        char name[64];
+        std::snprintf(name, sizeof(name), "band power %.0f Hz (%d-pt FFT)", rate_hz, shape.fft_size);
+        std::printf("  %-40s %10.3f ms   headroom %6.0fx\n",
+                    name,
+                    total / updates * 1e3,
+                    updates / (total * k_target_hz));
+    }
+}
+
+}  // namespace elda::bench
@@ -0,0 +1,351 @@
+#include "acquisition_thread.h"
+
+#include "core/atomic_max.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+namespace elda::acquisition
+{
+
+namespace
+{
+// After this many missed ticks the scheduler re-anchors instead of spinning to catch up on wake-ups.
+// Samples are never dropped: each tick drains everything the source has ready.
+constexpr int k_resync_after_ticks = 100;
+
+// Read granularity; at least one full NVX packet
+constexpr int k_min_read_frames = 1024;
+}  // namespace
+
+// ===== CONSTRUCTOR / DESTRUCTOR =====
+
+AcquisitionThread::AcquisitionThread(AppState& state) : state_(state)
+{
+}
+
+AcquisitionThread::~AcquisitionThread()
+{
+    stop();
+}
+
+// ===== LIFECYCLE =====
+
+void AcquisitionThread::set_source(std::unique_ptr<IAmplifierSource> source)
+{
+    if (running_.load(std::memory_order_acquire))
+    {
+        return;
+    }
+    source_ = std::move(source);
+    if (source_)
+    {
+        source_->set_noise_scale(noise_scale_);
+    }
+}
+
+void AcquisitionThread::set_calibration(const std::vector<ChannelCalibration>& calibration)
+{
+    if (running_.load(std::memory_order_acquire) || !source_)
+    {
+        return;
+    }
+    source_->set_calibration(calibration);
+}
+
+void AcquisitionThread::set_filters(const std::vector<dsp::FilterSpec>& filters)
+{
+    if (running_.load(std::memory_order_acquire))
+    {
+        return;
+    }
+    filter_specs_ = filters;
+}
+
+void AcquisitionThread::set_average_channels(const std::vector<int>& channels)
+{
+    if (running_.load(std::memory_order_acquire))
+    {
+        return;
+    }
+    average_channels_ = channels;
+}
+
+void AcquisitionThread::set_gradient_correction(const dsp::GradientCorrectionSpec& spec)
+{
+    if (running_.load(std::memory_order_acquire))
+    {
+        return;
+    }
+    gradient_spec_ = spec;
+}
+
+void AcquisitionThread::set_pulse_correction(const dsp::PulseCorrectionSpec& spec, const std::vector<int>& channels)
+{
+    if (running_.load(std::memory_order_acquire))
+    {
+        return;
+    }
+    pulse_spec_ = spec;
+    pulse_channels_ = channels;
+}
+
+SourceResult AcquisitionThread::start()
+{
+    if (running_.load(std::memory_order_acquire))
+    {
+        return SourceResult::success();
+    }
+    if (!source_)
+    {
+        return SourceResult::failure("No amplifier source");
+    }
+
+    AcquisitionFormat format = state_.acquisition_format;
+    format.channels = state_.ring.channels();
+    format.sample_rate_hz = static_cast<float>(state_.ring.sample_rate_hz());
+
+    SourceResult result = source_->open();
+    if (result)
+    {
+        result = source_->configure(format);
+    }
+    if (result)
+    {
+        result = source_->start();
+    }
+    if (!result)
+    {
+        source_->close();
+        std::printf("[Acquisition] %s failed: %s\n", source_->name(), result.message.c_str());
+        return result;
+    }
+
+    samples_ingested_.store(0, std::memory_order_relaxed);
+    ticks_.store(0, std::memory_order_relaxed);
+    late_wakeups_.store(0, std::memory_order_relaxed);
+    backlogged_samples_.store(0, std::memory_order_relaxed);
+    max_backlog_.store(0, std::memory_order_relaxed);
+
+    // Cached designs: re-configuring for an unchanged montage only clears the filter state
+    filters_.configure(filter_specs_, state_.ring.sample_rate_hz());
+    std::vector<int> averaged;
+    for (const int channel : average_channels_)
+    {
+        if (channel >= 0 && channel < state_.ring.channels())
+        {
+            averaged.push_back(channel);
+        }
+    }
+    average_.configure(averaged, &state_.average_ring);
+
+    dsp::GradientCorrectionSpec gradient = gradient_spec_;
+    if (gradient.trigger_channel >= state_.ring.channels())
+    {
+        std::printf("[Acquisition] Trigger channel %d not acquired; gradient onsets follow the %.0f ms TR\n",
+                    gradient.trigger_channel + 1,
+                    gradient.tr_ms);
+        gradient.trigger_channel = -1;
+    }
+    std::vector<int> corrected(static_cast<size_t>(state_.ring.channels()));
+    for (int channel = 0; channel < state_.ring.channels(); ++channel)
+    {
+        corrected[channel] = channel;
+    }
+    gradient_.configure(gradient, corrected, state_.ring.sample_rate_hz());
+
+    dsp::PulseCorrectionSpec pulse = pulse_spec_;
+    if (pulse.ecg_channel >= state_.ring.channels())
+    {
+        pulse.ecg_channel = -1;
+    }
+    corrected.clear();
+    for (const int channel : pulse_channels_)
+    {
+        if (channel >= 0 && channel < state_.ring.channels())
+        {
+            corrected.push_back(channel);
+        }
+    }
+    pulse_.configure(pulse, corrected, state_.ring.sample_rate_hz());
+
+    // Rings at the stream rates were shaped with the ring by AppStateManager::set_monitoring()
+    const bool display = state_.acquisition_format.resamples_display();
+    display_.configure(format.channels, format.sample_rate_hz, display ? &state_.display_ring : nullptr);
+    display_average_.configure(1, format.sample_rate_hz, display ? &state_.display_average_ring : nullptr);
+    state_.average_ring.set_stage(display_average_.active() ? &display_average_ : nullptr);
+    storage_.configure(format.channels,
+                       format.sample_rate_hz,
+                       state_.acquisition_format.resamples_storage() ? &state_.storage_ring : nullptr);
+    auto log_stream = [](const char* name, const dsp::PolyphaseResampler& stream)
+    {
+        if (const dsp::ResampleDesign* design = stream.design())
+        {
+            std::printf("[Acquisition] %s stream: %d/%d of the device rate, %d taps per phase\n",
+                        name,
+                        design->up(),
+                        design->down(),
+                        design->taps());
+        }
+    };
+    log_stream("Display", display_);
+    log_stream("Storage", storage_);
+    state_.ring.set_stage(this);
+
+    running_.store(true, std::memory_order_release);
+    thread_ = std::thread(&AcquisitionThread::run, this);
+
+    std::printf("[Acquisition] Started %s (%.1f Hz, %d channels)\n",
+                source_->name(),
+                state_.ring.sample_rate_hz(),
+                state_.ring.channels());
+    return SourceResult::success();
+}
+
+void AcquisitionThread::stop()
+{
+    running_.store(false, std::memory_order_release);
+    if (!thread_.joinable())
+    {
+        return;
+    }
+    thread_.join();
+    source_->stop();
+    source_->close();
+    state_.ring.set_stage(nullptr);
+    state_.average_ring.set_stage(nullptr);
+
+    const AcquisitionStats stats = get_stats();
+    std::printf("[Acquisition] Stopped: %llu samples, %llu late wake-ups, %llu backlogged (max burst %u), "
+                "%llu packets lost, %llu frames concealed\n",
+                static_cast<unsigned long long>(stats.samples_ingested),
+                static_cast<unsigned long long>(stats.late_wakeups),
+                static_cast<unsigned long long>(stats.backlogged_samples),
+                stats.max_backlog,
+                static_cast<unsigned long long>(stats.link.packets_lost),
+                static_cast<unsigned long long>(stats.link.frames_concealed));
+    if (gradient_.active())
+    {
+        std::printf("[Acquisition] Gradient correction: %llu volumes, template update %.2f ms mean, %.2f ms max\n",
+                    static_cast<unsigned long long>(stats.gradient.volumes),
+                    stats.gradient.mean_update_ms,
+                    stats.gradient.max_update_ms);
+    }
+    if (pulse_.active())
+    {
+        std::printf("[Acquisition] Pulse correction: %llu beats, detection delay %.0f ms max, "
+                    "template update %.2f ms mean, %.2f ms max\n",
+                    static_cast<unsigned long long>(stats.pulse.beats),
+                    stats.pulse.max_delay_ms,
+                    stats.pulse.mean_update_ms,
+                    stats.pulse.max_update_ms);
+    }
+}
+
+AcquisitionStats AcquisitionThread::get_stats() const
+{
+    AcquisitionStats stats;
+    stats.samples_ingested = samples_ingested_.load(std::memory_order_relaxed);
+    stats.ticks = ticks_.load(std::memory_order_relaxed);
+    stats.late_wakeups = late_wakeups_.load(std::memory_order_relaxed);
+    stats.backlogged_samples = backlogged_samples_.load(std::memory_order_relaxed);
+    stats.max_backlog = max_backlog_.load(std::memory_order_relaxed);
+    if (source_)
+    {
+        stats.link = source_->get_stats();
+    }
+    stats.gradient = gradient_.stats();
+    stats.pulse = pulse_.stats();
+    return stats;
+}
+
+// ===== THREAD BODY =====
+
+void AcquisitionThread::process(uint64_t first, float* data, size_t channel_stride, int count)
+{
+    if (gradient_.active())
+    {
+        gradient_.process(first, data, channel_stride, count);
+    }
+    if (filters_.active())
+    {
+        filters_.process(first, data, channel_stride, count);
+    }
+    if (pulse_.active())
+    {
+        pulse_.process(first, data, channel_stride, count);
+    }
+    average_.process(first, data, channel_stride, count);  // Feeds display_average_ through the average ring
+    if (display_.active())
+    {
+        display_.process(first, data, channel_stride, count);
+    }
+    if (storage_.active())
+    {
+        storage_.process(first, data, channel_stride, count);
+    }
+}
+
+void AcquisitionThread::run()
+{
+    using clock = std::chrono::steady_clock;
+
+    // Session format was applied to the ring before start() and stays fixed while running
+    const double sample_rate_hz = state_.ring.sample_rate_hz();
+
+    const double samples_per_tick = sample_rate_hz * std::chrono::duration<double>(kTickPeriod).count();
+    const int nominal_per_tick = std::max(1, static_cast<int>(std::ceil(samples_per_tick)));
+
+    // A burst larger than this is drained in several reads
+    const int max_frames = std::max(k_min_read_frames, nominal_per_tick * 16);
+
+    auto next_wake = clock::now();
+
+    while (running_.load(std::memory_order_acquire))
+    {
+        next_wake += kTickPeriod;
+        std::this_thread::sleep_until(next_wake);
+
+        const auto woke = clock::now();
+        ticks_.fetch_add(1, std::memory_order_relaxed);
+
+        const auto lateness = woke - next_wake;
+        if (lateness > kTickPeriod)
+        {
+            late_wakeups_.fetch_add(1, std::memory_order_relaxed);
+            if (lateness > kTickPeriod * k_resync_after_ticks)
+            {
+                next_wake = woke;
+            }
+        }
+
+        int due = 0;
+        int frames = 0;
+        while ((frames = source_->read_into(state_.ring, max_frames)) > 0)
+        {
+            due += frames;
+        }
+        if (due <= 0)
+        {
+            continue;
+        }
+        state_.pyramid.update(state_.ring);
+        if (display_.active())
+        {
+            state_.display_pyramid.update(state_.display_ring);
+        }
+
+        if (due > nominal_per_tick)
+        {
+            const auto backlog = static_cast<uint32_t>(due - nominal_per_tick);
+            backlogged_samples_.fetch_add(backlog, std::memory_order_relaxed);
+            update_max(max_backlog_, backlog);
+        }
+
+        samples_ingested_.fetch_add(static_cast<uint64_t>(due), std::memory_order_relaxed);
+    }
+}
+
+}  // namespace elda::acquisition
@@ -0,0 +1,181 @@
+#pragma once
+
+#include "amplifier_source.h"
+#include "core/core.h"
+#include "core/dsp/gradient_artifact.h"
+#include "core/dsp/iir_filter_bank.h"
+#include "core/dsp/montage.h"
+#include "core/dsp/polyphase_resampler.h"
+#include "core/dsp/pulse_artifact.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace elda::acquisition
+{
+
+/**
+ * Snapshot of the acquisition counters.
+ * All values are cumulative since the last start().
+ */
+struct AcquisitionStats
+{
+    uint64_t samples_ingested = 0;    // Samples pushed into the ring
+    uint64_t ticks = 0;               // Scheduler wake-ups
+    uint64_t late_wakeups = 0;        // Wake-ups that happened more than one tick after their deadline
+    uint64_t backlogged_samples = 0;  // Samples that were due beyond one tick's nominal count
+    uint32_t max_backlog = 0;         // Largest single catch-up burst (samples)
+    SourceStats link;                 // Counters of the amplifier link (packets, loss, concealment)
+    dsp::GradientCorrectionStats gradient;  // MRI gradient artifact correction (zeros when off)
+    dsp::PulseCorrectionStats pulse;        // Ballistocardiogram correction (zeros when off)
+};
+
+/**
+ * AcquisitionThread - ingests samples at the device rate on its own thread
+ *
+ * Runs independently of the ImGui render loop so UI hitches (popups, storage
+ * writes, vsync) no longer delay acquisition. The thread wakes every tick,
+ * drains everything the IAmplifierSource has ready and pushes it into
+ * AppState::ring. This thread is the ring's only producer.
+ *
+ * Channel count and rate are read from the ring at start(), so the session
+ * format must be applied to the ring before the thread starts. start()
+ * opens, configures and starts the source; stop() stops and closes it.
+ * Per-channel filters run as the ring's producer stage, so every reader
+ * (chart, pyramid, spectrogram) sees the filtered signal. In MRI sessions the
+ * gradient artifact is subtracted first, so the filters see the cleaned signal,
+ * and the pulse artifact after them, on the filtered EEG. The same stage then
+ * writes the common average of the EEG channels into AppState::average_ring,
+ * the reference input of the average montage. Last, when the session format
+ * asks for them, the ring and the average are resampled into the display
+ * stream (AppState::display_ring / display_average_ring, the chart's input)
+ * and the ring into the storage stream (AppState::storage_ring, the recorder's).
+ *
+ * Lifecycle is owned by AppStateManager::set_monitoring().
+ */
+class AcquisitionThread final : private IRingStage
+{
+  public:
+    explicit AcquisitionThread(AppState& state);
+    ~AcquisitionThread();
+
+    AcquisitionThread(const AcquisitionThread&) = delete;
+    AcquisitionThread& operator=(const AcquisitionThread&) = delete;
+
+    /**
+     * Replace the amplifier source (only while stopped)
+     */
+    void set_source(std::unique_ptr<IAmplifierSource> source);
+
+    const IAmplifierSource* get_source() const
+    {
+        return source_.get();
+    }
+
+    /**
+     * Forward per-channel calibration to the source (only while stopped; applied on start())
+     */
+    void set_calibration(const std::vector<ChannelCalibration>& calibration);
+
+    /**
+     * Set the per-channel filters (only while stopped; designed for the ring's rate on start())
+     * @param filters Spec per ring channel
+     */
+    void set_filters(const std::vector<dsp::FilterSpec>& filters);
+
+    /**
+     * Set the channels averaged into AppState::average_ring (only while stopped)
+     * @param channels Ring channels; out-of-range entries are ignored on start()
+     */
+    void set_average_channels(const std::vector<int>& channels);
+
+    /**
+     * Set the MRI gradient artifact correction (only while stopped; sized for the ring on start())
+     * Every ring channel but the trigger channel is corrected.
+     * @param spec Correction of the next session (enabled = false: off)
+     */
+    void set_gradient_correction(const dsp::GradientCorrectionSpec& spec);
+
+    /**
+     * Set the ballistocardiogram correction (only while stopped; sized for the ring on start())
+     * @param spec Correction of the next session (enabled = false or no ECG channel: off)
+     * @param channels Ring channels to correct; out-of-range entries are ignored on start()
+     */
+    void set_pulse_correction(const dsp::PulseCorrectionSpec& spec, const std::vector<int>& channels);
+
+    /**
+     * Bring up the source and start the acquisition thread (no-op if already running)
+     * Resets all counters.
+     * @return Failure if there is no source or it could not be opened / configured / started
+     */
+    SourceResult start();
+
+    /**
+     * Stop the acquisition thread and join it (no-op if not running)
+     */
+    void stop();
+
+    bool is_running() const
+    {
+        return running_.load(std::memory_order_acquire);
+    }
+
+    /**
+     * Set the amplitude multiplier applied to generated samples
+     * @param scale Multiplier (validated by AppStateManager)
+     */
+    void set_noise_scale(float scale)
+    {
+        noise_scale_ = scale;
+        if (source_)
+        {
+            source_->set_noise_scale(scale);
+        }
+    }
+
+    /**
+     * Read the current counters (safe to call from any thread)
+     */
+    AcquisitionStats get_stats() const;
+
+    // Scheduler tick; independent of the UI frame rate
+    static constexpr std::chrono::microseconds kTickPeriod{1000};
+
+  private:
+    void run();
+
+    // Ring stage: gradient correction, filters, pulse correction, the common average, then the resampled streams,
+    // before each run is published
+    void process(uint64_t first, float* data, size_t channel_stride, int count) override;
+
+    AppState& state_;
+    std::unique_ptr<IAmplifierSource> source_;
+    std::thread thread_;
+    std::atomic<bool> running_{false};
+    float noise_scale_ = 1.0f;  // forwarded to each new source
+    std::vector<dsp::FilterSpec> filter_specs_;
+    dsp::IirFilterBank filters_;  // ring stage while running
+    std::vector<int> average_channels_;
+    dsp::AverageReference average_;  // ring stage while running, after filters_
+    dsp::GradientCorrectionSpec gradient_spec_;
+    dsp::GradientArtifactCorrector gradient_;  // ring stage while running, before filters_
+    dsp::PulseCorrectionSpec pulse_spec_;
+    std::vector<int> pulse_channels_;
+    dsp::PulseArtifactCorrector pulse_;  // ring stage while running, after filters_
+    dsp::PolyphaseResampler display_;          // ring stage while running, after average_
+    dsp::PolyphaseResampler display_average_;  // average ring's stage while running
+    dsp::PolyphaseResampler storage_;          // ring stage while running, after display_
+
+    // Counters (written by the acquisition thread, read by the UI)
+    std::atomic<uint64_t> samples_ingested_{0};
+    std::atomic<uint64_t> ticks_{0};
+    std::atomic<uint64_t> late_wakeups_{0};
+    std::atomic<uint64_t> backlogged_samples_{0};
+    std::atomic<uint32_t> max_backlog_{0};
+};
+
+}  // namespace elda::acquisition
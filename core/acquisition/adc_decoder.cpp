@@ -0,0 +1,102 @@
+#include "adc_decoder.h"
+
+#include "core/simd.h"
+#include "models/channel.h"
+#include "views/admin_settings/tabs/channels_config/channels_config_model.h"
+
+namespace elda::acquisition
+{
+
+namespace
+{
+constexpr size_t k_bytes_per_sample = 3;
+}  // namespace
+
+float unit_scale_for(const std::string& signal_type)
+{
+    if (views::channels_config::is_ecg_emg(signal_type))
+    {
+        return 1e-3f;
+    }
+    return 1.0f;
+}
+
+ChannelCalibration calibration_for(const models::Channel& channel)
+{
+    ChannelCalibration calibration;
+    calibration.gain = static_cast<float>(channel.sensor_gain);
+    calibration.offset = static_cast<float>(channel.sensor_offset);
+    calibration.unit_scale = unit_scale_for(channel.signal_type);
+    return calibration;
+}
+
+void AdcDecoder::configure(int channels, float uv_per_lsb, const std::vector<ChannelCalibration>& calibration)
+{
+    channels_ = channels;
+    const int lanes = (channels + 3) & ~3;
+    scale_ = AlignedBuffer<float>(lanes);
+    offset_ = AlignedBuffer<float>(lanes);
+
+    for (int c = 0; c < channels; ++c)
+    {
+        const ChannelCalibration cal =
+            c < static_cast<int>(calibration.size()) ? calibration[c] : ChannelCalibration{};
+        scale_[c] = uv_per_lsb * cal.gain * cal.unit_scale;
+        offset_[c] = cal.offset;
+    }
+}
+
+void AdcDecoder::decode_planar(const uint8_t* src, int frames, float* dst, size_t dst_stride) const
+{
+    using namespace simd;
+
+    const int channels = channels_;
+    const size_t frame_bytes = static_cast<size_t>(channels) * k_bytes_per_sample;
+    const int channels4 = channels & ~3;
+    const int frames4 = frames & ~3;
+
+    for (int f = 0; f < frames4; f += 4)
+    {
+        const uint8_t* rows = src + static_cast<size_t>(f) * frame_bytes;
+        for (int c = 0; c < channels4; c += 4)
+        {
+            const f32x4 scale = load(scale_.data() + c);
+            const f32x4 offset = load(offset_.data() + c);
+            const uint8_t* p = rows + static_cast<size_t>(c) * k_bytes_per_sample;
+
+            f32x4 r0 = madd(load_s24(p), scale, offset);
+            f32x4 r1 = madd(load_s24(p + frame_bytes), scale, offset);
+            f32x4 r2 = madd(load_s24(p + 2 * frame_bytes), scale, offset);
+            f32x4 r3 = madd(load_s24(p + 3 * frame_bytes), scale, offset);
+            transpose4(r0, r1, r2, r3);
+
+            float* out = dst + static_cast<size_t>(c) * dst_stride + f;
+            store(out, r0);
+            store(out + dst_stride, r1);
+            store(out + 2 * dst_stride, r2);
+            store(out + 3 * dst_stride, r3);
+        }
+        for (int c = channels4; c < channels; ++c)
+        {
+            float* out = dst + static_cast<size_t>(c) * dst_stride + f;
+            for (int k = 0; k < 4; ++k)
+            {
+                const uint8_t* p = rows + k * frame_bytes + static_cast<size_t>(c) * k_bytes_per_sample;
+                out[k] = static_cast<float>(s24_to_i32(p)) * scale_[c] + offset_[c];
+            }
+        }
+    }
+
+    for (int f = frames4; f < frames; ++f)
+    {
+        const uint8_t* row = src + static_cast<size_t>(f) * frame_bytes;
+        for (int c = 0; c < channels; ++c)
+        {
+            dst[static_cast<size_t>(c) * dst_stride + f] =
+                static_cast<float>(s24_to_i32(row + static_cast<size_t>(c) * k_bytes_per_sample)) * scale_[c] +
+                offset_[c];
+        }
+    }
+}
+
+}  // namespace elda::acquisition
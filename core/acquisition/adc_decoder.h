@@ -0,0 +1,79 @@
+#pragma once
+
+#include "core/aligned_buffer.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace elda::models
+{
+struct Channel;
+}
+
+namespace elda::acquisition
+{
+
+/**
+ * Per-channel conversion from ADC counts to display units
+ *  value = counts * units_per_lsb * gain * unit_scale + offset
+ */
+struct ChannelCalibration
+{
+    float gain = 1.0f;        // Sensor gain (models::Channel::sensor_gain)
+    float offset = 0.0f;      // Baseline offset in output units (models::Channel::sensor_offset)
+    float unit_scale = 1.0f;  // µV -> output unit (1 for EEG µV, 1e-3 for ECG/EMG mV)
+};
+
+/**
+ * µV -> output unit factor for a channel's signal type
+ * EEG stays in µV, ECG/EMG is shown in mV; other types are passed through.
+ */
+float unit_scale_for(const std::string& signal_type);
+
+/**
+ * Calibration taken from a configured channel
+ */
+ChannelCalibration calibration_for(const models::Channel& channel);
+
+/**
+ * AdcDecoder - packed 24-bit interleaved samples -> calibrated planar floats
+ *
+ * One pass per packet: 4 frames x 4 channels are unpacked and sign-extended
+ * in SIMD registers, scaled and offset with one multiply-add (calibration is
+ * pre-fused into a per-channel scale), transposed and stored straight into
+ * channel rows, so the output can be a SampleRing slab run (see
+ * SampleRing::push_with()).
+ */
+class AdcDecoder
+{
+  public:
+    /**
+     * @param channels Channels per frame
+     * @param uv_per_lsb ADC resolution in µV
+     * @param calibration Per-channel calibration (missing entries default to identity)
+     */
+    void configure(int channels, float uv_per_lsb, const std::vector<ChannelCalibration>& calibration);
+
+    /**
+     * Decode frames of interleaved 24-bit samples into channel rows
+     * @param src Packed samples src[(frame * channels + ch) * 3]; must stay readable 4 bytes past the end
+     * @param frames Frames to decode
+     * @param dst Channel c of frame k goes to dst[c * dst_stride + k]
+     * @param dst_stride Distance between channel rows in dst
+     */
+    void decode_planar(const uint8_t* src, int frames, float* dst, size_t dst_stride) const;
+
+    int channels() const
+    {
+        return channels_;
+    }
+
+  private:
+    int channels_ = 0;
+    AlignedBuffer<float> scale_;   // units_per_lsb * gain * unit_scale, padded to a multiple of 4
+    AlignedBuffer<float> offset_;  // padded to a multiple of 4
+};
+
+}  // namespace elda::acquisition
@@ -0,0 +1,31 @@
+#include "amplifier_source.h"
+
+#include "nvx136_simulator.h"
+#include "synth_eeg.h"
+#include "synth_source.h"
+
+#include <random>
+
+namespace elda::acquisition
+{
+
+uint64_t random_seed()
+{
+    std::random_device entropy;
+    const uint64_t seed = (static_cast<uint64_t>(entropy()) << 32) | entropy();
+    return seed ? seed : SynthEEG::k_default_seed;
+}
+
+std::unique_ptr<IAmplifierSource> make_amplifier_source(AmplifierKind kind, uint64_t seed)
+{
+    switch (kind)
+    {
+        case AmplifierKind::SimulatedNvx136:
+            return std::make_unique<SimulatedNvx136Source>(seed);
+        case AmplifierKind::Synthetic:
+        default:
+            return std::make_unique<SynthSource>(seed);
+    }
+}
+
+}  // namespace elda::acquisition
@@ -0,0 +1,117 @@
+#pragma once
+
+#include "adc_decoder.h"
+#include "core/core.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace elda::acquisition
+{
+
+/**
+ * Result of a source operation (mirrors StateChangeError: success flag + message)
+ */
+struct SourceResult
+{
+    bool ok;
+    std::string message;
+
+    static SourceResult success()
+    {
+        return {true, ""};
+    }
+
+    static SourceResult failure(std::string message)
+    {
+        return {false, std::move(message)};
+    }
+
+    explicit operator bool() const
+    {
+        return ok;
+    }
+};
+
+/**
+ * Link-level counters of a source. All values are cumulative since start().
+ */
+struct SourceStats
+{
+    uint64_t packets_received = 0;  // Packets decoded
+    uint64_t packets_lost = 0;      // Sequence gaps
+    uint64_t frames_concealed = 0;  // Frames synthesized for lost packets (keeps the time base aligned)
+    uint64_t bytes_received = 0;    // Raw bytes read from the link
+    uint64_t resyncs = 0;           // Times the parser had to hunt for a packet header
+};
+
+/**
+ * IAmplifierSource - a device (or simulator) that delivers multi-channel frames
+ *
+ * Lifecycle: open() -> configure() -> start() -> read_into()* -> stop() -> close().
+ * The acquisition thread is the only caller of read_into(); get_stats() may be
+ * called from any thread.
+ */
+class IAmplifierSource
+{
+  public:
+    virtual ~IAmplifierSource() = default;
+
+    // Human-readable device name for logs
+    virtual const char* name() const = 0;
+
+    // Acquire the link (device handle, pipe, socket)
+    virtual SourceResult open() = 0;
+
+    // Apply channel count and rate; only valid while stopped
+    virtual SourceResult configure(const AcquisitionFormat& format) = 0;
+
+    // Begin streaming
+    virtual SourceResult start() = 0;
+
+    /**
+     * Append frames that are available now to the ring, never blocking
+     * @param ring Destination; its channel count matches the configured format
+     * @param max_frames Upper bound on frames appended by this call
+     * @return Frames appended (0 if nothing is ready)
+     */
+    virtual int read_into(SampleRing& ring, int max_frames) = 0;
+
+    // Stop streaming (keeps the link open)
+    virtual void stop() = 0;
+
+    // Release the link
+    virtual void close() = 0;
+
+    virtual SourceStats get_stats() const
+    {
+        return {};
+    }
+
+    // Per-channel calibration applied while decoding ADC counts; only valid while stopped
+    virtual void set_calibration(const std::vector<ChannelCalibration>& /*calibration*/)
+    {
+    }
+
+    // Amplitude multiplier for simulated sources (ignored by hardware)
+    virtual void set_noise_scale(float /*scale*/)
+    {
+    }
+};
+
+/**
+ * Fresh non-zero seed from std::random_device
+ */
+uint64_t random_seed();
+
+/**
+ * Create the source for a session
+ * @param kind Device to open
+ * @param seed Simulator seed (0 = fresh seed per session)
+ */
+std::unique_ptr<IAmplifierSource> make_amplifier_source(AmplifierKind kind, uint64_t seed = 0);
+
+}  // namespace elda::acquisition
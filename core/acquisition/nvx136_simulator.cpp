@@ -0,0 +1,422 @@
+#include "nvx136_simulator.h"
+
+#include "nvx_packet.h"
+#include "synth_eeg.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <random>
+
+#if defined(_WIN32)
+    #include <fcntl.h>
+    #include <io.h>
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+#else
+    #include <cerrno>
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+namespace elda::acquisition
+{
+
+namespace
+{
+constexpr double k_packet_seconds = 0.001;  // NVX packets carry ~1 ms of frames
+constexpr size_t k_rx_bytes = 1 << 20;      // receive window; ~100 ms at 136 ch @ 25 kHz
+constexpr size_t k_rx_slack = 16;           // AdcDecoder reads up to 4 bytes past a packet
+constexpr size_t k_pipe_bytes = 1 << 20;
+
+// ===== Local pipe (POSIX pipe / Win32 CRT pipe) =====
+
+bool open_pipe(int& read_fd, int& write_fd)
+{
+    int fds[2];
+#if defined(_WIN32)
+    if (_pipe(fds, static_cast<unsigned>(k_pipe_bytes), _O_BINARY) != 0)
+    {
+        return false;
+    }
+#else
+    if (::pipe(fds) != 0)
+    {
+        return false;
+    }
+    // Reader never blocks: read_into() is called from the acquisition tick
+    ::fcntl(fds[0], F_SETFL, ::fcntl(fds[0], F_GETFL) | O_NONBLOCK);
+    #if defined(F_SETPIPE_SZ)
+    ::fcntl(fds[1], F_SETPIPE_SZ, static_cast<int>(k_pipe_bytes));
+    #endif
+#endif
+    read_fd = fds[0];
+    write_fd = fds[1];
+    return true;
+}
+
+// Bytes read without blocking (0 if the pipe is empty)
+size_t read_available(int fd, uint8_t* dst, size_t capacity)
+{
+    if (capacity == 0)
+    {
+        return 0;
+    }
+#if defined(_WIN32)
+    DWORD available = 0;
+    if (!PeekNamedPipe(reinterpret_cast<HANDLE>(_get_osfhandle(fd)), nullptr, 0, nullptr, &available, nullptr) ||
+        available == 0)
+    {
+        return 0;
+    }
+    const int n = _read(fd, dst, static_cast<unsigned>(std::min<size_t>(available, capacity)));
+#else
+    const ssize_t n = ::read(fd, dst, capacity);
+#endif
+    return n > 0 ? static_cast<size_t>(n) : 0;
+}
+
+bool write_all(int fd, const uint8_t* src, size_t bytes)
+{
+    while (bytes > 0)
+    {
+#if defined(_WIN32)
+        const int n = _write(fd, src, static_cast<unsigned>(bytes));
+#else
+        const ssize_t n = ::write(fd, src, bytes);
+        if (n < 0 && errno == EINTR)
+        {
+            continue;
+        }
+#endif
+        if (n <= 0)
+        {
+            return false;
+        }
+        src += n;
+        bytes -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+void close_fd(int& fd)
+{
+    if (fd < 0)
+    {
+        return;
+    }
+#if defined(_WIN32)
+    _close(fd);
+#else
+    ::close(fd);
+#endif
+    fd = -1;
+}
+}  // namespace
+
+// ===== CONSTRUCTOR / DESTRUCTOR =====
+
+SimulatedNvx136Source::SimulatedNvx136Source(uint64_t seed) : seed_(seed)
+{
+}
+
+SimulatedNvx136Source::~SimulatedNvx136Source()
+{
+    stop();
+    close();
+}
+
+// ===== LIFECYCLE =====
+
+SourceResult SimulatedNvx136Source::open()
+{
+    if (read_fd_ >= 0)
+    {
+        return SourceResult::success();
+    }
+    if (!open_pipe(read_fd_, write_fd_))
+    {
+        return SourceResult::failure("NVX136 simulator: could not create the link pipe");
+    }
+    return SourceResult::success();
+}
+
+SourceResult SimulatedNvx136Source::configure(const AcquisitionFormat& format)
+{
+    if (device_running_.load(std::memory_order_acquire))
+    {
+        return SourceResult::failure("NVX136 simulator: cannot configure while streaming");
+    }
+    if (format.channels < 1 || format.channels > MAX_CHANNELS)
+    {
+        return SourceResult::failure("NVX136 simulator: unsupported channel count");
+    }
+    if (!(format.sample_rate_hz > 0.0f) || format.sample_rate_hz > MAX_SAMPLE_RATE_HZ)
+    {
+        return SourceResult::failure("NVX136 simulator: unsupported sample rate");
+    }
+
+    format_ = format;
+    packet_frames_ = std::clamp(static_cast<int>(std::lround(format.sample_rate_hz * k_packet_seconds)),
+                                1,
+                                nvx::k_max_packet_frames);
+    return SourceResult::success();
+}
+
+SourceResult SimulatedNvx136Source::start()
+{
+    if (read_fd_ < 0)
+    {
+        return SourceResult::failure("NVX136 simulator: link is not open");
+    }
+    if (device_running_.load(std::memory_order_acquire))
+    {
+        return SourceResult::success();
+    }
+
+    decoder_.configure(format_.channels, nvx::k_uv_per_lsb, calibration_);
+    rx_.assign(k_rx_bytes + k_rx_slack, 0);
+    rx_begin_ = 0;
+    rx_end_ = 0;
+    expected_sequence_ = 0;
+    conceal_pending_ = 0;
+    last_frame_.assign(static_cast<size_t>(format_.channels), 0.0f);
+
+    packets_received_.store(0, std::memory_order_relaxed);
+    packets_lost_.store(0, std::memory_order_relaxed);
+    frames_concealed_.store(0, std::memory_order_relaxed);
+    bytes_received_.store(0, std::memory_order_relaxed);
+    resyncs_.store(0, std::memory_order_relaxed);
+
+    device_done_.store(false, std::memory_order_release);
+    device_running_.store(true, std::memory_order_release);
+    device_thread_ = std::thread(&SimulatedNvx136Source::device_loop, this, seed_ ? seed_ : random_seed());
+    return SourceResult::success();
+}
+
+void SimulatedNvx136Source::stop()
+{
+    device_running_.store(false, std::memory_order_release);
+    if (!device_thread_.joinable())
+    {
+        return;
+    }
+
+    // The device may be blocked on a full pipe: keep draining until it has left its loop
+    uint8_t scratch[4096];
+    while (!device_done_.load(std::memory_order_acquire))
+    {
+        if (read_available(read_fd_, scratch, sizeof(scratch)) == 0)
+        {
+            std::this_thread::yield();
+        }
+    }
+    device_thread_.join();
+}
+
+void SimulatedNvx136Source::close()
+{
+    close_fd(read_fd_);
+    close_fd(write_fd_);
+}
+
+SourceStats SimulatedNvx136Source::get_stats() const
+{
+    SourceStats stats;
+    stats.packets_received = packets_received_.load(std::memory_order_relaxed);
+    stats.packets_lost = packets_lost_.load(std::memory_order_relaxed);
+    stats.frames_concealed = frames_concealed_.load(std::memory_order_relaxed);
+    stats.bytes_received = bytes_received_.load(std::memory_order_relaxed);
+    stats.resyncs = resyncs_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+// ===== DEVICE SIDE =====
+
+void SimulatedNvx136Source::device_loop(uint64_t seed)
+{
+    using clock = std::chrono::steady_clock;
+
+    const int channels = format_.channels;
+    const int frames = packet_frames_;
+    const size_t values = static_cast<size_t>(frames) * channels;
+
+    SynthEEG synth(channels, format_.sample_rate_hz, seed);
+    std::vector<float> samples(values);
+    std::vector<uint8_t> packet(nvx::packet_bytes(frames, channels));
+
+    // Fault decisions get their own stream so they never perturb the signal
+    std::minstd_rand fault_rng(static_cast<uint32_t>(seed ^ (seed >> 32)) | 1u);
+    auto fault_uniform = [&fault_rng]
+    {
+        return static_cast<float>(fault_rng() - std::minstd_rand::min()) /
+               static_cast<float>(std::minstd_rand::max() - std::minstd_rand::min());
+    };
+
+    nvx::PacketHeader header;
+    header.frames = static_cast<uint16_t>(frames);
+    header.channels = static_cast<uint16_t>(channels);
+
+    // Send times are derived from the packet count, so rounding never accumulates
+    const double packet_period = static_cast<double>(frames) / format_.sample_rate_hz;
+    const auto t0 = clock::now();
+    uint32_t sequence = 0;
+
+    while (device_running_.load(std::memory_order_acquire))
+    {
+        synth.next_block(samples.data(), frames, noise_scale_.load(std::memory_order_relaxed));
+        header.sequence = sequence;
+        nvx::write_header(header, packet.data());
+        nvx::encode_int24(samples.data(), values, nvx::k_uv_per_lsb, packet.data() + nvx::k_header_bytes);
+
+        ++sequence;
+        auto send_at = t0 + std::chrono::duration_cast<clock::duration>(
+                                std::chrono::duration<double>(packet_period * static_cast<double>(sequence)));
+        const int jitter_us = jitter_us_.load(std::memory_order_relaxed);
+        if (jitter_us > 0)
+        {
+            send_at += std::chrono::microseconds(static_cast<int64_t>(fault_uniform() * jitter_us));
+        }
+        std::this_thread::sleep_until(send_at);
+
+        if (fault_uniform() < packet_loss_.load(std::memory_order_relaxed))
+        {
+            continue;  // dropped on the wire; the receiver sees a sequence gap
+        }
+        if (!write_all(write_fd_, packet.data(), packet.size()))
+        {
+            break;
+        }
+    }
+
+    device_done_.store(true, std::memory_order_release);
+}
+
+// ===== HOST SIDE =====
+
+void SimulatedNvx136Source::pump()
+{
+    if (rx_begin_ > 0)
+    {
+        std::memmove(rx_.data(), rx_.data() + rx_begin_, rx_end_ - rx_begin_);
+        rx_end_ -= rx_begin_;
+        rx_begin_ = 0;
+    }
+
+    while (rx_end_ < k_rx_bytes)
+    {
+        const size_t n = read_available(read_fd_, rx_.data() + rx_end_, k_rx_bytes - rx_end_);
+        if (n == 0)
+        {
+            break;
+        }
+        rx_end_ += n;
+        bytes_received_.fetch_add(n, std::memory_order_relaxed);
+    }
+}
+
+void SimulatedNvx136Source::conceal(SampleRing& ring, int frames)
+{
+    ring.push_with(frames,
+                   [this](int /*src_offset*/, int count, float* dst, size_t stride)
+                   {
+                       for (size_t c = 0; c < last_frame_.size(); ++c)
+                       {
+                           std::fill_n(dst + c * stride, count, last_frame_[c]);
+                       }
+                   });
+}
+
+int SimulatedNvx136Source::read_into(SampleRing& ring, int max_frames)
+{
+    if (read_fd_ < 0 || rx_.empty())
+    {
+        return 0;
+    }
+
+    pump();
+
+    const int channels = format_.channels;
+    // A longer gap is treated as a link restart rather than concealed
+    const double packets_per_second = static_cast<double>(format_.sample_rate_hz) / packet_frames_;
+    const auto max_conceal_packets = static_cast<uint32_t>(std::max(1.0, std::ceil(packets_per_second)));
+
+    int written = 0;
+    while (written < max_frames)
+    {
+        if (conceal_pending_ > 0)
+        {
+            const int n = static_cast<int>(std::min<int64_t>(conceal_pending_, max_frames - written));
+            conceal(ring, n);
+            conceal_pending_ -= n;
+            written += n;
+            continue;
+        }
+
+        const size_t available = rx_end_ - rx_begin_;
+        if (available < nvx::k_header_bytes)
+        {
+            break;
+        }
+
+        const uint8_t* p = rx_.data() + rx_begin_;
+        const nvx::PacketHeader header = nvx::read_header(p);
+        if (header.magic != nvx::k_packet_magic || header.channels != channels || header.frames == 0 ||
+            header.frames > nvx::k_max_packet_frames)
+        {
+            // Hunt for the next header; keep a partial magic at the tail
+            resyncs_.fetch_add(1, std::memory_order_relaxed);
+            size_t next = rx_begin_ + 1;
+            while (next + 4 <= rx_end_ && !nvx::has_magic(rx_.data() + next))
+            {
+                ++next;
+            }
+            rx_begin_ = std::min(next, rx_end_ > 3 ? rx_end_ - 3 : rx_end_);
+            continue;
+        }
+
+        const size_t bytes = nvx::packet_bytes(header.frames, channels);
+        if (available < bytes)
+        {
+            break;
+        }
+
+        const uint32_t gap = header.sequence - expected_sequence_;
+        if (gap != 0)
+        {
+            expected_sequence_ = header.sequence;
+            if (gap <= max_conceal_packets)
+            {
+                packets_lost_.fetch_add(gap, std::memory_order_relaxed);
+                conceal_pending_ = static_cast<int64_t>(gap) * header.frames;
+                frames_concealed_.fetch_add(static_cast<uint64_t>(conceal_pending_), std::memory_order_relaxed);
+                continue;
+            }
+            resyncs_.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        if (written + header.frames > max_frames)
+        {
+            break;
+        }
+
+        const uint8_t* payload = p + nvx::k_header_bytes;
+        const size_t frame_bytes = static_cast<size_t>(channels) * nvx::k_bytes_per_sample;
+        ring.push_with(header.frames,
+                       [this, payload, frame_bytes](int src_offset, int count, float* dst, size_t stride)
+                       { decoder_.decode_planar(payload + src_offset * frame_bytes, count, dst, stride); });
+        decoder_.decode_planar(payload + (header.frames - 1) * frame_bytes, 1, last_frame_.data(), 1);
+
+        written += header.frames;
+        rx_begin_ += bytes;
+        expected_sequence_ = header.sequence + 1;
+        packets_received_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    return written;
+}
+
+}  // namespace elda::acquisition
@@ -0,0 +1,125 @@
+#pragma once
+
+#include "amplifier_source.h"
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace elda::acquisition
+{
+
+/**
+ * Faults injected on the simulated link
+ */
+struct LinkFaults
+{
+    float packet_loss = 0.0f;  // Probability that a packet is dropped (0..1)
+    int jitter_us = 0;         // Each packet is delayed by a uniform 0..jitter_us on top of its nominal time
+};
+
+/**
+ * SimulatedNvx136Source - NVX136 stand-in that exercises the real decode path
+ *
+ * A device thread generates SynthEEG frames, quantizes them to 24-bit and
+ * writes nvx:: framed packets (~1 ms each) into a local pipe at the configured
+ * rate. read_into() drains the pipe without blocking, re-frames the byte
+ * stream, checks sequence numbers and decodes each packet straight into the
+ * ring with AdcDecoder (24-bit unpack + calibration in one pass).
+ *
+ * Lost packets are concealed by repeating the last good frame, so the ring's
+ * index time base stays aligned with device time; the gap is reported in
+ * SourceStats (packets_lost / frames_concealed). Garbage on the link makes the
+ * parser hunt for the next header (SourceStats::resyncs).
+ */
+class SimulatedNvx136Source final : public IAmplifierSource
+{
+  public:
+    /**
+     * @param seed Generator seed (0 = fresh seed per start())
+     */
+    explicit SimulatedNvx136Source(uint64_t seed = 0);
+    ~SimulatedNvx136Source() override;
+
+    SimulatedNvx136Source(const SimulatedNvx136Source&) = delete;
+    SimulatedNvx136Source& operator=(const SimulatedNvx136Source&) = delete;
+
+    const char* name() const override
+    {
+        return "NVX136 (simulated)";
+    }
+
+    SourceResult open() override;
+    SourceResult configure(const AcquisitionFormat& format) override;
+    SourceResult start() override;
+    int read_into(SampleRing& ring, int max_frames) override;
+    void stop() override;
+    void close() override;
+
+    SourceStats get_stats() const override;
+
+    void set_calibration(const std::vector<ChannelCalibration>& calibration) override
+    {
+        calibration_ = calibration;
+    }
+
+    void set_noise_scale(float scale) override
+    {
+        noise_scale_.store(scale, std::memory_order_relaxed);
+    }
+
+    /**
+     * Change injected faults; takes effect on the next packet (safe while streaming)
+     */
+    void set_faults(const LinkFaults& faults)
+    {
+        packet_loss_.store(faults.packet_loss, std::memory_order_relaxed);
+        jitter_us_.store(faults.jitter_us, std::memory_order_relaxed);
+    }
+
+    // Frames per packet at the configured rate (~1 ms of data, at least 1)
+    int packet_frames() const
+    {
+        return packet_frames_;
+    }
+
+  private:
+    void device_loop(uint64_t seed);
+    void pump();
+    void conceal(SampleRing& ring, int frames);
+
+    uint64_t seed_;
+    AcquisitionFormat format_;
+    int packet_frames_ = 1;
+    std::vector<ChannelCalibration> calibration_;
+    AdcDecoder decoder_;
+
+    // Local pipe: the device thread writes, read_into() reads (non-blocking)
+    int read_fd_ = -1;
+    int write_fd_ = -1;
+
+    std::thread device_thread_;
+    std::atomic<bool> device_running_{false};
+    std::atomic<bool> device_done_{true};
+    std::atomic<float> noise_scale_{1.0f};
+    std::atomic<float> packet_loss_{0.0f};
+    std::atomic<int> jitter_us_{0};
+
+    // Receiver state (acquisition thread only)
+    std::vector<uint8_t> rx_;
+    size_t rx_begin_ = 0;
+    size_t rx_end_ = 0;
+    uint32_t expected_sequence_ = 0;
+    int64_t conceal_pending_ = 0;
+    std::vector<float> last_frame_;  // calibrated, repeated over lost packets
+
+    // Counters (written by the acquisition thread, read by the UI)
+    std::atomic<uint64_t> packets_received_{0};
+    std::atomic<uint64_t> packets_lost_{0};
+    std::atomic<uint64_t> frames_concealed_{0};
+    std::atomic<uint64_t> bytes_received_{0};
+    std::atomic<uint64_t> resyncs_{0};
+};
+
+}  // namespace elda::acquisition
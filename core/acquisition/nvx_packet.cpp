@@ -0,0 +1,86 @@
+#include "nvx_packet.h"
+
+#include <cmath>
+
+namespace elda::acquisition::nvx
+{
+
+namespace
+{
+constexpr int32_t k_int24_max = (1 << 23) - 1;
+constexpr int32_t k_int24_min = -(1 << 23);
+
+void put_u16(uint8_t* dst, uint16_t v)
+{
+    dst[0] = static_cast<uint8_t>(v);
+    dst[1] = static_cast<uint8_t>(v >> 8);
+}
+
+void put_u32(uint8_t* dst, uint32_t v)
+{
+    dst[0] = static_cast<uint8_t>(v);
+    dst[1] = static_cast<uint8_t>(v >> 8);
+    dst[2] = static_cast<uint8_t>(v >> 16);
+    dst[3] = static_cast<uint8_t>(v >> 24);
+}
+
+uint16_t get_u16(const uint8_t* src)
+{
+    return static_cast<uint16_t>(src[0] | (src[1] << 8));
+}
+
+uint32_t get_u32(const uint8_t* src)
+{
+    return static_cast<uint32_t>(src[0]) | (static_cast<uint32_t>(src[1]) << 8) |
+           (static_cast<uint32_t>(src[2]) << 16) | (static_cast<uint32_t>(src[3]) << 24);
+}
+}  // namespace
+
+void write_header(const PacketHeader& header, uint8_t* dst)
+{
+    put_u32(dst, header.magic);
+    put_u32(dst + 4, header.sequence);
+    put_u16(dst + 8, header.frames);
+    put_u16(dst + 10, header.channels);
+    put_u32(dst + 12, header.status);
+}
+
+PacketHeader read_header(const uint8_t* src)
+{
+    PacketHeader header;
+    header.magic = get_u32(src);
+    header.sequence = get_u32(src + 4);
+    header.frames = get_u16(src + 8);
+    header.channels = get_u16(src + 10);
+    header.status = get_u32(src + 12);
+    return header;
+}
+
+void encode_int24(const float* src, size_t count, float uv_per_lsb, uint8_t* dst)
+{
+    const float lsb_per_uv = 1.0f / uv_per_lsb;
+    for (size_t i = 0; i < count; ++i)
+    {
+        long v = std::lround(src[i] * lsb_per_uv);
+        v = v > k_int24_max ? k_int24_max : (v < k_int24_min ? k_int24_min : v);
+        const auto u = static_cast<uint32_t>(v);
+        dst[0] = static_cast<uint8_t>(u);
+        dst[1] = static_cast<uint8_t>(u >> 8);
+        dst[2] = static_cast<uint8_t>(u >> 16);
+        dst += k_bytes_per_sample;
+    }
+}
+
+void decode_int24(const uint8_t* src, size_t count, float uv_per_lsb, float* dst)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        // Place the 24 bits at the top of an int32, then arithmetic-shift to sign-extend
+        const uint32_t u = (static_cast<uint32_t>(src[0]) << 8) | (static_cast<uint32_t>(src[1]) << 16) |
+                           (static_cast<uint32_t>(src[2]) << 24);
+        dst[i] = static_cast<float>(static_cast<int32_t>(u) >> 8) * uv_per_lsb;
+        src += k_bytes_per_sample;
+    }
+}
+
+}  // namespace elda::acquisition::nvx
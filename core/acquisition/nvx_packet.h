@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace elda::acquisition::nvx
+{
+
+/**
+ * Wire format of the (simulated) NVX136 sample stream
+ *
+ *  offset  size  field
+ *  0       4     magic     "NVX1", little-endian 0x3158564E
+ *  4       4     sequence  packet counter, wraps at 2^32; gaps mean lost packets
+ *  8       2     frames    frames in this packet
+ *  10      2     channels  channels per frame
+ *  12      4     status    device status bits (unused by the simulator)
+ *  16      ...   payload   frames * channels signed 24-bit little-endian samples,
+ *                          interleaved [frame][channel], 1 LSB = k_uv_per_lsb µV
+ *
+ * All fields are little-endian and serialized byte by byte, so the format does
+ * not depend on host struct packing or endianness.
+ */
+constexpr uint32_t k_packet_magic = 0x3158564Eu;
+constexpr size_t k_header_bytes = 16;
+constexpr size_t k_bytes_per_sample = 3;
+constexpr float k_uv_per_lsb = 0.05f;  // simulated ADC resolution (±419 mV full scale)
+constexpr int k_max_packet_frames = 1024;
+
+struct PacketHeader
+{
+    uint32_t magic = k_packet_magic;
+    uint32_t sequence = 0;
+    uint16_t frames = 0;
+    uint16_t channels = 0;
+    uint32_t status = 0;
+};
+
+inline bool has_magic(const uint8_t* p)
+{
+    return p[0] == (k_packet_magic & 0xFF) && p[1] == ((k_packet_magic >> 8) & 0xFF) &&
+           p[2] == ((k_packet_magic >> 16) & 0xFF) && p[3] == (k_packet_magic >> 24);
+}
+
+inline size_t packet_bytes(int frames, int channels)
+{
+    return k_header_bytes + static_cast<size_t>(frames) * channels * k_bytes_per_sample;
+}
+
+void write_header(const PacketHeader& header, uint8_t* dst);
+
+PacketHeader read_header(const uint8_t* src);
+
+/**
+ * Quantize µV samples to signed 24-bit little-endian (saturating)
+ */
+void encode_int24(const float* src, size_t count, float uv_per_lsb, uint8_t* dst);
+
+/**
+ * Expand signed 24-bit little-endian samples to µV
+ */
+void decode_int24(const uint8_t* src, size_t count, float uv_per_lsb, float* dst);
+
+}  // namespace elda::acquisition::nvx
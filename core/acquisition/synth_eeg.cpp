@@ -0,0 +1,305 @@
+#include "synth_eeg.h"
+
+#include "core/simd.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace elda::acquisition
+{
+
+namespace
+{
+constexpr double k_two_pi = 6.283185307179586;
+constexpr float k_pi = 3.14159265f;
+
+constexpr float k_alpha_hz = 10.0f, k_alpha_uv = 8.0f;
+constexpr float k_beta_hz = 20.0f, k_beta_uv = 4.0f;
+constexpr float k_theta_hz = 5.0f, k_theta_uv = 6.0f;
+constexpr float k_noise_smoothing = 0.02f;
+constexpr double k_artifact_probability = 2e-6;  // per channel-sample
+constexpr int k_frontal_channels = 8;             // blink-dominant channels
+
+// sqrt(3): scales (sum of 4 uniforms - 2), variance 1/3, to unit variance
+constexpr float k_irwin_hall_scale = 1.7320508f;
+
+void rotation(float hz, float rate, float& c, float& s)
+{
+    const double w = k_two_pi * hz / rate;
+    c = static_cast<float>(std::cos(w));
+    s = static_cast<float>(std::sin(w));
+}
+
+inline simd::u32x4 xorshift32(simd::u32x4 x)
+{
+    x = simd::bit_xor(x, simd::shl<13>(x));
+    x = simd::bit_xor(x, simd::shr<17>(x));
+    return simd::bit_xor(x, simd::shl<5>(x));
+}
+
+// z <- z * rot, four channels at a time
+inline void rotate(simd::f32x4& re, simd::f32x4& im, simd::f32x4 c, simd::f32x4 s)
+{
+    const simd::f32x4 next_re = simd::sub(simd::mul(re, c), simd::mul(im, s));
+    im = simd::madd(re, s, simd::mul(im, c));
+    re = next_re;
+}
+
+// One Newton step towards |z| = 1 (drift per block is ~1e-6, so one step is plenty)
+inline void renormalize(float* re, float* im, int lanes)
+{
+    using namespace simd;
+    const f32x4 three_halves = set1(1.5f);
+    const f32x4 half = set1(0.5f);
+    for (int c = 0; c < lanes; c += 4)
+    {
+        const f32x4 r = load(re + c);
+        const f32x4 i = load(im + c);
+        const f32x4 k = sub(three_halves, mul(half, madd(r, r, mul(i, i))));
+        store(re + c, mul(r, k));
+        store(im + c, mul(i, k));
+    }
+}
+}  // namespace
+
+// ===== CONSTRUCTOR =====
+
+SynthEEG::SynthEEG(int channels, float sample_rate_hz, uint64_t seed)
+    : channels_(std::max(1, channels)),
+      lanes_((std::max(1, channels) + 3) & ~3),
+      sample_rate_hz_(sample_rate_hz),
+      rng_state_(seed),
+      alpha_re_(lanes_),
+      alpha_im_(lanes_),
+      beta_re_(lanes_),
+      beta_im_(lanes_),
+      theta_re_(lanes_),
+      theta_im_(lanes_),
+      noise_(lanes_),
+      blink_gain_(lanes_),
+      lane_rng_(lanes_)
+{
+    rotation(k_alpha_hz, sample_rate_hz_, alpha_cos_, alpha_sin_);
+    rotation(k_beta_hz, sample_rate_hz_, beta_cos_, beta_sin_);
+    rotation(k_theta_hz, sample_rate_hz_, theta_cos_, theta_sin_);
+
+    for (int c = 0; c < lanes_; ++c)
+    {
+        const float pa = uniform() * static_cast<float>(k_two_pi);
+        const float pb = uniform() * static_cast<float>(k_two_pi);
+        const float pt = uniform() * static_cast<float>(k_two_pi);
+        alpha_re_[c] = std::cos(pa);
+        alpha_im_[c] = std::sin(pa);
+        beta_re_[c] = std::cos(pb);
+        beta_im_[c] = std::sin(pb);
+        theta_re_[c] = std::cos(pt);
+        theta_im_[c] = std::sin(pt);
+
+        blink_gain_[c] = (c < k_frontal_channels) ? 1.5f : 0.3f;
+
+        // xorshift32 must never be seeded with 0
+        uint32_t lane_seed = static_cast<uint32_t>(next_u64() >> 32);
+        lane_rng_[c] = lane_seed ? lane_seed : 0x9E3779B9u;
+    }
+
+    artifact_countdown_ = 0;
+    schedule_artifact();
+}
+
+// ===== SCALAR RNG =====
+
+uint64_t SynthEEG::next_u64()
+{
+    uint64_t z = (rng_state_ += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+float SynthEEG::uniform()
+{
+    return static_cast<float>(next_u64() >> 40) * (1.0f / 16777216.0f);
+}
+
+void SynthEEG::schedule_artifact()
+{
+    // Geometric gap: same event rate as one Bernoulli(p) draw per channel-sample
+    const double u = (static_cast<double>(next_u64() >> 11) + 1.0) * (1.0 / 9007199254740992.0);  // (0, 1]
+    artifact_countdown_ += 1 + static_cast<uint64_t>(std::log(u) / std::log1p(-k_artifact_probability));
+}
+
+// ===== SHARED TERMS (one value per frame) =====
+
+void SynthEEG::fill_shared(int frames)
+{
+    if (shared_.size() < static_cast<size_t>(frames))
+    {
+        shared_.resize(frames);
+        blink_.resize(frames);
+    }
+
+    const float dt = 1.0f / sample_rate_hz_;
+    for (int f = 0; f < frames; ++f)
+    {
+        // Global drift
+        drift_timer_ -= dt;
+        if (drift_timer_ <= 0.0f)
+        {
+            drift_target_ = (uniform() - 0.5f) * 4.0f;
+            drift_timer_ = 2.0f + uniform() * 3.0f;
+        }
+        drift_ += 0.02f * (drift_target_ - drift_);
+
+        // Eye blink
+        if (uniform() < 0.0001f)
+        {
+            blink_active_ = true;
+            blink_phase_ = 0.0f;
+        }
+        if (blink_active_)
+        {
+            blink_phase_ += (2.0f * k_pi) / (0.15f * sample_rate_hz_);
+            if (blink_phase_ >= k_pi)
+            {
+                blink_active_ = false;
+                blink_phase_ = 0.0f;
+            }
+        }
+        blink_[f] = blink_active_ ? 40.0f * std::sin(blink_phase_) : 0.0f;
+
+        // Burst
+        burst_timer_ -= dt;
+        if (burst_timer_ <= 0.0f && uniform() < 0.002f)
+        {
+            burst_amplitude_ = 20.0f + uniform() * 30.0f;
+            burst_timer_ = 0.3f + uniform() * 0.5f;
+            burst_phase_ = 0.0f;
+        }
+        float burst = 0.0f;
+        if (burst_timer_ > 0.0f)
+        {
+            burst_phase_ += (2.0f * k_pi * 15.0f) / sample_rate_hz_;
+            burst = burst_amplitude_ * std::sin(burst_phase_) *
+                    std::exp(-5.0f * (1.0f - (burst_timer_ / (0.3f + 0.5f))));
+        }
+
+        // Spike
+        spike_timer_ -= dt;
+        if (spike_timer_ <= 0.0f && uniform() < 0.0005f)
+        {
+            spike_amp_ = 50.0f + uniform() * 50.0f;
+            spike_timer_ = 0.05f;
+        }
+        float spike = 0.0f;
+        if (spike_timer_ > 0.0f)
+        {
+            const float t = 1.0f - (spike_timer_ / 0.05f);
+            spike = spike_amp_ * (t < 0.5f ? t * 2.0f : 2.0f * (1.0f - t));
+        }
+
+        // 50 Hz mains
+        mains_phase_ += (2.0f * k_pi * 50.0f) / sample_rate_hz_;
+        if (mains_phase_ > 2.0f * k_pi)
+        {
+            mains_phase_ -= 2.0f * k_pi;
+        }
+        const float mains = 0.5f * std::sin(mains_phase_);
+
+        shared_[f] = drift_ + mains + burst + spike;
+    }
+}
+
+// ===== BLOCK GENERATOR =====
+
+void SynthEEG::next_block(float* out, int frames, float gain)
+{
+    using namespace simd;
+
+    if (frames <= 0)
+    {
+        return;
+    }
+
+    fill_shared(frames);
+
+    const f32x4 ac = set1(alpha_cos_), as = set1(alpha_sin_);
+    const f32x4 bc = set1(beta_cos_), bs = set1(beta_sin_);
+    const f32x4 tc = set1(theta_cos_), ts = set1(theta_sin_);
+    const f32x4 alpha_uv = set1(k_alpha_uv), beta_uv = set1(k_beta_uv), theta_uv = set1(k_theta_uv);
+    const f32x4 smoothing = set1(k_noise_smoothing);
+    const f32x4 two = set1(2.0f);
+    const f32x4 ih_scale = set1(k_irwin_hall_scale);
+    const f32x4 g = set1(gain);
+    const size_t stride = static_cast<size_t>(channels_);
+
+    // Lane group outer, frames inner: oscillator and noise state stay in registers for the whole block
+    for (int c = 0; c < lanes_; c += 4)
+    {
+        f32x4 a_re = load(alpha_re_.data() + c), a_im = load(alpha_im_.data() + c);
+        f32x4 b_re = load(beta_re_.data() + c), b_im = load(beta_im_.data() + c);
+        f32x4 t_re = load(theta_re_.data() + c), t_im = load(theta_im_.data() + c);
+        f32x4 noise = load(noise_.data() + c);
+        const f32x4 blink_gain = load(blink_gain_.data() + c);
+        u32x4 rng = load_u32(lane_rng_.data() + c);
+
+        const int width = std::min(4, channels_ - c);
+        float* dst = out + c;
+
+        for (int f = 0; f < frames; ++f)
+        {
+            // Approximately N(0, 1): four uniforms per lane
+            f32x4 u = to_unit_float(rng = xorshift32(rng));
+            u = add(u, to_unit_float(rng = xorshift32(rng)));
+            u = add(u, to_unit_float(rng = xorshift32(rng)));
+            u = add(u, to_unit_float(rng = xorshift32(rng)));
+            const f32x4 gauss = mul(sub(u, two), ih_scale);
+            noise = madd(smoothing, sub(gauss, noise), noise);
+
+            f32x4 y = madd(alpha_uv, a_im, madd(beta_uv, b_im, mul(theta_uv, t_im)));
+            y = add(y, noise);
+            y = madd(blink_gain, set1(blink_[f]), y);
+            y = add(y, set1(shared_[f]));
+            y = mul(y, g);
+
+            rotate(a_re, a_im, ac, as);
+            rotate(b_re, b_im, bc, bs);
+            rotate(t_re, t_im, tc, ts);
+
+            if (width == 4)
+            {
+                store(dst, y);
+            }
+            else
+            {
+                alignas(16) float tail[4];
+                store(tail, y);
+                std::copy(tail, tail + width, dst);
+            }
+            dst += stride;
+        }
+
+        store(alpha_re_.data() + c, a_re);
+        store(alpha_im_.data() + c, a_im);
+        store(beta_re_.data() + c, b_re);
+        store(beta_im_.data() + c, b_im);
+        store(theta_re_.data() + c, t_re);
+        store(theta_im_.data() + c, t_im);
+        store(noise_.data() + c, noise);
+        store_u32(lane_rng_.data() + c, rng);
+    }
+
+    renormalize(alpha_re_.data(), alpha_im_.data(), lanes_);
+    renormalize(beta_re_.data(), beta_im_.data(), lanes_);
+    renormalize(theta_re_.data(), theta_im_.data(), lanes_);
+
+    // Rare single-sample artifacts, addressed by interleaved index
+    const uint64_t block_samples = static_cast<uint64_t>(frames) * stride;
+    while (artifact_countdown_ < block_samples)
+    {
+        out[artifact_countdown_] += gain * (uniform() - 0.5f) * 8.0f;
+        schedule_artifact();
+    }
+    artifact_countdown_ -= block_samples;
+}
+
+}  // namespace elda::acquisition
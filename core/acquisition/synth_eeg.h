@@ -0,0 +1,121 @@
+#pragma once
+
+#include "core/aligned_buffer.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace elda::acquisition
+{
+
+/**
+ * SynthEEG - synthetic multi-channel EEG for demos and soak tests
+ *
+ * Per channel: alpha (10 Hz), beta (20 Hz) and theta (5 Hz) oscillators,
+ * low-passed Gaussian baseline noise and rare single-sample artifacts.
+ * Shared by all channels: slow drift, 50 Hz mains, eye blinks (frontal
+ * channels 1-8 weighted), 15 Hz bursts and spikes.
+ *
+ * Block generator built for 136 ch @ 25 kHz:
+ *  - Oscillators are unit phasors advanced by a constant rotation per sample
+ *    (no sin() per channel-sample), renormalized once per block.
+ *  - Channels run four to a SIMD lane group; each lane owns a xorshift32
+ *    stream and approximates N(0, 1) by a scaled sum of four uniforms. The
+ *    0.02 low-pass on the noise makes this indistinguishable from the
+ *    Gaussian draw it replaces.
+ *  - Rare per-channel artifacts are scheduled by geometric gaps instead of
+ *    one uniform draw per channel-sample.
+ *
+ * Output is deterministic for a given seed and sequence of block sizes (no
+ * std:: distributions, whose algorithms differ between standard libraries).
+ */
+class SynthEEG
+{
+  public:
+    static constexpr uint64_t k_default_seed = 0x5EEDEE6ull;
+
+    SynthEEG(int channels, float sample_rate_hz, uint64_t seed = k_default_seed);
+
+    /**
+     * Generate frames of interleaved samples
+     * @param out Interleaved output: out[frame * channels() + ch], in µV
+     * @param frames Number of frames to generate
+     * @param gain Multiplier applied to every sample (noise scale)
+     */
+    void next_block(float* out, int frames, float gain = 1.0f);
+
+    /**
+     * Generate a single frame (resizes out to channels())
+     */
+    void next(std::vector<float>& out)
+    {
+        out.resize(static_cast<size_t>(channels_));
+        next_block(out.data(), 1);
+    }
+
+    int channels() const
+    {
+        return channels_;
+    }
+
+    float sample_rate_hz() const
+    {
+        return sample_rate_hz_;
+    }
+
+  private:
+    // Scalar stream for shared events (splitmix64)
+    uint64_t next_u64();
+    float uniform();
+
+    void fill_shared(int frames);
+    void schedule_artifact();
+
+    int channels_;
+    int lanes_;  // channels_ rounded up to a multiple of 4
+    float sample_rate_hz_;
+    uint64_t rng_state_;
+
+    // Per-channel state, lanes_ wide
+    AlignedBuffer<float> alpha_re_, alpha_im_;
+    AlignedBuffer<float> beta_re_, beta_im_;
+    AlignedBuffer<float> theta_re_, theta_im_;
+    AlignedBuffer<float> noise_;
+    AlignedBuffer<float> blink_gain_;
+    AlignedBuffer<uint32_t> lane_rng_;
+
+    // Per-sample rotations (cos, sin of 2*pi*f/rate)
+    float alpha_cos_, alpha_sin_;
+    float beta_cos_, beta_sin_;
+    float theta_cos_, theta_sin_;
+
+    // Per-frame shared terms for the current block
+    std::vector<float> shared_;  // drift + mains + burst + spike
+    std::vector<float> blink_;
+
+    // Drift
+    float drift_ = 0.0f;
+    float drift_target_ = 0.0f;
+    float drift_timer_ = 0.0f;
+
+    // Eye blink
+    float blink_phase_ = 0.0f;
+    bool blink_active_ = false;
+
+    // Burst
+    float burst_phase_ = 0.0f;
+    float burst_amplitude_ = 0.0f;
+    float burst_timer_ = 0.0f;
+
+    // Spike
+    float spike_timer_ = 0.0f;
+    float spike_amp_ = 0.0f;
+
+    // 50 Hz mains
+    float mains_phase_ = 0.0f;
+
+    // Channel-samples (interleaved index) until the next artifact
+    uint64_t artifact_countdown_ = 0;
+};
+
+}  // namespace elda::acquisition
@@ -0,0 +1,68 @@
+#include "synth_source.h"
+
+#include <algorithm>
+
+namespace elda::acquisition
+{
+
+// ===== SynthSource =====
+
+SynthSource::SynthSource(uint64_t seed) : seed_(seed)
+{
+}
+
+SourceResult SynthSource::open()
+{
+    return SourceResult::success();
+}
+
+SourceResult SynthSource::configure(const AcquisitionFormat& format)
+{
+    format_ = format;
+    return SourceResult::success();
+}
+
+SourceResult SynthSource::start()
+{
+    synth_ = std::make_unique<SynthEEG>(format_.channels, format_.sample_rate_hz, seed_ ? seed_ : random_seed());
+    clock_ = std::make_unique<SampleClock>(format_.sample_rate_hz);
+    pending_frames_ = 0;
+    return SourceResult::success();
+}
+
+int SynthSource::read_into(SampleRing& ring, int max_frames)
+{
+    if (!synth_)
+    {
+        return 0;
+    }
+
+    pending_frames_ += clock_->due();
+    const int frames = static_cast<int>(std::min<int64_t>(pending_frames_, max_frames));
+    if (frames <= 0)
+    {
+        return 0;
+    }
+
+    const size_t values = static_cast<size_t>(frames) * format_.channels;
+    if (block_.size() < values)
+    {
+        block_.resize(values);
+    }
+    synth_->next_block(block_.data(), frames, noise_scale_.load(std::memory_order_relaxed));
+    ring.push_block(block_.data(), frames, FrameFormat::Interleaved);
+    pending_frames_ -= frames;
+    return frames;
+}
+
+void SynthSource::stop()
+{
+    synth_.reset();
+    clock_.reset();
+}
+
+void SynthSource::close()
+{
+}
+
+}  // namespace elda::acquisition
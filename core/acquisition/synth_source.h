@@ -0,0 +1,55 @@
+#pragma once
+
+#include "amplifier_source.h"
+#include "synth_eeg.h"
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace elda::acquisition
+{
+
+/**
+ * SynthSource - in-process SynthEEG paced by a SampleClock
+ *
+ * read_into() appends every frame that became due since the previous call,
+ * so the acquisition tick rate does not affect the sample rate. Frames are
+ * generated in µV and not calibrated (there are no ADC counts to scale).
+ */
+class SynthSource final : public IAmplifierSource
+{
+  public:
+    /**
+     * @param seed Generator seed (0 = fresh seed per start())
+     */
+    explicit SynthSource(uint64_t seed = 0);
+
+    const char* name() const override
+    {
+        return "Synthetic EEG";
+    }
+
+    SourceResult open() override;
+    SourceResult configure(const AcquisitionFormat& format) override;
+    SourceResult start() override;
+    int read_into(SampleRing& ring, int max_frames) override;
+    void stop() override;
+    void close() override;
+
+    void set_noise_scale(float scale) override
+    {
+        noise_scale_.store(scale, std::memory_order_relaxed);
+    }
+
+  private:
+    uint64_t seed_;
+    AcquisitionFormat format_;
+    std::unique_ptr<SynthEEG> synth_;
+    std::unique_ptr<SampleClock> clock_;
+    int64_t pending_frames_ = 0;  // due but not yet handed out (max_frames reached)
+    std::vector<float> block_;    // interleaved staging for SynthEEG::next_block()
+    std::atomic<float> noise_scale_{1.0f};
+};
+
+}  // namespace elda::acquisition
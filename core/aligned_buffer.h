@@ -0,0 +1,87 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+namespace elda
+{
+
+// Cache line / widest SIMD register we target
+static constexpr size_t k_cache_line_bytes = 64;
+
+/**
+ * AlignedBuffer - fixed-size, cache-line aligned heap array
+ *
+ * One allocation, no per-element construction cost beyond value-init,
+ * movable but not copyable. Used for sample slabs that are streamed by
+ * SIMD kernels.
+ */
+template <typename T>
+class AlignedBuffer
+{
+    static_assert(std::is_trivially_copyable<T>::value, "AlignedBuffer holds plain sample types only");
+
+  public:
+    AlignedBuffer() = default;
+
+    explicit AlignedBuffer(size_t count) : count_(count)
+    {
+        if (count_ > 0)
+        {
+            data_.reset(static_cast<T*>(::operator new(bytes(), std::align_val_t(k_cache_line_bytes))));
+            std::fill(data_.get(), data_.get() + count_, T{});
+        }
+    }
+
+    T* data()
+    {
+        return data_.get();
+    }
+
+    const T* data() const
+    {
+        return data_.get();
+    }
+
+    size_t size() const
+    {
+        return count_;
+    }
+
+    size_t bytes() const
+    {
+        return count_ * sizeof(T);
+    }
+
+    T& operator[](size_t i)
+    {
+        return data_[i];
+    }
+
+    const T& operator[](size_t i) const
+    {
+        return data_[i];
+    }
+
+    void fill(const T& value)
+    {
+        std::fill(data_.get(), data_.get() + count_, value);
+    }
+
+  private:
+    struct Deleter
+    {
+        void operator()(T* p) const
+        {
+            ::operator delete(p, std::align_val_t(k_cache_line_bytes));
+        }
+    };
+
+    std::unique_ptr<T[], Deleter> data_;
+    size_t count_ = 0;
+};
+
+}  // namespace elda
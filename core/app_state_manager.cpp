@@ -1,17 +1,28 @@
 #include "app_state_manager.h"
 
+#include "services/channel_management_service.h"
+#include "views/admin_settings/tabs/channels_config/channels_config_model.h"
+
+#include <algorithm>
 #include <unordered_map>
 
 namespace elda
 {
 // ===== CONSTRUCTOR / DESTRUCTOR =====
 
-AppStateManager::AppStateManager(AppState& state) : state_(state), impedance_check_passed_(false)
+AppStateManager::AppStateManager(AppState& state)
+    : state_(state),
+      impedance_check_passed_(false),
+      acquisition_(std::make_unique<acquisition::AcquisitionThread>(state)),
+      amplifier_(state.acquisition_format.amplifier)
 {
+    acquisition_->set_noise_scale(state_.noise_scale);
+    acquisition_->set_source(acquisition::make_amplifier_source(amplifier_));
 }
 
 AppStateManager::~AppStateManager()
 {
+    acquisition_->stop();
 }
 
 // ===== MONITORING CONTROL =====
@@ -31,6 +42,51 @@ StateChangeError AppStateManager::set_monitoring(bool enable)
             return {StateChangeResult::ValidationFailed, error_msg};
         }
 
+        // Producer is stopped here; reallocates only if the format changed since the last session
+        const AcquisitionFormat& format = state_.acquisition_format;
+        state_.ring.configure(
+            format.channels, format.buffer_size(), format.sample_rate_hz, RING_LAYOUT, RING_TILE_SAMPLES);
+        state_.pyramid.configure(state_.ring);
+        state_.average_ring.configure(1, format.buffer_size(), format.sample_rate_hz, RING_LAYOUT, RING_TILE_SAMPLES);
+        if (format.resamples_display())
+        {
+            const int capacity = AcquisitionFormat::buffer_size_at(format.display_rate_hz);
+            state_.display_ring.configure(
+                format.channels, capacity, format.display_rate_hz, RING_LAYOUT, RING_TILE_SAMPLES);
+            state_.display_pyramid.configure(state_.display_ring);
+            state_.display_average_ring.configure(1, capacity, format.display_rate_hz, RING_LAYOUT, RING_TILE_SAMPLES);
+        }
+        if (format.resamples_storage())
+        {
+            state_.storage_ring.configure(format.channels,
+                                          AcquisitionFormat::buffer_size_at(format.storage_rate_hz),
+                                          format.storage_rate_hz,
+                                          RING_LAYOUT,
+                                          RING_TILE_SAMPLES);
+        }
+        state_.playhead_seconds = 0.0;
+
+        if (format.amplifier != amplifier_)
+        {
+            amplifier_ = format.amplifier;
+            acquisition_->set_source(acquisition::make_amplifier_source(amplifier_));
+        }
+        acquisition_->set_calibration(build_calibration(format.channels));
+        acquisition_->set_filters(build_filters(format.channels));
+        acquisition_->set_average_channels(build_average_channels(format.channels));
+        acquisition_->set_gradient_correction(state_.gradient_correction);
+        dsp::PulseCorrectionSpec pulse = state_.pulse_correction;
+        pulse.ecg_channel = build_ecg_channel(format.channels);
+        if (pulse.enabled && pulse.ecg_channel < 0)
+        {
+            std::printf("[AppStateManager] Pulse correction off: no ECG/EMG channel is acquired\n");
+        }
+        acquisition_->set_pulse_correction(pulse, build_average_channels(format.channels));
+        if (auto result = acquisition_->start(); !result)
+        {
+            return {StateChangeResult::HardwareError, result.message};
+        }
+
         state_.is_monitoring = true;
         notify_state_changed(StateField::Monitoring);
     }
@@ -42,6 +98,8 @@ StateChangeError AppStateManager::set_monitoring(bool enable)
             // Continue stopping monitoring even if recording stop fails
         }
 
+        acquisition_->stop();
+
         state_.is_monitoring = false;
         notify_state_changed(StateField::Monitoring);
     }
@@ -171,6 +229,22 @@ StateChangeError AppStateManager::set_display_amplitude(int amplitude_index)
     return {StateChangeResult::Success, ""};
 }
 
+StateChangeError AppStateManager::set_frame_cap(int cap_index)
+{
+    std::string error_msg;
+    if (!validate_frame_cap_index(cap_index, error_msg))
+    {
+        return {StateChangeResult::ValidationFailed, error_msg};
+    }
+
+    state_.frame_cap_idx = cap_index;
+    std::printf("[AppStateManager] Frame cap while monitoring: %d Hz\n", state_.frame_cap_hz());
+
+    notify_state_changed(StateField::FrameCap);
+
+    return {StateChangeResult::Success, ""};
+}
+
 // ===== NOISE/ARTIFACT CONTROL =====
 
 StateChangeError AppStateManager::set_noise_scale(float scale)
@@ -182,6 +256,7 @@ StateChangeError AppStateManager::set_noise_scale(float scale)
     }
 
     state_.noise_scale = scale;
+    acquisition_->set_noise_scale(scale);
 
     notify_state_changed(StateField::NoiseSettings);
 
@@ -203,6 +278,83 @@ StateChangeError AppStateManager::set_artifact_scale(float scale)
     return {StateChangeResult::Success, ""};
 }
 
+// ===== ACQUISITION =====
+
+StateChangeError AppStateManager::set_acquisition_format(const AcquisitionFormat& format)
+{
+    if (state_.is_monitoring)
+    {
+        return {StateChangeResult::InvalidTransition, "Cannot change acquisition format while monitoring"};
+    }
+
+    std::string error_msg;
+    if (!validate_acquisition_format(format, error_msg))
+    {
+        return {StateChangeResult::ValidationFailed, error_msg};
+    }
+
+    state_.acquisition_format = format;
+
+    std::printf("[AppStateManager] Acquisition format: %d ch @ %.0f Hz (%.2f M samples/s, ring %.1f MiB)\n",
+                format.channels,
+                format.sample_rate_hz,
+                format.samples_per_second() / 1e6,
+                SampleRing::bytes_required(format.channels, format.buffer_size(), RING_LAYOUT, RING_TILE_SAMPLES) /
+                    (1024.0 * 1024.0));
+
+    notify_state_changed(StateField::AcquisitionFormat);
+
+    return {StateChangeResult::Success, ""};
+}
+
+StateChangeError AppStateManager::set_gradient_correction(const dsp::GradientCorrectionSpec& spec)
+{
+    if (state_.is_monitoring)
+    {
+        return {StateChangeResult::InvalidTransition, "Cannot change gradient correction while monitoring"};
+    }
+
+    std::string error_msg;
+    if (!validate_gradient_correction(spec, error_msg))
+    {
+        return {StateChangeResult::ValidationFailed, error_msg};
+    }
+
+    state_.gradient_correction = spec;
+
+    if (spec.enabled)
+    {
+        std::printf("[AppStateManager] Gradient correction: TR %.0f ms, onsets from %s, %d-volume template\n",
+                    spec.tr_ms,
+                    spec.trigger_channel >= 0 ? "trigger channel" : "TR period",
+                    spec.epochs);
+    }
+
+    notify_state_changed(StateField::GradientCorrection);
+
+    return {StateChangeResult::Success, ""};
+}
+
+StateChangeError AppStateManager::set_pulse_correction(const dsp::PulseCorrectionSpec& spec)
+{
+    if (state_.is_monitoring)
+    {
+        return {StateChangeResult::InvalidTransition, "Cannot change pulse correction while monitoring"};
+    }
+
+    std::string error_msg;
+    if (!validate_pulse_correction(spec, error_msg))
+    {
+        return {StateChangeResult::ValidationFailed, error_msg};
+    }
+
+    state_.pulse_correction = spec;
+
+    notify_state_changed(StateField::PulseCorrection);
+
+    return {StateChangeResult::Success, ""};
+}
+
 std::vector<const models::Channel*>& AppStateManager::get_selected_channels() const
 {
     return state_.selected_channels;
@@ -257,6 +409,29 @@ StateChangeError AppStateManager::set_active_channel_group(const models::Channel
     return {StateChangeResult::Success, ""};
 }
 
+StateChangeError AppStateManager::update_channel(const models::Channel& channel)
+{
+    if (state_.is_monitoring)
+    {
+        return {StateChangeResult::InvalidTransition, "Cannot change channel settings while monitoring"};
+    }
+
+    std::string error_msg;
+    if (!validate_can_change_channels(error_msg))
+    {
+        return {StateChangeResult::InvalidTransition, error_msg};
+    }
+
+    // available_channels mirrors the service's list, so the next session's filters see the change
+    if (!services::ChannelManagementService::get_instance().update_channel(channel))
+    {
+        return {StateChangeResult::ValidationFailed, "Unknown channel: " + channel.id};
+    }
+
+    notify_state_changed(StateField::ChannelConfig);
+    return {StateChangeResult::Success, ""};
+}
+
 // ===== OBSERVER PATTERN =====
 
 AppStateManager::ObserverHandle AppStateManager::add_observer(StateObserver observer)
@@ -300,7 +475,7 @@ bool AppStateManager::validate_can_start_monitoring(std::string& error_msg)
         return false;
     }
 
-    // TODO: Add hardware connectivity check when SDK is integrated
+    // Device connectivity is checked when set_monitoring() opens the amplifier source
 
     return true;
 }
@@ -358,6 +533,16 @@ bool AppStateManager::validate_amplitude_index(int index, std::string& error_msg
     return true;
 }
 
+bool AppStateManager::validate_frame_cap_index(int index, std::string& error_msg)
+{
+    if (index < 0 || index >= FRAME_CAP_COUNT)
+    {
+        error_msg = "Invalid frame cap index (must be 0-" + std::to_string(FRAME_CAP_COUNT - 1) + ")";
+        return false;
+    }
+    return true;
+}
+
 bool AppStateManager::validate_scale(float scale, const std::string& param_name, std::string& error_msg)
 {
     if (scale < 0.0f || scale > 5.0f)
@@ -367,4 +552,147 @@ bool AppStateManager::validate_scale(float scale, const std::string& param_name,
     }
     return true;
 }
+
+bool AppStateManager::validate_acquisition_format(const AcquisitionFormat& format, std::string& error_msg)
+{
+    if (format.channels < 1 || format.channels > MAX_CHANNELS)
+    {
+        error_msg = "Channel count must be between 1 and " + std::to_string(MAX_CHANNELS);
+        return false;
+    }
+    if (!(format.sample_rate_hz > 0.0f) || format.sample_rate_hz > MAX_SAMPLE_RATE_HZ)
+    {
+        error_msg = "Sample rate must be between 0 and " + std::to_string(static_cast<int>(MAX_SAMPLE_RATE_HZ)) + " Hz";
+        return false;
+    }
+    if (format.resamples_display() && !dsp::ResampleDesign::supported(format.sample_rate_hz, format.display_rate_hz))
+    {
+        error_msg = "Display rate " + std::to_string(static_cast<int>(format.display_rate_hz)) +
+                    " Hz cannot be resampled from " + std::to_string(static_cast<int>(format.sample_rate_hz)) + " Hz";
+        return false;
+    }
+    if (format.resamples_storage() && !dsp::ResampleDesign::supported(format.sample_rate_hz, format.storage_rate_hz))
+    {
+        error_msg = "Storage rate " + std::to_string(static_cast<int>(format.storage_rate_hz)) +
+                    " Hz cannot be resampled from " + std::to_string(static_cast<int>(format.sample_rate_hz)) + " Hz";
+        return false;
+    }
+    return true;
+}
+
+bool AppStateManager::validate_gradient_correction(const dsp::GradientCorrectionSpec& spec, std::string& error_msg)
+{
+    if (!spec.enabled)
+    {
+        return true;
+    }
+    if (!(spec.tr_ms >= 100.0) || spec.tr_ms > 20000.0)
+    {
+        error_msg = "TR must be between 100 and 20000 ms";
+        return false;
+    }
+    if (spec.trigger_channel < -1 || spec.trigger_channel >= MAX_CHANNELS)
+    {
+        error_msg = "Trigger channel must be between 1 and " + std::to_string(MAX_CHANNELS);
+        return false;
+    }
+    if (spec.epochs < dsp::GradientArtifactCorrector::k_min_epochs)
+    {
+        error_msg = "Gradient template needs at least " +
+                    std::to_string(dsp::GradientArtifactCorrector::k_min_epochs) + " volumes";
+        return false;
+    }
+    return true;
+}
+
+bool AppStateManager::validate_pulse_correction(const dsp::PulseCorrectionSpec& spec, std::string& error_msg)
+{
+    if (!spec.enabled)
+    {
+        return true;
+    }
+    if (spec.beats < dsp::PulseArtifactCorrector::k_min_beats)
+    {
+        error_msg = "Pulse template needs at least " + std::to_string(dsp::PulseArtifactCorrector::k_min_beats) +
+                    " beats";
+        return false;
+    }
+    if (!(spec.window_ms >= 200.0) || spec.window_ms > 2000.0)
+    {
+        error_msg = "Pulse template window must be between 200 and 2000 ms";
+        return false;
+    }
+    return true;
+}
+
+// ===== ACQUISITION HELPERS =====
+
+std::vector<acquisition::ChannelCalibration> AppStateManager::build_calibration(int channels) const
+{
+    std::vector<acquisition::ChannelCalibration> calibration(static_cast<size_t>(channels));
+    if (!state_.available_channels)
+    {
+        return calibration;
+    }
+    for (const auto& channel : *state_.available_channels)
+    {
+        if (channel.amplifier_channel >= 0 && channel.amplifier_channel < channels)
+        {
+            calibration[channel.amplifier_channel] = acquisition::calibration_for(channel);
+        }
+    }
+    return calibration;
+}
+
+std::vector<dsp::FilterSpec> AppStateManager::build_filters(int channels) const
+{
+    std::vector<dsp::FilterSpec> filters(static_cast<size_t>(channels));
+    if (!state_.available_channels)
+    {
+        return filters;
+    }
+    for (const auto& channel : *state_.available_channels)
+    {
+        if (channel.filtered && channel.amplifier_channel >= 0 && channel.amplifier_channel < channels)
+        {
+            filters[channel.amplifier_channel] = dsp::filter_for(channel);
+        }
+    }
+    return filters;
+}
+
+std::vector<int> AppStateManager::build_average_channels(int channels) const
+{
+    std::vector<int> averaged;
+    if (!state_.available_channels)
+    {
+        return averaged;
+    }
+    for (const auto& channel : *state_.available_channels)
+    {
+        if (channel.signal_type == "EEG" && channel.amplifier_channel >= 0 && channel.amplifier_channel < channels &&
+            std::find(averaged.begin(), averaged.end(), channel.amplifier_channel) == averaged.end())
+        {
+            averaged.push_back(channel.amplifier_channel);
+        }
+    }
+    return averaged;
+}
+
+int AppStateManager::build_ecg_channel(int channels) const
+{
+    if (!state_.available_channels)
+    {
+        return -1;
+    }
+    for (const auto& channel : *state_.available_channels)
+    {
+        if (views::channels_config::is_ecg_emg(channel.signal_type) && channel.amplifier_channel >= 0 &&
+            channel.amplifier_channel < channels)
+        {
+            return channel.amplifier_channel;
+        }
+    }
+    return -1;
+}
 }  // namespace elda
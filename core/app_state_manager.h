@@ -1,9 +1,11 @@
 #pragma once
 
+#include "core/acquisition/acquisition_thread.h"
 #include "core/core.h"
 #include "models/channel.h"
 
 #include <functional>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -47,7 +49,11 @@ enum class StateField
     ChannelConfig,
     DisplayWindow,
     DisplayAmplitude,
-    NoiseSettings
+    FrameCap,
+    NoiseSettings,
+    AcquisitionFormat,
+    GradientCorrection,
+    PulseCorrection
 };
 
 // ===== App State Manager =====
@@ -67,7 +73,9 @@ class AppStateManager
 
     /**
      * Start or stop monitoring mode
-     * When stopping, automatically stops recording if active
+     * Starting re-shapes the ring to the session format, opens the amplifier source
+     * (HardwareError if that fails) and launches the acquisition thread;
+     * stopping joins it and automatically stops recording if active
      * @param enable True to start monitoring, false to stop
      * @return Result of state change
      */
@@ -148,6 +156,14 @@ class AppStateManager
      */
     StateChangeError set_active_channel_group(const models::ChannelsGroup& group);
 
+    /**
+     * Replace a channel's settings (gain, filters, ...) by id and persist them
+     * Takes effect when monitoring starts (calibration and filters are built from the channel list then)
+     * @param channel Channel with updated data (must have a known id)
+     * @return Result of state change (InvalidTransition while monitoring)
+     */
+    StateChangeError update_channel(const models::Channel& channel);
+
     /**
      * Get current channel configuration name
      */
@@ -180,6 +196,13 @@ class AppStateManager
      */
     StateChangeError set_display_amplitude(int amplitudeIndex);
 
+    /**
+     * Set the frame-rate cap the main loop keeps while the sweep animates
+     * @param capIndex Index into FRAME_CAP_OPTIONS array (0-2)
+     * @return Result of state change
+     */
+    StateChangeError set_frame_cap(int capIndex);
+
     /**
      * Get current window index
      */
@@ -212,6 +235,14 @@ class AppStateManager
         return state_.amp_pp_uv();
     }
 
+    /**
+     * Get current frame-rate cap in Hz
+     */
+    int get_frame_cap_hz() const
+    {
+        return state_.frame_cap_hz();
+    }
+
     // === NOISE/ARTIFACT CONTROL ===
 
     /**
@@ -230,6 +261,56 @@ class AppStateManager
 
     std::vector<const models::Channel*>& get_selected_channels() const;
 
+    // === ACQUISITION ===
+
+    /**
+     * Set channel count and sample rate for the next session
+     * Takes effect when monitoring starts (ring, generator and chart are sized then)
+     * @param format Channels (1-136), rate (up to 25 kHz) and amplifier source
+     * @return Result of state change (InvalidTransition while monitoring)
+     */
+    StateChangeError set_acquisition_format(const AcquisitionFormat& format);
+
+    const AcquisitionFormat& get_acquisition_format() const
+    {
+        return state_.acquisition_format;
+    }
+
+    /**
+     * Set the MRI gradient artifact correction for the next session
+     * Takes effect when monitoring starts, after the filters are set up
+     * @param spec TR (100-20000 ms), trigger channel (-1 = onsets from the TR) and template volumes
+     * @return Result of state change (InvalidTransition while monitoring)
+     */
+    StateChangeError set_gradient_correction(const dsp::GradientCorrectionSpec& spec);
+
+    const dsp::GradientCorrectionSpec& get_gradient_correction() const
+    {
+        return state_.gradient_correction;
+    }
+
+    /**
+     * Set the ballistocardiogram correction for the next session
+     * R-peaks are detected on the first ECG/EMG channel of the channel list when monitoring starts;
+     * without one the correction stays off.
+     * @param spec Template beats (at least 5) and window (200-2000 ms); ecg_channel is ignored
+     * @return Result of state change (InvalidTransition while monitoring)
+     */
+    StateChangeError set_pulse_correction(const dsp::PulseCorrectionSpec& spec);
+
+    const dsp::PulseCorrectionSpec& get_pulse_correction() const
+    {
+        return state_.pulse_correction;
+    }
+
+    /**
+     * Get acquisition thread counters (late wake-ups, backlogged samples, gradient template updates)
+     */
+    acquisition::AcquisitionStats get_acquisition_stats() const
+    {
+        return acquisition_->get_stats();
+    }
+
     // === READ-ONLY STATE ACCESS ===
 
     /**
@@ -289,7 +370,25 @@ class AppStateManager
     bool validate_can_change_channels(std::string& error_msg);
     bool validate_window_index(int index, std::string& error_msg);
     bool validate_amplitude_index(int index, std::string& error_msg);
+    bool validate_frame_cap_index(int index, std::string& error_msg);
     bool validate_scale(float scale, const std::string& param_name, std::string& error_msg);
+    bool validate_acquisition_format(const AcquisitionFormat& format, std::string& error_msg);
+    bool validate_gradient_correction(const dsp::GradientCorrectionSpec& spec, std::string& error_msg);
+    bool validate_pulse_correction(const dsp::PulseCorrectionSpec& spec, std::string& error_msg);
+
+    // === ACQUISITION HELPERS ===
+
+    // Calibration per amplifier channel, taken from available_channels (identity where unmapped)
+    std::vector<acquisition::ChannelCalibration> build_calibration(int channels) const;
+
+    // Filters per amplifier channel, taken from available_channels (none where unmapped or unfiltered)
+    std::vector<dsp::FilterSpec> build_filters(int channels) const;
+
+    // EEG amplifier channels, averaged into the common average reference and cleared of the pulse artifact
+    std::vector<int> build_average_channels(int channels) const;
+
+    // Amplifier channel of the first ECG/EMG channel (-1 if none is acquired)
+    int build_ecg_channel(int channels) const;
 
     // === OBSERVER NOTIFICATION ===
 
@@ -301,6 +400,8 @@ class AppStateManager
     std::vector<std::pair<ObserverHandle, StateObserver>> observers_;  // Registered observers with handles
     ObserverHandle next_handle_{0};                                    // Next observer handle to assign
     bool impedance_check_passed_{false};                               // Impedance validation flag
+    std::unique_ptr<acquisition::AcquisitionThread> acquisition_;      // Device-rate sample ingest
+    AmplifierKind amplifier_;                                          // Kind of the source owned by acquisition_
 };
 
 }  // namespace elda
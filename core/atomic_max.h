@@ -0,0 +1,75 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace elda
+{
+
+/**
+ * Raise a statistics counter to value if it is larger (relaxed CAS loop)
+ * Safe against concurrent raisers and against a reader resetting the counter:
+ * a plain load / store pair could overwrite a larger value stored in between.
+ */
+template <typename T>
+void update_max(std::atomic<T>& target, T value)
+{
+    T current = target.load(std::memory_order_relaxed);
+    while (value > current && !target.compare_exchange_weak(current, value, std::memory_order_relaxed))
+    {
+    }
+}
+
+/**
+ * UpdateTimer - durations of a recurring burst of work (a DSP stage's template update)
+ *
+ * record() runs on the producer thread; the accessors are read by the UI thread
+ * for the stage's stats(). All counters are relaxed atomics.
+ */
+class UpdateTimer
+{
+  public:
+    void record(uint64_t ns)
+    {
+        last_ns_.store(ns, std::memory_order_relaxed);
+        update_max(max_ns_, ns);
+        total_ns_.fetch_add(ns, std::memory_order_relaxed);
+        count_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void reset()
+    {
+        last_ns_.store(0, std::memory_order_relaxed);
+        max_ns_.store(0, std::memory_order_relaxed);
+        total_ns_.store(0, std::memory_order_relaxed);
+        count_.store(0, std::memory_order_relaxed);
+    }
+
+    double last_ms() const
+    {
+        return static_cast<double>(last_ns_.load(std::memory_order_relaxed)) * 1e-6;
+    }
+
+    double max_ms() const
+    {
+        return static_cast<double>(max_ns_.load(std::memory_order_relaxed)) * 1e-6;
+    }
+
+    double mean_ms() const
+    {
+        const uint64_t count = count_.load(std::memory_order_relaxed);
+        if (count == 0)
+        {
+            return 0.0;
+        }
+        return static_cast<double>(total_ns_.load(std::memory_order_relaxed)) * 1e-6 / static_cast<double>(count);
+    }
+
+  private:
+    std::atomic<uint64_t> last_ns_{0};
+    std::atomic<uint64_t> max_ns_{0};
+    std::atomic<uint64_t> total_ns_{0};
+    std::atomic<uint64_t> count_{0};
+};
+
+}  // namespace elda
@@ -6,8 +6,8 @@
 // AppState constructor implementation
 AppState::AppState()
 {
-    ch_names.reserve(CHANNELS);
-    for (int i = 0; i < CHANNELS; ++i)
+    ch_names.reserve(MAX_CHANNELS);
+    for (int i = 0; i < MAX_CHANNELS; ++i)
     {
         char b[16];
         std::snprintf(b, sizeof(b), "Ch%02d", i + 1);
@@ -1,4 +1,8 @@
 #pragma once
+#include "core/dsp/gradient_artifact.h"
+#include "core/dsp/pulse_artifact.h"
+#include "core/minmax_pyramid.h"
+#include "core/sample_ring.h"
 #include "models/channels_group.h"
 #include "models/session.h"
 
@@ -6,6 +10,7 @@
 #include <chrono>
 #include <cmath>
 #include <cstdio>
+#include <optional>
 #include <random>
 #include <string>
 #include <vector>
@@ -16,10 +21,65 @@ struct Channel;
 }
 
 // ===== App constants =====
-static constexpr int CHANNELS = 64;             // simulate 64 channels
-static constexpr float SAMPLE_RATE_HZ = 20.0f;  // 1000 Hz
-static constexpr int BUFFER_SECONDS = 25;
-static constexpr int BUFFER_SIZE = int(SAMPLE_RATE_HZ * BUFFER_SECONDS);
+static constexpr int DEFAULT_CHANNELS = 64;             // simulate 64 channels
+static constexpr float DEFAULT_SAMPLE_RATE_HZ = 20.0f;  // until a session picks its own rate
+static constexpr int MAX_CHANNELS = 136;                // NVX136
+static constexpr float MAX_SAMPLE_RATE_HZ = 25000.0f;   // NVX136 top rate
+static constexpr int BUFFER_SECONDS = 25;               // longest display window + slack
+
+// Chart stream rate when the device runs faster (AcquisitionFormat::display_rate_hz)
+static constexpr float DEFAULT_DISPLAY_RATE_HZ = 500.0f;
+
+// Ring slab layout: Planar favours per-channel chart reads, Blocked favours block ingest
+static constexpr elda::SampleLayout RING_LAYOUT = elda::SampleLayout::Planar;
+static constexpr int RING_TILE_SAMPLES = 16;  // samples per channel tile when Blocked
+
+// Where samples come from (see core/acquisition/amplifier_source.h)
+enum class AmplifierKind
+{
+    Synthetic = 0,    // in-process generator
+    SimulatedNvx136,  // NVX136 packet stream over a local pipe
+};
+
+// ----------------- Session acquisition format -----------------
+// Channel count and rate are fixed for the duration of a session and size the
+// ring, the generator and the chart when monitoring starts.
+// Worst case (136 ch @ 25 kHz) is 3.4 M samples/s and a 340 MB ring.
+// Below the device rate, the display and storage rates get their own resampled
+// streams (see core/dsp/polyphase_resampler.h) for the chart and the recorder.
+struct AcquisitionFormat
+{
+    int channels = DEFAULT_CHANNELS;
+    float sample_rate_hz = DEFAULT_SAMPLE_RATE_HZ;
+    AmplifierKind amplifier = AmplifierKind::Synthetic;
+    float display_rate_hz = DEFAULT_DISPLAY_RATE_HZ;  // Chart stream (0 = the device rate)
+    float storage_rate_hz = 0.0f;                     // Recorder stream (0 = the device rate)
+
+    int buffer_size() const
+    {
+        return buffer_size_at(sample_rate_hz);
+    }
+
+    static int buffer_size_at(float rate_hz)
+    {
+        return static_cast<int>(std::lround(rate_hz * BUFFER_SECONDS));
+    }
+
+    bool resamples_display() const
+    {
+        return display_rate_hz > 0.0f && display_rate_hz < sample_rate_hz;
+    }
+
+    bool resamples_storage() const
+    {
+        return storage_rate_hz > 0.0f && storage_rate_hz < sample_rate_hz;
+    }
+
+    double samples_per_second() const
+    {
+        return static_cast<double>(channels) * sample_rate_hz;
+    }
+};
 
 // X-window choices (sec)
 static const float WINDOW_OPTIONS[] = {1.f, 5.f, 10.f, 15.f, 20.f};
@@ -30,6 +90,10 @@ static const int AMP_PP_UV_OPTIONS[] = {10, 20, 50, 100, 200, 500, 1000};
 static constexpr int AMP_COUNT = sizeof(AMP_PP_UV_OPTIONS) / sizeof(AMP_PP_UV_OPTIONS[0]);
 static constexpr float AMP_REF_PP_UV = 100.0f;  // 100 µV pp => gain 1.0
 
+// Frame-rate caps while monitoring (Hz); idle screens only redraw on input
+static const int FRAME_CAP_OPTIONS[] = {30, 60, 120};
+static constexpr int FRAME_CAP_COUNT = sizeof(FRAME_CAP_OPTIONS) / sizeof(FRAME_CAP_OPTIONS[0]);
+
 enum class RecordingState
 {
     None = 0,
@@ -42,50 +106,6 @@ struct PauseMark
     double time_seconds;
 };
 
-// ----------------- Ring buffer with absolute timestamps -----------------
-struct Ring
-{
-    std::vector<float> t_abs;              // absolute seconds
-    std::vector<std::vector<float>> data;  // [ch][i]
-    int write = 0;
-    bool filled = false;
-    double now = 0.0;  // absolute time of next sample
-
-    Ring()
-    {
-        t_abs.resize(BUFFER_SIZE, 0.0f);
-        data.resize(CHANNELS);
-        for (int c = 0; c < CHANNELS; ++c)
-            data[c].resize(BUFFER_SIZE, 0.0f);
-    }
-
-    void reset()
-    {
-        write = 0;
-        filled = false;
-        now = 0.0;
-        std::fill(t_abs.begin(), t_abs.end(), 0.0f);
-        for (int c = 0; c < CHANNELS; ++c)
-            std::fill(data[c].begin(), data[c].end(), 0.0f);
-    }
-
-    inline void push(const std::vector<float>& s)
-    {
-        for (int c = 0; c < CHANNELS; ++c)
-            data[c][write] = s[c];
-        t_abs[write] = float(now);
-        now += 1.0 / SAMPLE_RATE_HZ;
-        write = (write + 1) % BUFFER_SIZE;
-        if (write == 0)
-            filled = true;
-    }
-
-    inline int size() const
-    {
-        return filled ? BUFFER_SIZE : write;
-    }
-};
-
 // ----------------- Precise sample scheduler (holds 1 kHz average) -----------------
 struct SampleClock
 {
@@ -121,9 +141,10 @@ struct AppState
     std::optional<elda::models::Session> current_session;
 
     // Display choices
-    int win_idx = 2;       // default 10s
-    int amp_idx = 4;       // default 200 µV
-    int last_win_idx = 2;  // track last window index for smooth transitions
+    int win_idx = 2;        // default 10s
+    int amp_idx = 4;        // default 200 µV
+    int last_win_idx = 2;   // track last window index for smooth transitions
+    int frame_cap_idx = 1;  // default 60 Hz while the sweep animates
 
     // Derived getters
     float window_sec() const
@@ -134,6 +155,10 @@ struct AppState
     {
         return AMP_PP_UV_OPTIONS[amp_idx];
     }
+    int frame_cap_hz() const
+    {
+        return FRAME_CAP_OPTIONS[frame_cap_idx];
+    }
     float gain_mul() const
     {
         return float(AMP_PP_UV_OPTIONS[amp_idx]) / AMP_REF_PP_UV;
@@ -144,8 +169,38 @@ struct AppState
     float artifact_scale = 1.0f;
 
     // Signal + time
-    Ring ring;
-    SampleClock sampler{SAMPLE_RATE_HZ};
+    AcquisitionFormat acquisition_format;  // applied to the ring when monitoring starts
+    elda::dsp::GradientCorrectionSpec gradient_correction;  // MRI sessions; applied when monitoring starts
+    elda::dsp::PulseCorrectionSpec pulse_correction;        // MRI sessions; ECG channel resolved when monitoring starts
+    elda::SampleRing ring{acquisition_format.channels,
+                          acquisition_format.buffer_size(),
+                          acquisition_format.sample_rate_hz,
+                          RING_LAYOUT,
+                          RING_TILE_SAMPLES};  // one producer
+    elda::MinMaxPyramid pyramid{ring};  // min/max summaries of ring; updated by the ring's producer
+    elda::SampleRing average_ring{1,
+                                  acquisition_format.buffer_size(),
+                                  acquisition_format.sample_rate_hz,
+                                  RING_LAYOUT,
+                                  RING_TILE_SAMPLES};  // common average of the EEG channels, same indices as ring
+
+    // Resampled streams, written by the ring's producer when the format asks for them (else left idle)
+    elda::SampleRing display_ring{acquisition_format.channels,
+                                  acquisition_format.buffer_size(),
+                                  acquisition_format.sample_rate_hz,
+                                  RING_LAYOUT,
+                                  RING_TILE_SAMPLES};  // ring at display_rate_hz: what the chart reads
+    elda::MinMaxPyramid display_pyramid{display_ring};
+    elda::SampleRing display_average_ring{1,
+                                          acquisition_format.buffer_size(),
+                                          acquisition_format.sample_rate_hz,
+                                          RING_LAYOUT,
+                                          RING_TILE_SAMPLES};  // average_ring at display_rate_hz
+    elda::SampleRing storage_ring{acquisition_format.channels,
+                                  acquisition_format.buffer_size(),
+                                  acquisition_format.sample_rate_hz,
+                                  RING_LAYOUT,
+                                  RING_TILE_SAMPLES};  // ring at storage_rate_hz: what the recorder drains
 
     // ===== Display clock driven by a playhead (freezes when NOT monitoring) =====
     std::chrono::steady_clock::time_point last_tick = std::chrono::steady_clock::now();
@@ -195,139 +250,6 @@ struct AppState
     }
 };
 
-// ----------------- Synthetic EEG generator -----------------
-struct SynthEEG
-{
-    std::mt19937 rng{std::random_device{}()};
-    std::normal_distribution<float> norm_dist{0.0f, 1.0f};
-    std::uniform_real_distribution<float> uni_01{0.0f, 1.0f};
-
-    // Per-channel baseline noise
-    std::vector<float> bl_noise;
-
-    // Oscillators
-    float ph_alpha[CHANNELS], ph_beta[CHANNELS], ph_theta[CHANNELS];
-    float drift = 0.0f;
-    float drift_target = 0.0f;
-    float drift_timer = 0.0f;
-
-    // Eye blink
-    float blink_phase = 0.0f;
-    float blink_active = 0.0f;
-
-    // Burst
-    float burst_phase = 0.0f;
-    float burst_amplitude = 0.0f;
-    float burst_timer = 0.0f;
-
-    // Spike
-    float spike_timer = 0.0f;
-    float spike_amp = 0.0f;
-
-    SynthEEG()
-    {
-        bl_noise.resize(CHANNELS, 0.0f);
-        for (int c = 0; c < CHANNELS; ++c)
-        {
-            ph_alpha[c] = uni_01(rng) * 6.283f;
-            ph_beta[c] = uni_01(rng) * 6.283f;
-            ph_theta[c] = uni_01(rng) * 6.283f;
-        }
-    }
-
-    void next(std::vector<float>& out)
-    {
-        if (out.size() != (size_t)CHANNELS)
-            out.resize(CHANNELS);
-
-        // Global drift
-        drift_timer -= 1.0f / SAMPLE_RATE_HZ;
-        if (drift_timer <= 0.0f)
-        {
-            drift_target = (uni_01(rng) - 0.5f) * 4.0f;
-            drift_timer = 2.0f + uni_01(rng) * 3.0f;
-        }
-        drift += 0.02f * (drift_target - drift);
-
-        // Eye blink
-        if (uni_01(rng) < 0.0001f)
-        {
-            blink_active = 1.0f;
-            blink_phase = 0.0f;
-        }
-        if (blink_active > 0.0f)
-        {
-            blink_phase += (2.0f * 3.14159f) / (0.15f * SAMPLE_RATE_HZ);
-            if (blink_phase >= 3.14159f)
-            {
-                blink_active = 0.0f;
-                blink_phase = 0.0f;
-            }
-        }
-        float blink = (blink_active > 0.0f) ? 40.0f * std::sin(blink_phase) : 0.0f;
-
-        // Burst
-        burst_timer -= 1.0f / SAMPLE_RATE_HZ;
-        if (burst_timer <= 0.0f && uni_01(rng) < 0.002f)
-        {
-            burst_amplitude = 20.0f + uni_01(rng) * 30.0f;
-            burst_timer = 0.3f + uni_01(rng) * 0.5f;
-            burst_phase = 0.0f;
-        }
-        float burst = 0.0f;
-        if (burst_timer > 0.0f)
-        {
-            burst_phase += (2.0f * 3.14159f * 15.0f) / SAMPLE_RATE_HZ;
-            burst = burst_amplitude * std::sin(burst_phase) * std::exp(-5.0f * (1.0f - (burst_timer / (0.3f + 0.5f))));
-        }
-
-        // Spike
-        spike_timer -= 1.0f / SAMPLE_RATE_HZ;
-        if (spike_timer <= 0.0f && uni_01(rng) < 0.0005f)
-        {
-            spike_amp = 50.0f + uni_01(rng) * 50.0f;
-            spike_timer = 0.05f;
-        }
-        float spike = 0.0f;
-        if (spike_timer > 0.0f)
-        {
-            float t = 1.0f - (spike_timer / 0.05f);
-            spike = spike_amp * (t < 0.5f ? t * 2.0f : 2.0f * (1.0f - t));
-        }
-
-        // 50 Hz mains
-        static float mains_phase = 0.0f;
-        mains_phase += (2.0f * 3.14159f * 50.0f) / SAMPLE_RATE_HZ;
-        if (mains_phase > 6.28f)
-            mains_phase -= 6.28f;
-        float mains = 0.5f * std::sin(mains_phase);
-
-        // Per-channel
-        for (int c = 0; c < CHANNELS; ++c)
-        {
-            float alpha = 8.0f * std::sin(ph_alpha[c]);
-            float beta = 4.0f * std::sin(ph_beta[c]);
-            float theta = 6.0f * std::sin(ph_theta[c]);
-
-            ph_alpha[c] += (2.0f * 3.14159f * 10.0f) / SAMPLE_RATE_HZ;
-            ph_beta[c] += (2.0f * 3.14159f * 20.0f) / SAMPLE_RATE_HZ;
-            ph_theta[c] += (2.0f * 3.14159f * 5.0f) / SAMPLE_RATE_HZ;
-
-            bl_noise[c] += 0.02f * (norm_dist(rng) - bl_noise[c]);
-
-            float blink_mul = (c < 8) ? 1.5f : 0.3f;
-            float y = drift + alpha + beta + theta + bl_noise[c] + mains + blink_mul * blink + burst + spike;
-
-            if (uni_01(rng) < 2e-6f)
-            {
-                y += (uni_01(rng) - 0.5f) * 8.0f;
-            }
-
-            out[c] = y;
-        }
-    }
-};
-
 // Small helpers for header +/- buttons
 inline void dec_idx(int& idx, int /*count*/)
 {
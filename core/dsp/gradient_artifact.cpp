@@ -0,0 +1,410 @@
+#include "gradient_artifact.h"
+
+#include "core/simd.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+namespace elda::dsp
+{
+
+namespace
+{
+// Template memory cap (stored epochs); long TRs at high rates get fewer epochs
+constexpr size_t k_max_template_bytes = size_t{256} << 20;
+
+using clock = std::chrono::steady_clock;
+
+// Catmull-Rom weights of the samples at i - 1, i, i + 1, i + 2 for a position i + t, t in [0, 1]
+void catmull_rom_weights(float t, float w[4])
+{
+    const float t2 = t * t;
+    const float t3 = t2 * t;
+    w[0] = 0.5f * (-t3 + 2.0f * t2 - t);
+    w[1] = 0.5f * (3.0f * t3 - 5.0f * t2 + 2.0f);
+    w[2] = 0.5f * (-3.0f * t3 + 4.0f * t2 + t);
+    w[3] = 0.5f * (t3 - t2);
+}
+
+// out[k] = sum_m w[m] * src[k + m], k in [0, count)
+void interpolate(const float* src, const float w[4], int count, float* out)
+{
+    using namespace simd;
+    const f32x4 w0 = set1(w[0]);
+    const f32x4 w1 = set1(w[1]);
+    const f32x4 w2 = set1(w[2]);
+    const f32x4 w3 = set1(w[3]);
+    int k = 0;
+    for (; k + 4 <= count; k += 4)
+    {
+        f32x4 acc = mul(w0, load(src + k));
+        acc = madd(w1, load(src + k + 1), acc);
+        acc = madd(w2, load(src + k + 2), acc);
+        acc = madd(w3, load(src + k + 3), acc);
+        store(out + k, acc);
+    }
+    for (; k < count; ++k)
+    {
+        out[k] = w[0] * src[k] + w[1] * src[k + 1] + w[2] * src[k + 2] + w[3] * src[k + 3];
+    }
+}
+
+uint64_t elapsed_ns(clock::time_point since)
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - since).count());
+}
+}  // namespace
+
+void GradientArtifactCorrector::configure(const GradientCorrectionSpec& spec,
+                                          const std::vector<int>& channels,
+                                          double sample_rate_hz)
+{
+    active_ = false;
+    channels_.clear();
+    period_ = spec.tr_ms * sample_rate_hz / 1000.0;
+    if (!spec.enabled || !(period_ >= 2.0))
+    {
+        return;
+    }
+    trigger_channel_ = spec.trigger_channel;
+    trigger_level_ = spec.trigger_level;
+    for (const int channel : channels)
+    {
+        if (channel >= 0 && channel != trigger_channel_)
+        {
+            channels_.push_back(channel);
+        }
+    }
+    if (channels_.empty())
+    {
+        return;
+    }
+
+    const size_t count = channels_.size();
+    length_ = static_cast<int>(std::ceil(period_)) + 1;
+    history_ = length_ + 4;
+
+    const size_t epoch_bytes = count * static_cast<size_t>(length_) * sizeof(float);
+    const int memory_epochs = static_cast<int>(std::max<size_t>(1, k_max_template_bytes / epoch_bytes));
+    epochs_ = std::max(k_min_epochs, std::min(spec.epochs, memory_epochs));
+    if (epochs_ < spec.epochs)
+    {
+        std::printf("[Gradient] Template window capped at %d volumes (%.1f MiB each)\n",
+                    epochs_,
+                    static_cast<double>(epoch_bytes) / (1 << 20));
+    }
+
+    raw_ = AlignedBuffer<float>(count * static_cast<size_t>(history_));
+    stored_ = AlignedBuffer<float>(static_cast<size_t>(epochs_) * count * static_cast<size_t>(length_));
+    sums_.assign(count * static_cast<size_t>(length_), 0.0);
+    mean_ = AlignedBuffer<float>(count * static_cast<size_t>(length_ + 3));
+    shifted_ = AlignedBuffer<float>(count * static_cast<size_t>(length_));
+    scratch_.assign(static_cast<size_t>(2 * length_ + 3), 0.0f);
+    filled_ = 0;
+    next_slot_ = 0;
+    in_epoch_ = false;
+    epoch_length_ = 0;
+    pending_count_ = 0;
+    started_ = false;
+    trigger_valid_ = false;
+    refractory_end_ = 0;
+    tr_work_ns_ = 0;
+
+    volumes_.store(0, std::memory_order_relaxed);
+    template_epochs_.store(0, std::memory_order_relaxed);
+    updates_.reset();
+    active_ = true;
+}
+
+GradientCorrectionStats GradientArtifactCorrector::stats() const
+{
+    GradientCorrectionStats stats;
+    stats.volumes = volumes_.load(std::memory_order_relaxed);
+    stats.template_epochs = template_epochs_.load(std::memory_order_relaxed);
+    stats.last_update_ms = updates_.last_ms();
+    stats.max_update_ms = updates_.max_ms();
+    stats.mean_update_ms = updates_.mean_ms();
+    return stats;
+}
+
+// ===== PROCESSING =====
+
+void GradientArtifactCorrector::process(uint64_t first, float* data, size_t channel_stride, int count)
+{
+    if (!active_ || count <= 0)
+    {
+        return;
+    }
+    if (!started_ || first != next_index_)
+    {
+        restart(first);
+    }
+
+    const float* trigger =
+        trigger_channel_ >= 0 ? data + static_cast<size_t>(trigger_channel_) * channel_stride : nullptr;
+    int trigger_at = -1;  // Next crossing in this block (count = none; -1 = not searched yet)
+    double trigger_onset = 0.0;
+
+    int pos = 0;
+    while (pos < count)
+    {
+        const uint64_t index = first + static_cast<uint64_t>(pos);
+
+        // Epochs whose last raw sample is in are folded before the next onset builds its template
+        for (int p = 0; p < pending_count_;)
+        {
+            if (pending_[p].start + static_cast<uint64_t>(length_) + 1 <= index)
+            {
+                fold_epoch(pending_[p]);
+                std::copy(pending_ + p + 1, pending_ + pending_count_, pending_ + p);
+                --pending_count_;
+                continue;
+            }
+            ++p;
+        }
+
+        // Volume onset at this sample
+        int end = count;
+        if (trigger)
+        {
+            if (trigger_at < pos)
+            {
+                trigger_at = find_trigger(trigger, first, pos, count, trigger_onset);
+            }
+            if (trigger_at == pos)
+            {
+                begin_epoch(index, trigger_onset);
+                refractory_end_ = index + static_cast<uint64_t>(period_ * 0.5);
+                trigger_at = find_trigger(trigger, first, pos + 1, count, trigger_onset);
+            }
+            end = std::min(end, trigger_at);
+        }
+        else
+        {
+            auto start = static_cast<uint64_t>(std::ceil(next_onset_));
+            if (start == index)
+            {
+                begin_epoch(index, next_onset_);
+                next_onset_ += period_;
+                start = static_cast<uint64_t>(std::ceil(next_onset_));
+            }
+            end = static_cast<int>(std::min<uint64_t>(static_cast<uint64_t>(end), start - first));
+        }
+        for (int p = 0; p < pending_count_; ++p)
+        {
+            const uint64_t due = pending_[p].start + static_cast<uint64_t>(length_) + 1;
+            end = static_cast<int>(std::min<uint64_t>(static_cast<uint64_t>(end), due - first));
+        }
+
+        // Raw samples are kept before they are corrected
+        const int run = end - pos;
+        record(data + pos, channel_stride, index, run);
+        subtract(data + pos, channel_stride, index, run);
+        pos = end;
+    }
+
+    next_index_ = first + static_cast<uint64_t>(count);
+    if (trigger)
+    {
+        last_trigger_ = trigger[count - 1];
+        trigger_valid_ = true;
+    }
+}
+
+void GradientArtifactCorrector::restart(uint64_t first)
+{
+    // Epochs spanning skipped frames have no raw samples; the template and the current epoch stay valid
+    pending_count_ = 0;
+    history_start_ = first;
+    next_index_ = first;
+    trigger_valid_ = false;
+    if (!started_)
+    {
+        next_onset_ = static_cast<double>(first);
+        started_ = true;
+        return;
+    }
+    while (std::ceil(next_onset_) < static_cast<double>(first))
+    {
+        next_onset_ += period_;
+    }
+}
+
+int GradientArtifactCorrector::find_trigger(const float* trigger, uint64_t first, int from, int to, double& onset)
+    const
+{
+    for (int k = from; k < to; ++k)
+    {
+        if (k == 0 && !trigger_valid_)
+        {
+            continue;
+        }
+        const float previous = k == 0 ? last_trigger_ : trigger[k - 1];
+        const float current = trigger[k];
+        const uint64_t index = first + static_cast<uint64_t>(k);
+        if (previous < trigger_level_ && current >= trigger_level_ && index >= refractory_end_)
+        {
+            // Crossing interpolated between the two samples: onset in (k - 1, k]
+            const double fraction =
+                static_cast<double>(trigger_level_ - previous) / static_cast<double>(current - previous);
+            onset = static_cast<double>(index) - 1.0 + fraction;
+            return k;
+        }
+    }
+    return to;
+}
+
+void GradientArtifactCorrector::begin_epoch(uint64_t start, double onset)
+{
+    volumes_.fetch_add(1, std::memory_order_relaxed);
+
+    // The work since the previous onset is this TR's template update
+    if (tr_work_ns_ > 0)
+    {
+        updates_.record(tr_work_ns_);
+        tr_work_ns_ = 0;
+    }
+
+    const float delay = std::clamp(static_cast<float>(static_cast<double>(start) - onset), 0.0f, 1.0f);
+    if (pending_count_ == k_max_pending)
+    {
+        std::copy(pending_ + 1, pending_ + pending_count_, pending_);
+        --pending_count_;
+    }
+    pending_[pending_count_++] = {start, delay};
+
+    in_epoch_ = true;
+    epoch_start_ = start;
+    delay_ = delay;
+    shift_template();
+}
+
+void GradientArtifactCorrector::fold_epoch(const PendingEpoch& epoch)
+{
+    const auto began = clock::now();
+    const int count = static_cast<int>(channels_.size());
+    const int padded = length_ + 3;
+
+    // Epoch sample j sits at onset + j = (start + j - 1) + (1 - delay): raw samples [start - 2, start + length_]
+    float w[4];
+    catmull_rom_weights(1.0f - epoch.delay, w);
+    float* raw = scratch_.data();
+    float* resampled = scratch_.data() + padded;
+
+    const int window = std::min(filled_ + 1, epochs_);
+    const double scale = 1.0 / static_cast<double>(window);
+    for (int c = 0; c < count; ++c)
+    {
+        const float* history = raw_.data() + static_cast<size_t>(c) * static_cast<size_t>(history_);
+        // Samples before the first recorded one are clamped to it
+        const int clamped = static_cast<int>(std::min<uint64_t>(
+            static_cast<uint64_t>(padded), std::max(history_start_ + 2, epoch.start) - epoch.start));
+        const uint64_t from = epoch.start + static_cast<uint64_t>(clamped) - 2;
+        const auto at = static_cast<int>(from % static_cast<uint64_t>(history_));
+        const int head = std::min(padded - clamped, history_ - at);
+        std::memcpy(raw + clamped, history + at, static_cast<size_t>(head) * sizeof(float));
+        std::memcpy(raw + clamped + head, history, static_cast<size_t>(padded - clamped - head) * sizeof(float));
+        std::fill_n(raw, clamped, raw[std::min(clamped, padded - 1)]);
+        interpolate(raw, w, length_, resampled);
+
+        // Sliding window: the slot's previous epoch (zeros until the window is full) leaves the sums
+        float* slot = stored_.data() + (static_cast<size_t>(next_slot_) * static_cast<size_t>(count) + c) *
+                                           static_cast<size_t>(length_);
+        double* sums = sums_.data() + static_cast<size_t>(c) * static_cast<size_t>(length_);
+        float* mean = mean_.data() + static_cast<size_t>(c) * static_cast<size_t>(padded);
+        for (int j = 0; j < length_; ++j)
+        {
+            sums[j] += static_cast<double>(resampled[j]) - static_cast<double>(slot[j]);
+            mean[j + 1] = static_cast<float>(sums[j] * scale);
+        }
+        std::memcpy(slot, resampled, static_cast<size_t>(length_) * sizeof(float));
+        mean[0] = mean[1];
+        mean[length_ + 1] = mean[length_];
+        mean[length_ + 2] = mean[length_];
+    }
+    next_slot_ = (next_slot_ + 1) % epochs_;
+    filled_ = window;
+    template_epochs_.store(filled_, std::memory_order_relaxed);
+    tr_work_ns_ += elapsed_ns(began);
+
+    // The epoch in progress switches to the updated template
+    if (in_epoch_)
+    {
+        shift_template();
+    }
+}
+
+void GradientArtifactCorrector::shift_template()
+{
+    if (filled_ < k_min_epochs)
+    {
+        epoch_length_ = 0;
+        return;
+    }
+    const auto began = clock::now();
+
+    // Sample start + k sits at template position k + delay
+    float w[4];
+    catmull_rom_weights(delay_, w);
+    const int padded = length_ + 3;
+    const size_t count = channels_.size();
+    for (size_t c = 0; c < count; ++c)
+    {
+        interpolate(mean_.data() + c * static_cast<size_t>(padded),
+                    w,
+                    length_ - 1,
+                    shifted_.data() + c * static_cast<size_t>(length_));
+    }
+    epoch_length_ = length_ - 1;
+    tr_work_ns_ += elapsed_ns(began);
+}
+
+void GradientArtifactCorrector::record(const float* data, size_t channel_stride, uint64_t index, int count)
+{
+    const auto history = static_cast<uint64_t>(history_);
+    const int skip = std::max(0, count - history_);  // Only the newest history_ samples are kept
+    index += static_cast<uint64_t>(skip);
+    data += skip;
+    count -= skip;
+
+    const auto slot = static_cast<int>(index % history);
+    const int head = std::min(count, history_ - slot);
+    for (size_t c = 0; c < channels_.size(); ++c)
+    {
+        const float* src = data + static_cast<size_t>(channels_[c]) * channel_stride;
+        float* dst = raw_.data() + c * static_cast<size_t>(history_);
+        std::memcpy(dst + slot, src, static_cast<size_t>(head) * sizeof(float));
+        std::memcpy(dst, src + head, static_cast<size_t>(count - head) * sizeof(float));
+    }
+}
+
+void GradientArtifactCorrector::subtract(float* data, size_t channel_stride, uint64_t index, int count) const
+{
+    using namespace simd;
+
+    if (!in_epoch_ || index < epoch_start_ || index - epoch_start_ >= static_cast<uint64_t>(epoch_length_))
+    {
+        return;  // Before the first onset, past the template, or too few volumes yet
+    }
+    const auto offset = static_cast<int>(index - epoch_start_);
+    const int n = std::min(count, epoch_length_ - offset);
+    for (size_t c = 0; c < channels_.size(); ++c)
+    {
+        float* dst = data + static_cast<size_t>(channels_[c]) * channel_stride;
+        const float* artifact = shifted_.data() + c * static_cast<size_t>(length_) + offset;
+        int k = 0;
+        for (; k + 4 <= n; k += 4)
+        {
+            store(dst + k, sub(load(dst + k), load(artifact + k)));
+        }
+        for (; k < n; ++k)
+        {
+            dst[k] -= artifact[k];
+        }
+    }
+}
+
+}  // namespace elda::dsp
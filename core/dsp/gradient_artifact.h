@@ -0,0 +1,158 @@
+#pragma once
+
+#include "core/aligned_buffer.h"
+#include "core/atomic_max.h"
+#include "core/sample_ring.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace elda::dsp
+{
+
+/**
+ * MRI gradient artifact correction of one session (enabled = false: stage off)
+ */
+struct GradientCorrectionSpec
+{
+    bool enabled = false;
+    double tr_ms = 2000.0;        // Volume repetition time: epoch length, and the onset period without a trigger
+    int trigger_channel = -1;     // Ring channel carrying the volume trigger (-1 = onsets every tr_ms)
+    float trigger_level = 0.5f;   // Rising edge through this level marks an onset (trigger channel units)
+    int epochs = 20;              // Volumes averaged into each channel's template (sliding window)
+};
+
+/**
+ * Counters of the correction stage (cumulative since configure())
+ */
+struct GradientCorrectionStats
+{
+    uint64_t volumes = 0;         // Onsets seen
+    int template_epochs = 0;      // Volumes in the current templates
+    double last_update_ms = 0.0;  // Template work of the last TR (epoch fold + aligned template)
+    double max_update_ms = 0.0;
+    double mean_update_ms = 0.0;
+};
+
+/**
+ * GradientArtifactCorrector - online average artifact subtraction (AAS) for EEG recorded during fMRI
+ *
+ * Every volume the scanner's gradients add the same large waveform, locked to
+ * the volume onset. Onsets come from a rising edge on a trigger channel (the
+ * crossing is interpolated between samples) or from the tr_ms period. Neither
+ * falls on the sample grid, so each epoch is re-sampled onto its onset with a
+ * 4-tap Catmull-Rom interpolator before it enters the template, and the template
+ * is shifted back onto the next epoch's grid when that epoch starts.
+ *
+ * The template of each channel is the mean of the last `epochs` volumes
+ * (a sliding window; double running sums). An epoch is folded in once its
+ * last sample (plus the interpolator's two) has arrived, i.e. two samples into
+ * the next volume, which then switches to the updated template. Samples are
+ * corrected as they arrive, so the stage adds no latency. The per-volume work
+ * (fold + shift, O(channels x TR samples)) runs in one burst on the producer
+ * thread and is reported in stats().
+ *
+ * Runs as a ring stage ahead of the filters, so the filters see the cleaned
+ * signal. Frames the ring skipped restart onset tracking; templates are kept.
+ *
+ * Threading contract: configure() while the producer is stopped; process() on
+ * the producer thread; stats() from any thread.
+ */
+class GradientArtifactCorrector final : public IRingStage
+{
+  public:
+    // Volumes a template needs before it is subtracted
+    static constexpr int k_min_epochs = 4;
+
+    /**
+     * Size the templates and clear all state
+     * @param channels Ring channels to correct (the trigger channel is skipped)
+     */
+    void configure(const GradientCorrectionSpec& spec, const std::vector<int>& channels, double sample_rate_hz);
+
+    bool active() const
+    {
+        return active_;
+    }
+
+    // Samples per template (TR samples rounded up, + 1)
+    int template_length() const
+    {
+        return length_;
+    }
+
+    int epochs() const
+    {
+        return epochs_;
+    }
+
+    void process(uint64_t first, float* data, size_t channel_stride, int count) override;
+
+    GradientCorrectionStats stats() const;
+
+  private:
+    struct PendingEpoch
+    {
+        uint64_t start = 0;  // First sample at or after the onset
+        float delay = 0.0f;  // start - onset, [0, 1)
+    };
+
+    static constexpr int k_max_pending = 4;
+
+    void restart(uint64_t first);
+    int find_trigger(const float* trigger, uint64_t first, int from, int to, double& onset) const;
+    void begin_epoch(uint64_t start, double onset);
+    void fold_epoch(const PendingEpoch& epoch);
+    void shift_template();
+    void record(const float* data, size_t channel_stride, uint64_t index, int count);
+    void subtract(float* data, size_t channel_stride, uint64_t index, int count) const;
+
+    // Configuration
+    bool active_ = false;
+    std::vector<int> channels_;
+    int trigger_channel_ = -1;
+    float trigger_level_ = 0.0f;
+    double period_ = 0.0;  // TR in samples
+    int length_ = 0;       // Template samples
+    int history_ = 0;      // Raw samples kept per channel (length_ + 4)
+    int epochs_ = 0;
+
+    // Raw (uncorrected) recent samples per channel, circular by absolute index
+    AlignedBuffer<float> raw_;
+    uint64_t next_index_ = 0;     // Index expected at the next process()
+    uint64_t history_start_ = 0;  // Oldest index raw_ holds valid data for
+    bool started_ = false;
+
+    // Sliding template: stored epochs, their sums and the mean padded by one sample each side (+2 after)
+    AlignedBuffer<float> stored_;  // epochs_ x channels x length_
+    std::vector<double> sums_;     // channels x length_
+    AlignedBuffer<float> mean_;    // channels x (length_ + 3)
+    int filled_ = 0;
+    int next_slot_ = 0;
+    std::vector<float> scratch_;   // Raw window (length_ + 3) and resampled epoch of one channel
+
+    // Current epoch: template shifted onto its sample grid
+    AlignedBuffer<float> shifted_;  // channels x length_
+    bool in_epoch_ = false;
+    uint64_t epoch_start_ = 0;
+    float delay_ = 0.0f;
+    int epoch_length_ = 0;          // Valid shifted samples (0 = nothing subtracted)
+
+    // Onset tracking
+    PendingEpoch pending_[k_max_pending];
+    int pending_count_ = 0;
+    double next_onset_ = 0.0;  // Period mode
+    uint64_t refractory_end_ = 0;
+    float last_trigger_ = 0.0f;  // Last trigger sample of the previous block
+    bool trigger_valid_ = false;
+
+    // Per-TR work, published for stats()
+    uint64_t tr_work_ns_ = 0;
+    std::atomic<uint64_t> volumes_{0};
+    std::atomic<int> template_epochs_{0};
+    UpdateTimer updates_;
+};
+
+}  // namespace elda::dsp
@@ -0,0 +1,330 @@
+#include "iir_filter_bank.h"
+
+#include "core/simd.h"
+#include "models/channel.h"
+
+#include <cmath>
+#include <map>
+#include <mutex>
+#include <tuple>
+#include <utility>
+
+namespace elda::dsp
+{
+
+namespace
+{
+constexpr double k_pi = 3.14159265358979323846264338327950;
+constexpr double k_max_cutoff_ratio = 0.45;  // Stages at or above this fraction of the rate are dropped
+constexpr double k_notch_q = 30.0;           // ~1.7 Hz wide at 50 Hz
+
+// Fourth-order Butterworth as two biquads: Q = 1 / (2 cos(theta)), theta = pi/8, 3 pi/8
+constexpr double k_butterworth_q[2] = {0.54119610014619698, 1.30656296487637652};
+
+bool in_band(double hz, double sample_rate_hz)
+{
+    return hz > 0.0 && hz < k_max_cutoff_ratio * sample_rate_hz;
+}
+
+// Bilinear transform of (s / w) / (1 + s / w), pre-warped at the cutoff
+BiquadSection first_order_high_pass(double hz, double sample_rate_hz)
+{
+    const double k = std::tan(k_pi * hz / sample_rate_hz);
+    BiquadSection section;
+    section.b0 = 1.0 / (1.0 + k);
+    section.b1 = -section.b0;
+    section.a1 = (k - 1.0) / (k + 1.0);
+    return section;
+}
+
+BiquadSection low_pass(double hz, double sample_rate_hz, double q)
+{
+    const double w0 = 2.0 * k_pi * hz / sample_rate_hz;
+    const double cos_w0 = std::cos(w0);
+    const double alpha = std::sin(w0) / (2.0 * q);
+    const double a0 = 1.0 + alpha;
+    BiquadSection section;
+    section.b0 = (1.0 - cos_w0) / (2.0 * a0);
+    section.b1 = (1.0 - cos_w0) / a0;
+    section.b2 = section.b0;
+    section.a1 = -2.0 * cos_w0 / a0;
+    section.a2 = (1.0 - alpha) / a0;
+    return section;
+}
+
+BiquadSection notch(double hz, double sample_rate_hz, double q)
+{
+    const double w0 = 2.0 * k_pi * hz / sample_rate_hz;
+    const double cos_w0 = std::cos(w0);
+    const double alpha = std::sin(w0) / (2.0 * q);
+    const double a0 = 1.0 + alpha;
+    BiquadSection section;
+    section.b0 = 1.0 / a0;
+    section.b1 = -2.0 * cos_w0 / a0;
+    section.b2 = section.b0;
+    section.a1 = section.b1;
+    section.a2 = (1.0 - alpha) / a0;
+    return section;
+}
+
+struct SectionLanes
+{
+    simd::f64x2 b0, b1, b2, a1, a2;
+};
+
+// One transposed direct form II step: x in, y out; s1 / s2 carry the state
+inline simd::f64x2 step(const SectionLanes& c, simd::f64x2 x, simd::f64x2& s1, simd::f64x2& s2)
+{
+    using namespace simd;
+    const f64x2 y = madd(c.b0, x, s1);
+    s1 = add(sub(mul(c.b1, x), mul(c.a1, y)), s2);
+    s2 = sub(mul(c.b2, x), mul(c.a2, y));
+    return y;
+}
+}  // namespace
+
+FilterSpec filter_for(const models::Channel& channel)
+{
+    FilterSpec spec;
+    if (channel.filtered)
+    {
+        spec.high_pass_hz = channel.high_pass_cutoff;
+        spec.low_pass_hz = channel.low_pass_cutoff;
+        spec.notch_hz = channel.notch_frequency;
+    }
+    return spec;
+}
+
+// ===== FilterDesign =====
+
+std::shared_ptr<const FilterDesign> FilterDesign::plan(double sample_rate_hz, const FilterSpec& spec)
+{
+    using Key = std::tuple<double, double, double, double>;
+    static std::mutex mutex;
+    static std::map<Key, std::shared_ptr<const FilterDesign>> designs;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    std::shared_ptr<const FilterDesign>& design =
+        designs[Key{sample_rate_hz, spec.high_pass_hz, spec.low_pass_hz, spec.notch_hz}];
+    if (!design)
+    {
+        design = std::make_shared<const FilterDesign>(sample_rate_hz, spec);
+    }
+    return design;
+}
+
+FilterDesign::FilterDesign(double sample_rate_hz, const FilterSpec& spec)
+{
+    // High-pass first: the later sections then never see the electrode offset
+    if (in_band(spec.high_pass_hz, sample_rate_hz))
+    {
+        sections_.push_back(first_order_high_pass(spec.high_pass_hz, sample_rate_hz));
+    }
+    if (in_band(spec.notch_hz, sample_rate_hz))
+    {
+        sections_.push_back(notch(spec.notch_hz, sample_rate_hz, k_notch_q));
+    }
+    if (in_band(spec.low_pass_hz, sample_rate_hz))
+    {
+        for (const double q : k_butterworth_q)
+        {
+            sections_.push_back(low_pass(spec.low_pass_hz, sample_rate_hz, q));
+        }
+    }
+}
+
+// ===== IirFilterBank =====
+
+void IirFilterBank::configure(const std::vector<FilterSpec>& channels, double sample_rate_hz)
+{
+    channels_ = static_cast<int>(channels.size());
+    designs_.clear();
+    groups_.clear();
+
+    // Channels per distinct design, in channel order
+    std::vector<std::vector<int>> members;
+    for (int c = 0; c < channels_; ++c)
+    {
+        std::shared_ptr<const FilterDesign> design = FilterDesign::plan(sample_rate_hz, channels[c]);
+        if (design->empty())
+        {
+            continue;
+        }
+        size_t index = 0;
+        while (index < designs_.size() && designs_[index] != design)
+        {
+            ++index;
+        }
+        if (index == designs_.size())
+        {
+            designs_.push_back(std::move(design));
+            members.emplace_back();
+        }
+        members[index].push_back(c);
+    }
+
+    size_t state = 0;
+    for (size_t d = 0; d < designs_.size(); ++d)
+    {
+        const std::vector<int>& group_channels = members[d];
+        for (size_t first = 0; first < group_channels.size(); first += k_lanes)
+        {
+            LaneGroup group;
+            for (int lane = 0; lane < k_lanes; ++lane)
+            {
+                const size_t member = first + static_cast<size_t>(lane);
+                group.channels[lane] = member < group_channels.size() ? group_channels[member] : -1;
+            }
+            group.design = designs_[d].get();
+            group.state = state;
+            state += group.design->sections().size() * 2 * k_lanes;
+            groups_.push_back(group);
+        }
+    }
+
+    state_ = AlignedBuffer<double>(state);
+    primed_ = false;
+}
+
+void IirFilterBank::reset()
+{
+    state_.fill(0.0);
+    primed_ = false;
+}
+
+void IirFilterBank::process(uint64_t /*first*/, float* data, size_t channel_stride, int count)
+{
+    if (count <= 0 || groups_.empty())
+    {
+        return;
+    }
+    if (!primed_)
+    {
+        for (const LaneGroup& group : groups_)
+        {
+            prime(group, data, channel_stride);
+        }
+        primed_ = true;
+    }
+    for (const LaneGroup& group : groups_)
+    {
+        filter_group(group, data, channel_stride, count);
+    }
+}
+
+void IirFilterBank::prime(const LaneGroup& group, const float* data, size_t channel_stride)
+{
+    // Steady state for a constant input: y = H(1) x in every section
+    double* state = state_.data() + group.state;
+    for (int lane = 0; lane < k_lanes; ++lane)
+    {
+        const int channel = group.channels[lane];
+        double x = channel >= 0 ? data[static_cast<size_t>(channel) * channel_stride] : 0.0;
+        for (const BiquadSection& section : group.design->sections())
+        {
+            const double y = section.dc_gain() * x;
+            const double s2 = section.b2 * x - section.a2 * y;
+            state[lane] = section.b1 * x - section.a1 * y + s2;
+            state[k_lanes + lane] = s2;
+            state += 2 * k_lanes;
+            x = y;
+        }
+        state = state_.data() + group.state;
+    }
+}
+
+void IirFilterBank::filter_group(const LaneGroup& group, float* data, size_t channel_stride, int count)
+{
+    using namespace simd;
+
+    const std::vector<BiquadSection>& sections = group.design->sections();
+    const int section_count = static_cast<int>(sections.size());
+
+    SectionLanes coefficients[FilterDesign::k_max_sections];
+    f64x2 s1_lo[FilterDesign::k_max_sections];
+    f64x2 s1_hi[FilterDesign::k_max_sections];
+    f64x2 s2_lo[FilterDesign::k_max_sections];
+    f64x2 s2_hi[FilterDesign::k_max_sections];
+    double* state = state_.data() + group.state;
+    for (int s = 0; s < section_count; ++s)
+    {
+        const BiquadSection& section = sections[s];
+        coefficients[s] = {set1_f64(section.b0),
+                           set1_f64(section.b1),
+                           set1_f64(section.b2),
+                           set1_f64(section.a1),
+                           set1_f64(section.a2)};
+        double* section_state = state + static_cast<size_t>(s) * 2 * k_lanes;
+        s1_lo[s] = load_f64(section_state);
+        s1_hi[s] = load_f64(section_state + 2);
+        s2_lo[s] = load_f64(section_state + k_lanes);
+        s2_hi[s] = load_f64(section_state + k_lanes + 2);
+    }
+
+    // One sample of the four channels through the cascade, two lanes per f64x2
+    auto cascade = [&](f32x4 x)
+    {
+        f64x2 lo = widen_lo(x);
+        f64x2 hi = widen_hi(x);
+        for (int s = 0; s < section_count; ++s)
+        {
+            lo = step(coefficients[s], lo, s1_lo[s], s2_lo[s]);
+            hi = step(coefficients[s], hi, s1_hi[s], s2_hi[s]);
+        }
+        return narrow(lo, hi);
+    };
+
+    // Padding lanes read and write a scratch row
+    alignas(16) float padding[4] = {};
+    float* rows[k_lanes];
+    size_t steps[k_lanes];
+    for (int lane = 0; lane < k_lanes; ++lane)
+    {
+        const int channel = group.channels[lane];
+        rows[lane] = channel >= 0 ? data + static_cast<size_t>(channel) * channel_stride : padding;
+        steps[lane] = channel >= 0 ? 1 : 0;
+    }
+
+    int k = 0;
+    for (; k + 4 <= count; k += 4)
+    {
+        f32x4 r0 = load(rows[0] + k * steps[0]);
+        f32x4 r1 = load(rows[1] + k * steps[1]);
+        f32x4 r2 = load(rows[2] + k * steps[2]);
+        f32x4 r3 = load(rows[3] + k * steps[3]);
+        transpose4(r0, r1, r2, r3);  // r_j = sample k + j of the four channels
+        r0 = cascade(r0);
+        r1 = cascade(r1);
+        r2 = cascade(r2);
+        r3 = cascade(r3);
+        transpose4(r0, r1, r2, r3);
+        store(rows[0] + k * steps[0], r0);
+        store(rows[1] + k * steps[1], r1);
+        store(rows[2] + k * steps[2], r2);
+        store(rows[3] + k * steps[3], r3);
+    }
+    for (; k < count; ++k)
+    {
+        alignas(16) float lanes[4];
+        for (int lane = 0; lane < k_lanes; ++lane)
+        {
+            lanes[lane] = rows[lane][k * steps[lane]];
+        }
+        store(lanes, cascade(load(lanes)));
+        for (int lane = 0; lane < k_lanes; ++lane)
+        {
+            rows[lane][k * steps[lane]] = lanes[lane];
+        }
+    }
+
+    for (int s = 0; s < section_count; ++s)
+    {
+        double* section_state = state + static_cast<size_t>(s) * 2 * k_lanes;
+        store_f64(section_state, s1_lo[s]);
+        store_f64(section_state + 2, s1_hi[s]);
+        store_f64(section_state + k_lanes, s2_lo[s]);
+        store_f64(section_state + k_lanes + 2, s2_hi[s]);
+    }
+}
+
+}  // namespace elda::dsp
@@ -0,0 +1,168 @@
+#pragma once
+
+#include "core/aligned_buffer.h"
+#include "core/sample_ring.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace elda::models
+{
+struct Channel;
+}
+
+namespace elda::dsp
+{
+
+/**
+ * Filters of one channel (0 = stage off)
+ */
+struct FilterSpec
+{
+    double high_pass_hz = 0.0;  // First-order high-pass (DC .. 1 Hz in the channel settings)
+    double low_pass_hz = 0.0;   // Fourth-order Butterworth low-pass
+    double notch_hz = 0.0;      // Mains notch (50 / 60 Hz)
+
+    bool operator==(const FilterSpec& other) const
+    {
+        return high_pass_hz == other.high_pass_hz && low_pass_hz == other.low_pass_hz && notch_hz == other.notch_hz;
+    }
+    bool operator!=(const FilterSpec& other) const
+    {
+        return !(*this == other);
+    }
+};
+
+/**
+ * Filters taken from a configured channel (all stages off unless the channel is filtered)
+ */
+FilterSpec filter_for(const models::Channel& channel);
+
+/**
+ * One second-order section, normalised so a0 = 1
+ *  y[n] = b0 x[n] + b1 x[n-1] + b2 x[n-2] - a1 y[n-1] - a2 y[n-2]
+ */
+struct BiquadSection
+{
+    double b0 = 1.0;
+    double b1 = 0.0;
+    double b2 = 0.0;
+    double a1 = 0.0;
+    double a2 = 0.0;
+
+    // Gain at DC (z = 1)
+    double dc_gain() const
+    {
+        return (b0 + b1 + b2) / (1.0 + a1 + a2);
+    }
+};
+
+/**
+ * FilterDesign - biquad cascade realising a FilterSpec at one sample rate
+ *
+ * Stages at or above 0.45 x the sample rate are dropped, so a 500 Hz low-pass
+ * at 1 kHz is simply off. An empty cascade passes samples through untouched.
+ */
+class FilterDesign
+{
+  public:
+    // High-pass + notch + two low-pass sections
+    static constexpr int k_max_sections = 4;
+
+    /**
+     * Shared design for a rate and spec; designs are built on first use and cached for the process lifetime
+     */
+    static std::shared_ptr<const FilterDesign> plan(double sample_rate_hz, const FilterSpec& spec);
+
+    FilterDesign(double sample_rate_hz, const FilterSpec& spec);
+
+    const std::vector<BiquadSection>& sections() const
+    {
+        return sections_;
+    }
+
+    bool empty() const
+    {
+        return sections_.empty();
+    }
+
+  private:
+    std::vector<BiquadSection> sections_;
+};
+
+/**
+ * IirFilterBank - streaming biquad cascades for every channel of the ring
+ *
+ * Channels sharing a design are packed four to a lane group. process() loads
+ * 4 samples x 4 channels, transposes them so each register holds one sample of
+ * four channels, and runs the cascade over the group with every channel in its
+ * own lane. Runs are processed in place, so the bank sits in the ring's
+ * producer path (SampleRing::set_stage()) and readers only ever see filtered
+ * samples.
+ *
+ * Sections are transposed direct form II with double-precision state and
+ * coefficients (f64x2 lanes). A 0.001 Hz high-pass at 25 kHz has its pole 2.5e-7
+ * below 1, about four float ulps: float coefficients alone move its corner by 5%,
+ * and a float state holding a large electrode offset leaves the signal to the
+ * last few mantissa bits. Samples are widened on load and rounded back to float
+ * on store.
+ *
+ * State is primed from the first processed frame as if each input had been
+ * constant forever, so an electrode offset does not ring through a high-pass
+ * whose time constant is minutes long.
+ *
+ * Threading contract: configure() / reset() while the producer is stopped;
+ * process() on the producer thread only.
+ */
+class IirFilterBank final : public IRingStage
+{
+  public:
+    /**
+     * Design (or fetch cached) cascades and clear all state
+     * @param channels Spec per ring channel
+     */
+    void configure(const std::vector<FilterSpec>& channels, double sample_rate_hz);
+
+    /**
+     * Clear the state; the next process() primes it again
+     */
+    void reset();
+
+    /**
+     * True if at least one channel has a non-empty cascade
+     */
+    bool active() const
+    {
+        return !groups_.empty();
+    }
+
+    int channels() const
+    {
+        return channels_;
+    }
+
+    void process(uint64_t first, float* data, size_t channel_stride, int count) override;
+
+  private:
+    static constexpr int k_lanes = 4;
+
+    struct LaneGroup
+    {
+        int channels[k_lanes];  // -1 = padding lane
+        const FilterDesign* design = nullptr;
+        size_t state = 0;  // Offset into state_: per section s1[4], s2[4]
+    };
+
+    void prime(const LaneGroup& group, const float* data, size_t channel_stride);
+    void filter_group(const LaneGroup& group, float* data, size_t channel_stride, int count);
+
+    int channels_ = 0;
+    std::vector<std::shared_ptr<const FilterDesign>> designs_;  // Keeps the cached designs alive
+    std::vector<LaneGroup> groups_;
+    AlignedBuffer<double> state_;
+    bool primed_ = false;
+};
+
+}  // namespace elda::dsp
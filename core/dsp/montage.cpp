@@ -0,0 +1,388 @@
+#include "montage.h"
+
+#include "core/simd.h"
+
+#include <algorithm>
+#include <cctype>
+#include <utility>
+
+namespace elda::dsp
+{
+
+namespace
+{
+constexpr int k_laplacian_neighbours = 4;  // Hjorth: the four nearest electrodes
+
+// Longitudinal bipolar ("double banana"), left to right across the head
+constexpr const char* k_double_banana[][2] = {
+    // Left temporal
+    {"Fp1", "F7"},
+    {"F7", "T3"},
+    {"T3", "T5"},
+    {"T5", "O1"},
+    // Left parasagittal
+    {"Fp1", "F3"},
+    {"F3", "C3"},
+    {"C3", "P3"},
+    {"P3", "O1"},
+    // Midline
+    {"Fz", "Cz"},
+    {"Cz", "Pz"},
+    // Right parasagittal
+    {"Fp2", "F4"},
+    {"F4", "C4"},
+    {"C4", "P4"},
+    {"P4", "O2"},
+    // Right temporal
+    {"Fp2", "F8"},
+    {"F8", "T4"},
+    {"T4", "T6"},
+    {"T6", "O2"},
+};
+
+// Lower-case 10-20 name with the 10-10 temporal names mapped to their 10-20 equivalents
+std::string canonical_name(const std::string& name)
+{
+    std::string key(name);
+    std::transform(
+        key.begin(), key.end(), key.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    if (key == "t7")
+    {
+        return "t3";
+    }
+    if (key == "t8")
+    {
+        return "t4";
+    }
+    if (key == "p7")
+    {
+        return "t5";
+    }
+    if (key == "p8")
+    {
+        return "t6";
+    }
+    return key;
+}
+
+bool acquired(const MontageElectrode& electrode, int ring_channels)
+{
+    return electrode.channel >= 0 && electrode.channel < ring_channels;
+}
+
+// out[0, count) = weight * src (assign) or += weight * src
+inline void scale_run(const float* src, float weight, int count, float* out, bool assign)
+{
+    using namespace simd;
+    const f32x4 w = set1(weight);
+    int k = 0;
+    if (assign)
+    {
+        for (; k + 4 <= count; k += 4)
+        {
+            store(out + k, mul(w, load(src + k)));
+        }
+        for (; k < count; ++k)
+        {
+            out[k] = weight * src[k];
+        }
+        return;
+    }
+    for (; k + 4 <= count; k += 4)
+    {
+        store(out + k, madd(w, load(src + k), load(out + k)));
+    }
+    for (; k < count; ++k)
+    {
+        out[k] += weight * src[k];
+    }
+}
+}  // namespace
+
+// ===== Montage =====
+
+void Montage::begin_row(int electrode, std::string label)
+{
+    labels_.push_back(std::move(label));
+    electrodes_.push_back(electrode);
+    row_begin_.push_back(static_cast<int>(terms_.size()));
+}
+
+void Montage::add_term(int input, float weight)
+{
+    terms_.push_back({input, weight});
+    ++row_begin_.back();
+}
+
+void Montage::build(MontageKind kind, const std::vector<MontageElectrode>& electrodes, int ring_channels)
+{
+    kind_ = kind;
+    row_begin_.assign(1, 0);
+    terms_.clear();
+    labels_.clear();
+    electrodes_.clear();
+    ++generation_;
+
+    const int count = static_cast<int>(electrodes.size());
+    switch (kind)
+    {
+        case MontageKind::CommonAverage:
+            for (int e = 0; e < count; ++e)
+            {
+                begin_row(e, electrodes[e].name + "-Avg");
+                if (acquired(electrodes[e], ring_channels))
+                {
+                    add_term(electrodes[e].channel, 1.0f);
+                    add_term(k_average_input, -1.0f);
+                }
+            }
+            break;
+        case MontageKind::Bipolar:
+            build_bipolar(electrodes, ring_channels);
+            break;
+        case MontageKind::Laplacian:
+            build_laplacian(electrodes, ring_channels);
+            break;
+        case MontageKind::Referential:
+        default:
+            for (int e = 0; e < count; ++e)
+            {
+                begin_row(e, electrodes[e].name);
+                if (acquired(electrodes[e], ring_channels))
+                {
+                    add_term(electrodes[e].channel, 1.0f);
+                }
+            }
+            break;
+    }
+
+    uses_average_ = std::any_of(
+        terms_.begin(), terms_.end(), [](const MontageTerm& term) { return term.input == k_average_input; });
+}
+
+void Montage::build_bipolar(const std::vector<MontageElectrode>& electrodes, int ring_channels)
+{
+    const int count = static_cast<int>(electrodes.size());
+    auto add_pair = [&](int a, int b)
+    {
+        if (!acquired(electrodes[a], ring_channels) || !acquired(electrodes[b], ring_channels))
+        {
+            return;
+        }
+        begin_row(a, electrodes[a].name + "-" + electrodes[b].name);
+        add_term(electrodes[a].channel, 1.0f);
+        add_term(electrodes[b].channel, -1.0f);
+    };
+
+    std::vector<std::string> names(electrodes.size());
+    std::transform(electrodes.begin(),
+                   electrodes.end(),
+                   names.begin(),
+                   [](const MontageElectrode& electrode) { return canonical_name(electrode.name); });
+    auto find = [&](const char* name)
+    {
+        const auto it = std::find(names.begin(), names.end(), canonical_name(name));
+        return it == names.end() ? -1 : static_cast<int>(it - names.begin());
+    };
+
+    for (const auto& pair : k_double_banana)
+    {
+        const int a = find(pair[0]);
+        const int b = find(pair[1]);
+        if (a >= 0 && b >= 0)
+        {
+            add_pair(a, b);
+        }
+    }
+
+    // Groups without 10-20 names: chain neighbours in display order
+    if (labels_.empty())
+    {
+        for (int e = 0; e + 1 < count; ++e)
+        {
+            add_pair(e, e + 1);
+        }
+    }
+}
+
+void Montage::build_laplacian(const std::vector<MontageElectrode>& electrodes, int ring_channels)
+{
+    const int count = static_cast<int>(electrodes.size());
+    std::vector<std::pair<float, int>> distances;
+    distances.reserve(electrodes.size());
+
+    for (int e = 0; e < count; ++e)
+    {
+        const MontageElectrode& electrode = electrodes[e];
+        begin_row(e, electrode.name + "-Lap");
+        if (!acquired(electrode, ring_channels))
+        {
+            continue;
+        }
+        add_term(electrode.channel, 1.0f);
+        if (!electrode.placed())
+        {
+            continue;  // No cap position: stays referential
+        }
+
+        distances.clear();
+        for (int n = 0; n < count; ++n)
+        {
+            const MontageElectrode& other = electrodes[n];
+            if (n == e || !other.placed() || !acquired(other, ring_channels) || other.channel == electrode.channel)
+            {
+                continue;
+            }
+            const float dx = other.x - electrode.x;
+            const float dy = other.y - electrode.y;
+            distances.emplace_back(dx * dx + dy * dy, other.channel);
+        }
+        const int neighbours = std::min(k_laplacian_neighbours, static_cast<int>(distances.size()));
+        std::partial_sort(distances.begin(), distances.begin() + neighbours, distances.end());
+        for (int n = 0; n < neighbours; ++n)
+        {
+            add_term(distances[n].second, -1.0f / static_cast<float>(neighbours));
+        }
+    }
+}
+
+void Montage::evaluate(const SampleRing& ring,
+                       const SampleRing* average,
+                       int row,
+                       uint64_t first,
+                       int count,
+                       float* out) const
+{
+    bool assign = true;
+    for (int t = row_begin_[row]; t < row_begin_[row + 1]; ++t)
+    {
+        const MontageTerm& term = terms_[t];
+        const SampleRing* source = term.input == k_average_input ? average : &ring;
+        if (!source)
+        {
+            continue;
+        }
+        const int channel = term.input == k_average_input ? 0 : term.input;
+
+        // One ring run at a time (ring end; tile edges when Blocked)
+        uint64_t index = first;
+        int done = 0;
+        while (done < count)
+        {
+            int length = 0;
+            const float* src = source->run(channel, source->slot_of(index), length);
+            const int n = std::min(length, count - done);
+            scale_run(src, term.weight, n, out + done, assign);
+            done += n;
+            index += static_cast<uint64_t>(n);
+        }
+        assign = false;
+    }
+    if (assign)
+    {
+        std::fill_n(out, count, 0.0f);
+    }
+}
+
+float Montage::sample(const SampleRing& ring, const SampleRing* average, int row, uint64_t index) const
+{
+    float value = 0.0f;
+    for (int t = row_begin_[row]; t < row_begin_[row + 1]; ++t)
+    {
+        const MontageTerm& term = terms_[t];
+        if (term.input == k_average_input)
+        {
+            value += average ? term.weight * average->sample(0, average->slot_of(index)) : 0.0f;
+        }
+        else
+        {
+            value += term.weight * ring.sample(term.input, ring.slot_of(index));
+        }
+    }
+    return value;
+}
+
+void Montage::apply(const SampleRing& ring,
+                    const SampleRing* average,
+                    uint64_t first,
+                    int count,
+                    float* out,
+                    size_t out_stride) const
+{
+    for (int row = 0; row < rows(); ++row)
+    {
+        evaluate(ring, average, row, first, count, out + static_cast<size_t>(row) * out_stride);
+    }
+}
+
+// ===== AverageReference =====
+
+void AverageReference::configure(const std::vector<int>& channels, SampleRing* target)
+{
+    channels_ = channels;
+    scale_ = channels_.empty() ? 0.0f : 1.0f / static_cast<float>(channels_.size());
+    target_ = target;
+}
+
+void AverageReference::process(uint64_t first, float* data, size_t channel_stride, int count)
+{
+    using namespace simd;
+
+    if (!target_ || count <= 0)
+    {
+        return;
+    }
+    const uint64_t written = target_->published();
+    if (first < written)
+    {
+        return;  // Rings out of step (reset separately): nothing sensible to write
+    }
+    const int gap = static_cast<int>(first - written);
+
+    // Frames [0, gap) of the pushed block are the source ring's skipped frames
+    auto writer = [&](int src_offset, int n, float* dst, size_t /*channel_stride*/)
+    {
+        const int zeros = std::clamp(gap - src_offset, 0, n);
+        std::fill_n(dst, zeros, 0.0f);
+        dst += zeros;
+        n -= zeros;
+        if (n == 0)
+        {
+            return;
+        }
+        if (channels_.empty())
+        {
+            std::fill_n(dst, n, 0.0f);
+            return;
+        }
+
+        const float* frames = data + (src_offset + zeros - gap);
+        std::copy_n(frames + static_cast<size_t>(channels_.front()) * channel_stride, n, dst);
+        for (size_t c = 1; c < channels_.size(); ++c)
+        {
+            const float* src = frames + static_cast<size_t>(channels_[c]) * channel_stride;
+            int k = 0;
+            for (; k + 4 <= n; k += 4)
+            {
+                store(dst + k, add(load(dst + k), load(src + k)));
+            }
+            for (; k < n; ++k)
+            {
+                dst[k] += src[k];
+            }
+        }
+        const f32x4 scale = set1(scale_);
+        int k = 0;
+        for (; k + 4 <= n; k += 4)
+        {
+            store(dst + k, mul(load(dst + k), scale));
+        }
+        for (; k < n; ++k)
+        {
+            dst[k] *= scale_;
+        }
+    };
+    target_->push_with(gap + count, writer);
+}
+
+}  // namespace elda::dsp
@@ -0,0 +1,218 @@
+#pragma once
+
+#include "core/sample_ring.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace elda::dsp
+{
+
+/**
+ * How displayed rows are derived from the amplifier channels
+ *  Referential   - each electrode as recorded (MONO / GND / REF per channel)
+ *  CommonAverage - electrode minus the average of all EEG channels
+ *  Bipolar       - longitudinal "double banana" chains of neighbouring electrodes
+ *  Laplacian     - electrode minus the mean of its nearest neighbours on the cap (Hjorth)
+ */
+enum class MontageKind
+{
+    Referential = 0,
+    CommonAverage,
+    Bipolar,
+    Laplacian
+};
+
+inline const char* montage_to_string(MontageKind kind)
+{
+    switch (kind)
+    {
+        case MontageKind::Referential:
+            return "REF";
+        case MontageKind::CommonAverage:
+            return "AVG";
+        case MontageKind::Bipolar:
+            return "BIP";
+        case MontageKind::Laplacian:
+            return "LAP";
+        default:
+            return "REF";
+    }
+}
+
+/**
+ * One electrode of the active channel group
+ */
+struct MontageElectrode
+{
+    int channel = -1;  // Ring channel (-1 = not acquired)
+    std::string name;  // 10-20 name, matched case-insensitively for the bipolar chains
+    float x = 0.0f;    // Cap position (models::Channel::impedance_x / _y; 0, 0 = not placed)
+    float y = 0.0f;
+
+    bool placed() const
+    {
+        return x != 0.0f || y != 0.0f;
+    }
+};
+
+/**
+ * One weighted input of a montage row
+ */
+struct MontageTerm
+{
+    int input = 0;  // Ring channel, or Montage::k_average_input
+    float weight = 1.0f;
+};
+
+/**
+ * Montage - displayed rows as sparse linear combinations of ring channels
+ *
+ * Rows are stored as a CSR matrix over the ring channels plus one extra input,
+ * the common average reference (a one-channel ring with the same sample
+ * indices, see AverageReference). The common average is therefore two terms
+ * per row instead of one per channel, and every montage stays sparse.
+ *
+ * Rows are evaluated from the ring at read time, for the sample ranges a
+ * reader asks for: switching montages allocates no ring or summary memory,
+ * and readers simply re-read their window. build() reuses the row storage.
+ *
+ * Threading contract: build() on the owner's thread while no reader evaluates;
+ * evaluate() / sample() are const and may run concurrently.
+ */
+class Montage
+{
+  public:
+    // Input index of the common average reference
+    static constexpr int k_average_input = -1;
+
+    /**
+     * Rebuild the rows for a group of electrodes
+     * @param electrodes Active group, in display order
+     * @param ring_channels Channels held by the ring; inputs outside it are dropped
+     */
+    void build(MontageKind kind, const std::vector<MontageElectrode>& electrodes, int ring_channels);
+
+    /**
+     * Samples [first, first + count) of one row
+     * Indices must be published and retained in the ring (and the average ring, if the row reads it).
+     * @param average Common average ring; nullptr reads it as 0
+     */
+    void evaluate(const SampleRing& ring,
+                  const SampleRing* average,
+                  int row,
+                  uint64_t first,
+                  int count,
+                  float* out) const;
+
+    /**
+     * One sample of one row (raw plotting below one sample per pixel)
+     */
+    float sample(const SampleRing& ring, const SampleRing* average, int row, uint64_t index) const;
+
+    /**
+     * Samples [first, first + count) of every row: row r goes to out[r * out_stride + k]
+     */
+    void apply(const SampleRing& ring,
+               const SampleRing* average,
+               uint64_t first,
+               int count,
+               float* out,
+               size_t out_stride) const;
+
+    MontageKind kind() const
+    {
+        return kind_;
+    }
+
+    int rows() const
+    {
+        return static_cast<int>(labels_.size());
+    }
+
+    // Row with no inputs (an electrode that is not acquired)
+    bool empty(int row) const
+    {
+        return row_begin_[row] == row_begin_[row + 1];
+    }
+
+    // Trace label, e.g. "Fp1-F7" or "Cz-Avg"
+    const std::string& label(int row) const
+    {
+        return labels_[row];
+    }
+
+    // Electrode (index into build()'s list) whose colour the row takes
+    int electrode(int row) const
+    {
+        return electrodes_[row];
+    }
+
+    // Terms over all rows
+    int terms() const
+    {
+        return static_cast<int>(terms_.size());
+    }
+
+    bool uses_average() const
+    {
+        return uses_average_;
+    }
+
+    // Bumped by every build(): readers caching rows must re-read them
+    uint64_t generation() const
+    {
+        return generation_;
+    }
+
+  private:
+    void begin_row(int electrode, std::string label);
+    void add_term(int input, float weight);
+
+    void build_bipolar(const std::vector<MontageElectrode>& electrodes, int ring_channels);
+    void build_laplacian(const std::vector<MontageElectrode>& electrodes, int ring_channels);
+
+    MontageKind kind_ = MontageKind::Referential;
+    std::vector<int> row_begin_{0};  // rows + 1 offsets into terms_
+    std::vector<MontageTerm> terms_;
+    std::vector<std::string> labels_;
+    std::vector<int> electrodes_;
+    bool uses_average_ = false;
+    uint64_t generation_ = 0;
+};
+
+/**
+ * AverageReference - writes the common average of a set of ring channels into a one-channel ring
+ *
+ * Runs as a ring stage after the filters: every run is averaged before the
+ * source ring publishes it, so the average ring is always at least as far
+ * along as the source and shares its sample indices. Runs the source ring
+ * skipped (a block longer than its capacity) are written as zeros.
+ *
+ * Threading contract: configure() while the producer is stopped; process() on the producer thread.
+ */
+class AverageReference final : public IRingStage
+{
+  public:
+    /**
+     * @param channels Ring channels averaged per frame (empty = average stays 0)
+     * @param target One-channel ring, configured like the source ring
+     */
+    void configure(const std::vector<int>& channels, SampleRing* target);
+
+    bool active() const
+    {
+        return target_ != nullptr;
+    }
+
+    void process(uint64_t first, float* data, size_t channel_stride, int count) override;
+
+  private:
+    std::vector<int> channels_;
+    float scale_ = 0.0f;  // 1 / channels
+    SampleRing* target_ = nullptr;
+};
+
+}  // namespace elda::dsp
@@ -0,0 +1,264 @@
+#include "polyphase_resampler.h"
+
+#include "core/simd.h"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <mutex>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+namespace elda::dsp
+{
+
+namespace
+{
+constexpr double k_pi = 3.14159265358979323846;
+constexpr double k_passband = 0.4;  // x output_hz
+constexpr double k_stopband = 0.6;  // x output_hz
+constexpr int k_tap_multiple = 16;  // Four f32x4 accumulators per step
+
+bool whole_hz(double rate_hz)
+{
+    return rate_hz >= 1.0 && std::abs(rate_hz - std::round(rate_hz)) < 1e-6;
+}
+
+// Zeroth-order modified Bessel function of the first kind (power series)
+double bessel_i0(double x)
+{
+    const double q = 0.25 * x * x;
+    double term = 1.0;
+    double sum = 1.0;
+    for (int k = 1; k < 64 && term > sum * 1e-17; ++k)
+    {
+        term *= q / (static_cast<double>(k) * k);
+        sum += term;
+    }
+    return sum;
+}
+
+// sum(x[k] * h[k]) over taps (a multiple of 16)
+float dot(const float* x, const float* h, int taps)
+{
+    using namespace simd;
+
+    f32x4 a0 = set1(0.0f);
+    f32x4 a1 = a0;
+    f32x4 a2 = a0;
+    f32x4 a3 = a0;
+    for (int k = 0; k < taps; k += k_tap_multiple)
+    {
+        a0 = madd(load(x + k), load(h + k), a0);
+        a1 = madd(load(x + k + 4), load(h + k + 4), a1);
+        a2 = madd(load(x + k + 8), load(h + k + 8), a2);
+        a3 = madd(load(x + k + 12), load(h + k + 12), a3);
+    }
+    float lanes[4];
+    store(lanes, add(add(a0, a1), add(a2, a3)));
+    return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+}
+}  // namespace
+
+// ===== ResampleDesign =====
+
+bool ResampleDesign::supported(double input_hz, double output_hz)
+{
+    if (!whole_hz(input_hz) || !whole_hz(output_hz) || output_hz >= input_hz)
+    {
+        return false;
+    }
+    const long input = std::lround(input_hz);
+    const long output = std::lround(output_hz);
+    return output / std::gcd(input, output) <= k_max_phases;
+}
+
+std::shared_ptr<const ResampleDesign> ResampleDesign::plan(double input_hz, double output_hz)
+{
+    using Key = std::pair<long, long>;
+    static std::mutex mutex;
+    static std::map<Key, std::shared_ptr<const ResampleDesign>> designs;
+
+    const long input = std::lround(input_hz);
+    const long output = std::lround(output_hz);
+    std::lock_guard<std::mutex> lock(mutex);
+    std::shared_ptr<const ResampleDesign>& design = designs[Key{input, output}];
+    if (!design)
+    {
+        design = std::make_shared<const ResampleDesign>(static_cast<int>(input), static_cast<int>(output));
+    }
+    return design;
+}
+
+ResampleDesign::ResampleDesign(int input_hz, int output_hz)
+{
+    const int common = std::gcd(input_hz, output_hz);
+    up_ = output_hz / common;
+    down_ = input_hz / common;
+
+    // Kaiser's estimate of the length for the transition band, at the prototype rate
+    const double prototype_hz = static_cast<double>(up_) * input_hz;
+    const double transition = 2.0 * k_pi * (k_stopband - k_passband) * output_hz / prototype_hz;
+    const int length = static_cast<int>(std::ceil((k_stopband_db - 7.95) / (2.285 * transition))) + 1;
+    taps_ = (length + up_ - 1) / up_;
+    taps_ = (taps_ + k_tap_multiple - 1) / k_tap_multiple * k_tap_multiple;
+
+    // Symmetric about an integer centre; an even length leaves its last tap at zero
+    const int total = taps_ * up_;
+    delay_ = (total - 1) / 2;
+    const double cutoff = 0.5 * (k_passband + k_stopband) * output_hz / prototype_hz;  // Cycles per prototype sample
+    const double beta = 0.1102 * (k_stopband_db - 8.7);
+    const double window_norm = bessel_i0(beta);
+    std::vector<double> prototype(static_cast<size_t>(total), 0.0);
+    for (int i = 0; i < total; ++i)
+    {
+        const int offset = i - delay_;
+        if (std::abs(offset) > delay_)
+        {
+            continue;
+        }
+        const double u = delay_ > 0 ? static_cast<double>(offset) / delay_ : 0.0;
+        const double window = bessel_i0(beta * std::sqrt(std::max(0.0, 1.0 - u * u))) / window_norm;
+        const double x = 2.0 * cutoff * offset;
+        const double sinc = offset == 0 ? 1.0 : std::sin(k_pi * x) / (k_pi * x);
+        prototype[i] = window * sinc;
+    }
+
+    // Phase p holds prototype[p + k * up] for k = taps - 1 .. 0: coefficient 0 meets the oldest sample
+    coefficients_ = AlignedBuffer<float>(static_cast<size_t>(up_) * taps_);
+    for (int p = 0; p < up_; ++p)
+    {
+        double sum = 0.0;
+        for (int k = 0; k < taps_; ++k)
+        {
+            sum += prototype[p + static_cast<size_t>(k) * up_];
+        }
+        float* row = coefficients_.data() + static_cast<size_t>(p) * taps_;
+        for (int k = 0; k < taps_; ++k)
+        {
+            row[taps_ - 1 - k] = static_cast<float>(prototype[p + static_cast<size_t>(k) * up_] / sum);
+        }
+    }
+}
+
+// ===== PolyphaseResampler =====
+
+void PolyphaseResampler::configure(int channels, double source_hz, SampleRing* target)
+{
+    design_.reset();
+    target_ = nullptr;
+    channels_ = 0;
+    primed_ = false;
+    next_input_ = 0;
+    next_output_ = 0;
+    if (!target || channels < 1 || channels != target->channels() ||
+        !ResampleDesign::supported(source_hz, target->sample_rate_hz()))
+    {
+        history_ = AlignedBuffer<float>();
+        return;
+    }
+
+    design_ = ResampleDesign::plan(source_hz, target->sample_rate_hz());
+    target_ = target;
+    channels_ = channels;
+    length_ = design_->taps() + k_chunk;
+    history_stride_ = (2 * static_cast<size_t>(length_) + k_tap_multiple - 1) / k_tap_multiple * k_tap_multiple;
+    history_ = AlignedBuffer<float>(history_stride_ * channels_);
+}
+
+void PolyphaseResampler::process(uint64_t first, float* data, size_t channel_stride, int count)
+{
+    if (!target_ || count <= 0)
+    {
+        return;
+    }
+    if (!primed_ || first != next_input_)
+    {
+        restart(first, data, channel_stride);
+    }
+    for (int offset = 0; offset < count; offset += k_chunk)
+    {
+        append(data + offset, channel_stride, std::min(k_chunk, count - offset));
+        emit();
+    }
+}
+
+void PolyphaseResampler::restart(uint64_t first, const float* data, size_t channel_stride)
+{
+    for (int c = 0; c < channels_; ++c)
+    {
+        std::fill_n(history_.data() + c * history_stride_, 2 * length_, data[c * channel_stride]);
+    }
+    primed_ = true;
+    next_input_ = first;
+
+    // First output at or after the restart
+    const auto up = static_cast<uint64_t>(design_->up());
+    const auto down = static_cast<uint64_t>(design_->down());
+    next_output_ = (first * up + down - 1) / down;
+}
+
+void PolyphaseResampler::append(const float* data, size_t channel_stride, int count)
+{
+    const int slot = static_cast<int>(next_input_ % static_cast<uint64_t>(length_));
+    const int head = std::min(count, length_ - slot);
+    for (int c = 0; c < channels_; ++c)
+    {
+        const float* src = data + c * channel_stride;
+        float* history = history_.data() + c * history_stride_;
+        std::copy_n(src, head, history + slot);
+        std::copy_n(src, head, history + slot + length_);
+        std::copy_n(src + head, count - head, history);
+        std::copy_n(src + head, count - head, history + length_);
+    }
+    next_input_ += static_cast<uint64_t>(count);
+}
+
+void PolyphaseResampler::emit()
+{
+    const ResampleDesign& design = *design_;
+    const auto up = static_cast<uint64_t>(design.up());
+    const auto down = static_cast<uint64_t>(design.down());
+    const auto delay = static_cast<uint64_t>(design.delay());
+    const int taps = design.taps();
+
+    // Output j is ready once source frame (j * down + delay) / up is in
+    const uint64_t limit = next_input_ * up;
+    if (limit <= delay)
+    {
+        return;
+    }
+    const uint64_t end = (limit - delay - 1) / down + 1;
+    const uint64_t written = target_->published();
+    if (end <= written)
+    {
+        return;
+    }
+    const uint64_t from = std::max(written, next_output_);  // [written, from) fell in a source gap
+
+    auto writer = [&](int src_offset, int n, float* dst, size_t dst_stride)
+    {
+        for (int c = 0; c < channels_; ++c)
+        {
+            const float* history = history_.data() + c * history_stride_;
+            float* out = dst + c * dst_stride;
+            for (int k = 0; k < n; ++k)
+            {
+                const uint64_t j = written + static_cast<uint64_t>(src_offset + k);
+                if (j < from)
+                {
+                    out[k] = 0.0f;
+                    continue;
+                }
+                const uint64_t position = j * down + delay;
+                const uint64_t last = position / up;
+                const auto start = static_cast<int>((last + 1 + length_ - taps) % static_cast<uint64_t>(length_));
+                out[k] = dot(history + start, design.phase(static_cast<int>(position % up)), taps);
+            }
+        }
+    };
+    target_->push_with(static_cast<int>(end - written), writer);
+}
+
+}  // namespace elda::dsp
@@ -0,0 +1,146 @@
+#pragma once
+
+#include "core/aligned_buffer.h"
+#include "core/sample_ring.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace elda::dsp
+{
+
+/**
+ * ResampleDesign - polyphase FIR for a rational rate change input_hz -> output_hz (output < input)
+ *
+ * The ratio is reduced to up / down in lowest terms. The prototype low-pass
+ * runs at up x input_hz: a Kaiser-windowed sinc (80 dB) passing 0.4 x output_hz
+ * and stopping from 0.6 x output_hz, so the only aliasing lands in the top of
+ * the output band, above the passband. It is split into `up` phases of taps()
+ * coefficients each, stored oldest-sample first so every output is one
+ * contiguous dot product over the input history. Each phase is scaled to unit
+ * DC gain.
+ *
+ * The prototype is symmetric about an integer centre, so output j is exactly
+ * the input at time j x down / up: the resampled stream shares the source's
+ * time base and only its publication lags by half the filter.
+ */
+class ResampleDesign
+{
+  public:
+    // Largest `up` of a reduced ratio (5 kHz -> 2 kHz is 2 / 5)
+    static constexpr int k_max_phases = 256;
+    static constexpr double k_stopband_db = 80.0;
+
+    /**
+     * True if input_hz -> output_hz is a whole-Hz decimation with at most k_max_phases phases
+     */
+    static bool supported(double input_hz, double output_hz);
+
+    /**
+     * Shared design for a supported pair of rates; designs are built on first use and cached for the process lifetime
+     */
+    static std::shared_ptr<const ResampleDesign> plan(double input_hz, double output_hz);
+
+    ResampleDesign(int input_hz, int output_hz);
+
+    int up() const
+    {
+        return up_;
+    }
+
+    int down() const
+    {
+        return down_;
+    }
+
+    // Coefficients per phase (a multiple of 16)
+    int taps() const
+    {
+        return taps_;
+    }
+
+    // Prototype centre, in samples at up x input_hz
+    int delay() const
+    {
+        return delay_;
+    }
+
+    const float* phase(int p) const
+    {
+        return coefficients_.data() + static_cast<size_t>(p) * taps_;
+    }
+
+  private:
+    int up_ = 1;
+    int down_ = 1;
+    int taps_ = 0;
+    int delay_ = 0;
+    AlignedBuffer<float> coefficients_;  // up_ x taps_
+};
+
+/**
+ * PolyphaseResampler - streams every channel of a ring into a second ring at a lower rate
+ *
+ * Runs as a ring stage: each run the source publishes is appended to a
+ * per-channel history and every output whose taps are all in is computed (one
+ * f32x4 dot product of taps() per channel and output) and pushed into the
+ * target ring before the source publishes the run. taps() grows with
+ * input_hz / output_hz, so the stage costs about 25 multiply-adds per source
+ * sample whatever the output rate; every reader of the target (chart, pyramid,
+ * recorder) then costs in proportion to the output rate. Target index j is the
+ * source at time j / output_hz, so readers position both rings by time alike.
+ *
+ * History is stored twice (at i and i + length) so each output's window is
+ * contiguous without a wrap check. The first frame primes it as if the input
+ * had been constant forever, so an electrode offset does not ramp in. Frames
+ * the source skipped restart the history at the next run; outputs that fall
+ * in the gap are written as zeros.
+ *
+ * Threading contract: configure() while the producer is stopped; process() on the producer thread.
+ */
+class PolyphaseResampler final : public IRingStage
+{
+  public:
+    /**
+     * Design (or fetch cached) the filter for source_hz -> target->sample_rate_hz() and clear all state
+     * @param channels Source channels, resampled one to one into the target's channels
+     * @param target Ring at the output rate with the same channel count (nullptr or not a supported decimation:
+     *               stage off)
+     */
+    void configure(int channels, double source_hz, SampleRing* target);
+
+    bool active() const
+    {
+        return target_ != nullptr;
+    }
+
+    const ResampleDesign* design() const
+    {
+        return design_.get();
+    }
+
+    void process(uint64_t first, float* data, size_t channel_stride, int count) override;
+
+  private:
+    // Source frames appended per step; bounds the history beyond the taps
+    static constexpr int k_chunk = 256;
+
+    void restart(uint64_t first, const float* data, size_t channel_stride);
+    void append(const float* data, size_t channel_stride, int count);
+    void emit();
+
+    std::shared_ptr<const ResampleDesign> design_;
+    SampleRing* target_ = nullptr;
+    int channels_ = 0;
+
+    // Source history per channel, circular by absolute index and mirrored: [length_][length_]
+    AlignedBuffer<float> history_;
+    int length_ = 0;
+    size_t history_stride_ = 0;
+    bool primed_ = false;
+    uint64_t next_input_ = 0;   // Source index of the next frame
+    uint64_t next_output_ = 0;  // Target index of the first output after the last restart
+};
+
+}  // namespace elda::dsp
@@ -0,0 +1,425 @@
+#include "pulse_artifact.h"
+
+#include "core/simd.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+namespace elda::dsp
+{
+
+namespace
+{
+// Template memory cap (stored beats); long windows at high rates get fewer beats
+constexpr size_t k_max_template_bytes = size_t{256} << 20;
+
+// Epoch baseline: the QRS, before the pulse artifact starts
+constexpr double k_baseline_s = 0.1;
+
+// QRS detector
+const FilterSpec k_qrs_band{5.0, 30.0, 0.0};
+constexpr double k_integration_s = 0.08;  // About one QRS
+constexpr double k_learn_s = 2.0;         // Initial QRS level: the largest energy in this span
+constexpr double k_refractory_s = 0.25;   // No second beat within (240 bpm)
+constexpr double k_silence_s = 2.5;       // Without a beat the QRS level halves after this long
+constexpr double k_threshold = 0.35;      // Fraction of the running QRS level that starts a QRS
+constexpr double k_level_update = 0.125;  // Weight of each new QRS in the running level
+
+using clock = std::chrono::steady_clock;
+
+uint64_t seconds_to_samples(double seconds, double sample_rate_hz)
+{
+    return static_cast<uint64_t>(std::max(1.0, std::round(seconds * sample_rate_hz)));
+}
+}  // namespace
+
+// ===== RPeakDetector =====
+
+void RPeakDetector::configure(double sample_rate_hz)
+{
+    design_ = FilterDesign::plan(sample_rate_hz, k_qrs_band);
+    window_ = static_cast<int>(seconds_to_samples(k_integration_s, sample_rate_hz));
+    energy_.assign(static_cast<size_t>(window_), 0.0);
+    filtered_.assign(static_cast<size_t>(window_), 0.0f);
+    learn_ = seconds_to_samples(k_learn_s, sample_rate_hz);
+    learned_ = false;
+    refractory_ = seconds_to_samples(k_refractory_s, sample_rate_hz);
+    max_qrs_ = seconds_to_samples(k_max_qrs_ms / 1000.0, sample_rate_hz);
+    silence_ = seconds_to_samples(k_silence_s, sample_rate_hz);
+    level_ = 0.0;
+    threshold_ = 0.0;
+    restart();
+}
+
+void RPeakDetector::restart()
+{
+    primed_ = false;
+    std::fill(std::begin(state_), std::end(state_), 0.0);
+    std::fill(energy_.begin(), energy_.end(), 0.0);
+    std::fill(filtered_.begin(), filtered_.end(), 0.0f);
+    head_ = 0;
+    sum_ = 0.0;
+    previous_ = 0.0;
+    in_qrs_ = false;
+}
+
+bool RPeakDetector::push(uint64_t index, float sample, uint64_t& peak)
+{
+    if (!primed_)
+    {
+        // The band-pass removes the offset anyway; taking it out first avoids the start-up step
+        primed_ = true;
+        offset_ = sample;
+        if (!learned_)
+        {
+            learn_end_ = index + learn_;
+            level_ = 0.0;
+        }
+        refractory_end_ = index + static_cast<uint64_t>(window_);
+        last_peak_ = index;
+    }
+
+    // Band-pass (transposed direct form II), then the squared slope
+    double y = static_cast<double>(sample) - offset_;
+    const std::vector<BiquadSection>& sections = design_->sections();
+    for (size_t i = 0; i < sections.size(); ++i)
+    {
+        const BiquadSection& q = sections[i];
+        const double x = y;
+        y = q.b0 * x + state_[2 * i];
+        state_[2 * i] = q.b1 * x - q.a1 * y + state_[2 * i + 1];
+        state_[2 * i + 1] = q.b2 * x - q.a2 * y;
+    }
+    const double slope = y - previous_;
+    previous_ = y;
+
+    // Moving-window integration
+    sum_ = std::max(0.0, sum_ + slope * slope - energy_[head_]);
+    energy_[head_] = slope * slope;
+    filtered_[head_] = static_cast<float>(y);
+    head_ = head_ + 1 == window_ ? 0 : head_ + 1;
+
+    if (!learned_)
+    {
+        level_ = std::max(level_, sum_);
+        threshold_ = k_threshold * level_;
+        learned_ = index + 1 >= learn_end_;
+        return false;
+    }
+
+    if (!in_qrs_)
+    {
+        if (threshold_ > 0.0 && sum_ >= threshold_ && index >= refractory_end_)
+        {
+            // The R-peak can precede the energy rise: start from the samples the window covers
+            in_qrs_ = true;
+            qrs_start_ = index;
+            qrs_energy_ = sum_;
+            best_ = -1.0f;
+            for (int age = 0; age < window_; ++age)
+            {
+                const float value = std::fabs(filtered_[(head_ - 1 - age + 2 * window_) % window_]);
+                if (value > best_)
+                {
+                    best_ = value;
+                    best_index_ = index - static_cast<uint64_t>(age);
+                }
+            }
+        }
+        else if (index >= last_peak_ + silence_)
+        {
+            // Lost the beat (lead moved, gain changed): lower the bar
+            level_ *= 0.5;
+            threshold_ = k_threshold * level_;
+            last_peak_ = index;
+        }
+        return false;
+    }
+
+    qrs_energy_ = std::max(qrs_energy_, sum_);
+    if (std::fabs(static_cast<float>(y)) > best_)
+    {
+        best_ = std::fabs(static_cast<float>(y));
+        best_index_ = index;
+    }
+    if (sum_ >= 0.5 * threshold_ && index - qrs_start_ < max_qrs_)
+    {
+        return false;
+    }
+
+    in_qrs_ = false;
+    level_ += k_level_update * (qrs_energy_ - level_);
+    threshold_ = k_threshold * level_;
+    refractory_end_ = best_index_ + refractory_;
+    last_peak_ = best_index_;
+    peak = best_index_;
+    return true;
+}
+
+// ===== PulseArtifactCorrector =====
+
+void PulseArtifactCorrector::configure(const PulseCorrectionSpec& spec,
+                                       const std::vector<int>& channels,
+                                       double sample_rate_hz)
+{
+    active_ = false;
+    channels_.clear();
+    if (!spec.enabled || spec.ecg_channel < 0 || !(sample_rate_hz > 0.0))
+    {
+        return;
+    }
+    ecg_channel_ = spec.ecg_channel;
+    sample_rate_hz_ = sample_rate_hz;
+    for (const int channel : channels)
+    {
+        if (channel >= 0 && channel != ecg_channel_)
+        {
+            channels_.push_back(channel);
+        }
+    }
+    if (channels_.empty())
+    {
+        return;
+    }
+
+    const size_t count = channels_.size();
+    length_ = static_cast<int>(seconds_to_samples(spec.window_ms / 1000.0, sample_rate_hz));
+    baseline_ = std::min(length_, static_cast<int>(seconds_to_samples(k_baseline_s, sample_rate_hz)));
+
+    const size_t epoch_bytes = count * static_cast<size_t>(length_) * sizeof(float);
+    const int memory_beats = static_cast<int>(std::max<size_t>(1, k_max_template_bytes / epoch_bytes));
+    beats_ = std::max(k_min_beats, std::min(spec.beats, memory_beats));
+    if (beats_ < spec.beats)
+    {
+        std::printf("[Pulse] Template window capped at %d beats (%.1f MiB each)\n",
+                    beats_,
+                    static_cast<double>(epoch_bytes) / (1 << 20));
+    }
+
+    raw_ = AlignedBuffer<float>(count * static_cast<size_t>(length_));
+    stored_ = AlignedBuffer<float>(static_cast<size_t>(beats_) * count * static_cast<size_t>(length_));
+    sums_.assign(count * static_cast<size_t>(length_), 0.0);
+    mean_ = AlignedBuffer<float>(count * static_cast<size_t>(length_));
+    epoch_.assign(static_cast<size_t>(length_), 0.0f);
+    filled_ = 0;
+    next_slot_ = 0;
+    in_beat_ = false;
+    pending_count_ = 0;
+    started_ = false;
+    detector_.configure(sample_rate_hz);
+
+    detected_.store(0, std::memory_order_relaxed);
+    template_beats_.store(0, std::memory_order_relaxed);
+    rr_samples_.store(0, std::memory_order_relaxed);
+    last_delay_.store(0, std::memory_order_relaxed);
+    max_delay_.store(0, std::memory_order_relaxed);
+    updates_.reset();
+    active_ = true;
+}
+
+PulseCorrectionStats PulseArtifactCorrector::stats() const
+{
+    PulseCorrectionStats stats;
+    stats.beats = detected_.load(std::memory_order_relaxed);
+    stats.template_beats = template_beats_.load(std::memory_order_relaxed);
+    const uint64_t rr = rr_samples_.load(std::memory_order_relaxed);
+    if (rr > 0)
+    {
+        stats.heart_rate_bpm = 60.0 * sample_rate_hz_ / static_cast<double>(rr);
+    }
+    const double ms_per_sample = sample_rate_hz_ > 0.0 ? 1000.0 / sample_rate_hz_ : 0.0;
+    stats.last_delay_ms = static_cast<double>(last_delay_.load(std::memory_order_relaxed)) * ms_per_sample;
+    stats.max_delay_ms = static_cast<double>(max_delay_.load(std::memory_order_relaxed)) * ms_per_sample;
+    stats.last_update_ms = updates_.last_ms();
+    stats.max_update_ms = updates_.max_ms();
+    stats.mean_update_ms = updates_.mean_ms();
+    return stats;
+}
+
+void PulseArtifactCorrector::process(uint64_t first, float* data, size_t channel_stride, int count)
+{
+    if (!active_ || count <= 0)
+    {
+        return;
+    }
+    if (!started_ || first != next_index_)
+    {
+        restart(first);
+    }
+
+    const float* ecg = data + static_cast<size_t>(ecg_channel_) * channel_stride;
+    int pos = 0;
+    while (pos < count)
+    {
+        const uint64_t index = first + static_cast<uint64_t>(pos);
+
+        // Epochs whose last sample is in
+        while (pending_count_ > 0 && pending_[0] + static_cast<uint64_t>(length_) <= index)
+        {
+            fold_epoch(pending_[0]);
+            std::copy(pending_ + 1, pending_ + pending_count_, pending_);
+            --pending_count_;
+        }
+        int end = count;
+        if (pending_count_ > 0)
+        {
+            end = static_cast<int>(std::min<uint64_t>(
+                static_cast<uint64_t>(end), pending_[0] + static_cast<uint64_t>(length_) - first));
+        }
+
+        // Detection up to the first confirmed R-peak; its beat applies from the next sample
+        bool detected = false;
+        uint64_t peak = 0;
+        for (int k = pos; k < end; ++k)
+        {
+            if (detector_.push(first + static_cast<uint64_t>(k), ecg[k], peak))
+            {
+                detected = true;
+                end = k + 1;
+                break;
+            }
+        }
+
+        // Samples are kept before they are corrected
+        const int run = end - pos;
+        record(data + pos, channel_stride, index, run);
+        subtract(data + pos, channel_stride, index, run);
+        pos = end;
+        if (detected)
+        {
+            begin_beat(peak, first + static_cast<uint64_t>(end));
+        }
+    }
+    next_index_ = first + static_cast<uint64_t>(count);
+}
+
+void PulseArtifactCorrector::restart(uint64_t first)
+{
+    // Epochs spanning skipped frames have no samples; the templates stay valid
+    pending_count_ = 0;
+    history_start_ = first;
+    next_index_ = first;
+    started_ = true;
+    detector_.restart();
+}
+
+void PulseArtifactCorrector::begin_beat(uint64_t peak, uint64_t detected)
+{
+    detected_.fetch_add(1, std::memory_order_relaxed);
+    if (in_beat_ && peak > beat_start_)
+    {
+        rr_samples_.store(peak - beat_start_, std::memory_order_relaxed);
+    }
+    last_delay_.store(detected - peak, std::memory_order_relaxed);
+    update_max(max_delay_, detected - peak);
+
+    // Epochs need their first sample in the history, and their window not yet overwritten: the
+    // history only holds the last window, and a short window can end before its R-peak is confirmed
+    if (peak >= history_start_ && peak + static_cast<uint64_t>(length_) > detected)
+    {
+        if (pending_count_ == k_max_pending)
+        {
+            std::copy(pending_ + 1, pending_ + pending_count_, pending_);
+            --pending_count_;
+        }
+        pending_[pending_count_++] = peak;
+    }
+    in_beat_ = true;
+    beat_start_ = peak;
+}
+
+void PulseArtifactCorrector::fold_epoch(uint64_t peak)
+{
+    const auto began = clock::now();
+    const int count = static_cast<int>(channels_.size());
+    const auto slot_start = static_cast<int>(peak % static_cast<uint64_t>(length_));
+    const int head = length_ - slot_start;
+
+    const int window = std::min(filled_ + 1, beats_);
+    const double scale = 1.0 / static_cast<double>(window);
+    float* epoch = epoch_.data();
+    for (int c = 0; c < count; ++c)
+    {
+        // The history holds exactly one window: [peak, peak + length_)
+        const float* history = raw_.data() + static_cast<size_t>(c) * static_cast<size_t>(length_);
+        std::memcpy(epoch, history + slot_start, static_cast<size_t>(head) * sizeof(float));
+        std::memcpy(epoch + head, history, static_cast<size_t>(slot_start) * sizeof(float));
+
+        // Each epoch relative to its baseline: electrode offsets and drift stay out of the template
+        double total = 0.0;
+        for (int j = 0; j < baseline_; ++j)
+        {
+            total += epoch[j];
+        }
+        const auto baseline = static_cast<float>(total / baseline_);
+
+        float* slot = stored_.data() + (static_cast<size_t>(next_slot_) * static_cast<size_t>(count) + c) *
+                                           static_cast<size_t>(length_);
+        double* sums = sums_.data() + static_cast<size_t>(c) * static_cast<size_t>(length_);
+        float* mean = mean_.data() + static_cast<size_t>(c) * static_cast<size_t>(length_);
+        for (int j = 0; j < length_; ++j)
+        {
+            const float value = epoch[j] - baseline;
+            sums[j] += static_cast<double>(value) - static_cast<double>(slot[j]);
+            slot[j] = value;
+            mean[j] = static_cast<float>(sums[j] * scale);
+        }
+    }
+    next_slot_ = (next_slot_ + 1) % beats_;
+    filled_ = window;
+    template_beats_.store(filled_, std::memory_order_relaxed);
+
+    const auto ns =
+        static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - began).count());
+    updates_.record(ns);
+}
+
+void PulseArtifactCorrector::record(const float* data, size_t channel_stride, uint64_t index, int count)
+{
+    const int skip = std::max(0, count - length_);  // Only the newest length_ samples are kept
+    index += static_cast<uint64_t>(skip);
+    data += skip;
+    count -= skip;
+
+    const auto slot = static_cast<int>(index % static_cast<uint64_t>(length_));
+    const int head = std::min(count, length_ - slot);
+    for (size_t c = 0; c < channels_.size(); ++c)
+    {
+        const float* src = data + static_cast<size_t>(channels_[c]) * channel_stride;
+        float* dst = raw_.data() + c * static_cast<size_t>(length_);
+        std::memcpy(dst + slot, src, static_cast<size_t>(head) * sizeof(float));
+        std::memcpy(dst, src + head, static_cast<size_t>(count - head) * sizeof(float));
+    }
+}
+
+void PulseArtifactCorrector::subtract(float* data, size_t channel_stride, uint64_t index, int count) const
+{
+    using namespace simd;
+
+    if (!in_beat_ || filled_ < k_min_beats || index < beat_start_ ||
+        index - beat_start_ >= static_cast<uint64_t>(length_))
+    {
+        return;  // No beat yet, past the template, or too few beats averaged
+    }
+    const auto offset = static_cast<int>(index - beat_start_);
+    const int n = std::min(count, length_ - offset);
+    for (size_t c = 0; c < channels_.size(); ++c)
+    {
+        float* dst = data + static_cast<size_t>(channels_[c]) * channel_stride;
+        const float* artifact = mean_.data() + c * static_cast<size_t>(length_) + offset;
+        int k = 0;
+        for (; k + 4 <= n; k += 4)
+        {
+            store(dst + k, sub(load(dst + k), load(artifact + k)));
+        }
+        for (; k < n; ++k)
+        {
+            dst[k] -= artifact[k];
+        }
+    }
+}
+
+}  // namespace elda::dsp
@@ -0,0 +1,210 @@
+#pragma once
+
+#include "core/aligned_buffer.h"
+#include "core/atomic_max.h"
+#include "core/dsp/iir_filter_bank.h"
+#include "core/sample_ring.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace elda::dsp
+{
+
+/**
+ * Ballistocardiogram (pulse artifact) correction of one session (enabled = false or no ECG channel: stage off)
+ */
+struct PulseCorrectionSpec
+{
+    bool enabled = false;
+    int ecg_channel = -1;       // Ring channel of the ECG lead the R-peaks are detected on
+    int beats = 20;             // Heartbeats averaged into each channel's template (sliding window)
+    double window_ms = 1000.0;  // Template length from the R-peak
+};
+
+/**
+ * Counters of the pulse correction stage (cumulative since configure())
+ */
+struct PulseCorrectionStats
+{
+    uint64_t beats = 0;           // R-peaks detected
+    int template_beats = 0;       // Beats in the current templates
+    double heart_rate_bpm = 0.0;  // From the last R-R interval
+    double last_delay_ms = 0.0;   // R-peak to its detection: the uncorrected head of each beat
+    double max_delay_ms = 0.0;
+    double last_update_ms = 0.0;  // Template work of the last beat
+    double max_update_ms = 0.0;
+    double mean_update_ms = 0.0;
+};
+
+/**
+ * RPeakDetector - streaming QRS detector for one ECG lead
+ *
+ * Pan-Tompkins style: 5-30 Hz band-pass, squared slope, moving-window
+ * integration, and an adaptive threshold at a third of the running QRS
+ * energy (learned over the first two seconds). The R-peak is the largest
+ * band-passed sample of the QRS; it is confirmed when the energy has fallen
+ * back or after k_max_qrs_ms, whichever is first, so the detection delay is
+ * bounded. Either ECG polarity works.
+ */
+class RPeakDetector
+{
+  public:
+    static constexpr double k_max_qrs_ms = 150.0;
+
+    void configure(double sample_rate_hz);
+
+    /**
+     * Drop the filter and envelope state; the learned QRS level is kept
+     */
+    void restart();
+
+    /**
+     * Feed the next ECG sample
+     * @param peak Index of the R-peak when one is confirmed
+     * @return True if this sample confirmed an R-peak
+     */
+    bool push(uint64_t index, float sample, uint64_t& peak);
+
+  private:
+    std::shared_ptr<const FilterDesign> design_;
+    double state_[2 * FilterDesign::k_max_sections] = {};
+    bool primed_ = false;
+    double offset_ = 0.0;
+    double previous_ = 0.0;
+
+    // Moving-window integration of the squared slope, and the band-passed samples it covers
+    std::vector<double> energy_;
+    std::vector<float> filtered_;
+    int window_ = 0;
+    int head_ = 0;
+    double sum_ = 0.0;
+
+    // Thresholding
+    uint64_t learn_ = 0;
+    bool learned_ = false;
+    uint64_t learn_end_ = 0;
+    uint64_t refractory_ = 0;
+    uint64_t max_qrs_ = 0;
+    uint64_t silence_ = 0;
+    double level_ = 0.0;
+    double threshold_ = 0.0;
+    uint64_t refractory_end_ = 0;
+    uint64_t last_peak_ = 0;
+
+    // QRS in progress
+    bool in_qrs_ = false;
+    uint64_t qrs_start_ = 0;
+    uint64_t best_index_ = 0;
+    float best_ = 0.0f;
+    double qrs_energy_ = 0.0;
+};
+
+/**
+ * PulseArtifactCorrector - online ballistocardiogram removal for EEG recorded in the scanner
+ *
+ * Every heartbeat moves the electrodes in the static field and adds a pulse
+ * artifact to each EEG channel, time-locked to the ECG R-peak and lagging it by
+ * ~200 ms. R-peaks are detected on the ECG lead (RPeakDetector); each EEG
+ * channel keeps a sliding template: the mean of the last `beats` epochs of
+ * window_ms from the R-peak. Each epoch is taken relative to its first 100 ms
+ * (the QRS, before the artifact starts), so electrode offsets and drift stay
+ * out of the template.
+ *
+ * Samples are corrected as they arrive from the moment a beat is detected, so
+ * the stage adds no latency; the head of each beat, between the R-peak and its
+ * detection (bounded by RPeakDetector::k_max_qrs_ms), precedes the artifact
+ * and is left as recorded. An epoch is folded in once its last sample is in,
+ * and the update takes effect on the samples that follow; a beat confirmed only
+ * after its window has passed (short window_ms) adds no epoch.
+ *
+ * Runs as a ring stage after the gradient correction and the filters, ahead of
+ * the common average. Frames the ring skipped restart detection; templates are kept.
+ *
+ * Threading contract: configure() while the producer is stopped; process() on
+ * the producer thread; stats() from any thread.
+ */
+class PulseArtifactCorrector final : public IRingStage
+{
+  public:
+    // Beats a template needs before it is subtracted
+    static constexpr int k_min_beats = 5;
+
+    /**
+     * Size the templates and clear all state
+     * @param channels Ring channels to correct (the ECG channel is skipped)
+     */
+    void configure(const PulseCorrectionSpec& spec, const std::vector<int>& channels, double sample_rate_hz);
+
+    bool active() const
+    {
+        return active_;
+    }
+
+    // Samples per template
+    int template_length() const
+    {
+        return length_;
+    }
+
+    int beats() const
+    {
+        return beats_;
+    }
+
+    void process(uint64_t first, float* data, size_t channel_stride, int count) override;
+
+    PulseCorrectionStats stats() const;
+
+  private:
+    static constexpr int k_max_pending = 8;
+
+    void restart(uint64_t first);
+    void begin_beat(uint64_t peak, uint64_t detected);
+    void fold_epoch(uint64_t peak);
+    void record(const float* data, size_t channel_stride, uint64_t index, int count);
+    void subtract(float* data, size_t channel_stride, uint64_t index, int count) const;
+
+    // Configuration
+    bool active_ = false;
+    std::vector<int> channels_;
+    int ecg_channel_ = -1;
+    double sample_rate_hz_ = 0.0;
+    int length_ = 0;
+    int baseline_ = 0;  // Leading samples of each epoch that set its baseline
+    int beats_ = 0;
+    RPeakDetector detector_;
+
+    // Recent samples per channel before correction, circular by absolute index
+    AlignedBuffer<float> raw_;
+    uint64_t next_index_ = 0;
+    uint64_t history_start_ = 0;
+    bool started_ = false;
+
+    // Sliding template: stored epochs, their sums and the mean
+    AlignedBuffer<float> stored_;  // beats_ x channels x length_
+    std::vector<double> sums_;     // channels x length_
+    AlignedBuffer<float> mean_;    // channels x length_
+    std::vector<float> epoch_;     // One channel's epoch
+    int filled_ = 0;
+    int next_slot_ = 0;
+
+    // Beat being corrected, and R-peaks whose epochs are not complete yet
+    bool in_beat_ = false;
+    uint64_t beat_start_ = 0;
+    uint64_t pending_[k_max_pending] = {};
+    int pending_count_ = 0;
+
+    // Published for stats()
+    std::atomic<uint64_t> detected_{0};
+    std::atomic<int> template_beats_{0};
+    std::atomic<uint64_t> rr_samples_{0};
+    std::atomic<uint64_t> last_delay_{0};
+    std::atomic<uint64_t> max_delay_{0};
+    UpdateTimer updates_;
+};
+
+}  // namespace elda::dsp
@@ -0,0 +1,172 @@
+#include "real_fft.h"
+
+#include "core/simd.h"
+
+#include <cassert>
+#include <cmath>
+#include <map>
+#include <mutex>
+
+namespace elda::dsp
+{
+
+namespace
+{
+constexpr double k_two_pi = 6.283185307179586476925286766559;
+}  // namespace
+
+std::shared_ptr<const RealFft> RealFft::plan(int size)
+{
+    static std::mutex mutex;
+    static std::map<int, std::shared_ptr<const RealFft>> plans;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    std::shared_ptr<const RealFft>& plan = plans[size];
+    if (!plan)
+    {
+        plan = std::make_shared<const RealFft>(size);
+    }
+    return plan;
+}
+
+RealFft::RealFft(int size) : size_(size), half_(size / 2)
+{
+    assert(size >= 16 && (size & (size - 1)) == 0);
+
+    int log2_half = 0;
+    while ((1 << log2_half) < half_)
+    {
+        ++log2_half;
+    }
+    bit_reverse_.resize(static_cast<size_t>(half_));
+    for (int k = 0; k < half_; ++k)
+    {
+        int reversed = 0;
+        for (int b = 0; b < log2_half; ++b)
+        {
+            reversed |= ((k >> b) & 1) << (log2_half - 1 - b);
+        }
+        bit_reverse_[k] = reversed;
+    }
+
+    // Twiddles in double, rounded once: errors do not compound across stages
+    stage_re_.resize(static_cast<size_t>(half_));
+    stage_im_.resize(static_cast<size_t>(half_));
+    for (int h = 1; h < half_; h *= 2)
+    {
+        for (int j = 0; j < h; ++j)
+        {
+            const double angle = -k_two_pi * j / (2.0 * h);
+            stage_re_[h - 1 + j] = static_cast<float>(std::cos(angle));
+            stage_im_[h - 1 + j] = static_cast<float>(std::sin(angle));
+        }
+    }
+
+    split_re_.resize(static_cast<size_t>(half_) + 1);
+    split_im_.resize(static_cast<size_t>(half_) + 1);
+    for (int k = 0; k <= half_; ++k)
+    {
+        const double angle = -k_two_pi * k / size_;
+        split_re_[k] = static_cast<float>(std::cos(angle));
+        split_im_[k] = static_cast<float>(std::sin(angle));
+    }
+}
+
+void RealFft::transform(float* re, float* im) const
+{
+    using namespace simd;
+
+    for (int h = 1; h < half_; h *= 2)
+    {
+        const float* w_re = stage_re_.data() + (h - 1);
+        const float* w_im = stage_im_.data() + (h - 1);
+        for (int group = 0; group < half_; group += 2 * h)
+        {
+            float* a_re = re + group;
+            float* a_im = im + group;
+            float* b_re = a_re + h;
+            float* b_im = a_im + h;
+
+            int j = 0;
+            for (; j + 4 <= h; j += 4)
+            {
+                const f32x4 wr = load(w_re + j);
+                const f32x4 wi = load(w_im + j);
+                const f32x4 br = load(b_re + j);
+                const f32x4 bi = load(b_im + j);
+                const f32x4 tr = sub(mul(br, wr), mul(bi, wi));
+                const f32x4 ti = madd(br, wi, mul(bi, wr));
+                const f32x4 ar = load(a_re + j);
+                const f32x4 ai = load(a_im + j);
+                store(a_re + j, add(ar, tr));
+                store(a_im + j, add(ai, ti));
+                store(b_re + j, sub(ar, tr));
+                store(b_im + j, sub(ai, ti));
+            }
+            // First two stages (h = 1, 2) have fewer butterflies than lanes
+            for (; j < h; ++j)
+            {
+                const float tr = b_re[j] * w_re[j] - b_im[j] * w_im[j];
+                const float ti = b_re[j] * w_im[j] + b_im[j] * w_re[j];
+                const float ar = a_re[j];
+                const float ai = a_im[j];
+                a_re[j] = ar + tr;
+                a_im[j] = ai + ti;
+                b_re[j] = ar - tr;
+                b_im[j] = ai - ti;
+            }
+        }
+    }
+}
+
+void RealFft::forward(const float* input, float* re, float* im, Workspace& workspace) const
+{
+    workspace.re.resize(static_cast<size_t>(half_));
+    workspace.im.resize(static_cast<size_t>(half_));
+    float* z_re = workspace.re.data();
+    float* z_im = workspace.im.data();
+
+    // Pack even / odd samples as one complex sequence, in bit-reversed order for the in-place stages
+    for (int k = 0; k < half_; ++k)
+    {
+        const int source = 2 * bit_reverse_[k];
+        z_re[k] = input[source];
+        z_im[k] = input[source + 1];
+    }
+    transform(z_re, z_im);
+
+    // X[k] = E[k] + W^k O[k]; E and O are the spectra of the even and odd samples
+    for (int k = 0; k <= half_; ++k)
+    {
+        const int a_index = k == half_ ? 0 : k;
+        const int c_index = k == 0 ? 0 : half_ - k;
+        const float a = z_re[a_index];
+        const float b = z_im[a_index];
+        const float c = z_re[c_index];
+        const float d = z_im[c_index];
+
+        const float even_re = 0.5f * (a + c);
+        const float even_im = 0.5f * (b - d);
+        const float odd_re = 0.5f * (b + d);
+        const float odd_im = -0.5f * (a - c);
+
+        re[k] = even_re + split_re_[k] * odd_re - split_im_[k] * odd_im;
+        im[k] = even_im + split_re_[k] * odd_im + split_im_[k] * odd_re;
+    }
+}
+
+void RealFft::power(const float* input, float* power, int bins, Workspace& workspace) const
+{
+    workspace.spectrum_re.resize(static_cast<size_t>(half_) + 1);
+    workspace.spectrum_im.resize(static_cast<size_t>(half_) + 1);
+    const float* re = workspace.spectrum_re.data();
+    const float* im = workspace.spectrum_im.data();
+
+    forward(input, workspace.spectrum_re.data(), workspace.spectrum_im.data(), workspace);
+    for (int k = 0; k < bins; ++k)
+    {
+        power[k] = re[k] * re[k] + im[k] * im[k];
+    }
+}
+
+}  // namespace elda::dsp
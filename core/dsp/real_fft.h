@@ -0,0 +1,80 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+namespace elda::dsp
+{
+
+/**
+ * RealFft - forward FFT of real input, planned once per size
+ *
+ * A real block of N samples is packed into N/2 complex values (even samples
+ * real, odd samples imaginary), run through an iterative radix-2 transform and
+ * split back into the N/2 + 1 bins of the real spectrum. Data stays in split
+ * re/im arrays, so every butterfly stage with four or more butterflies per
+ * group runs four lanes at a time through core/simd.h.
+ *
+ * A plan holds only read-only tables (bit reversal, per-stage twiddles), so one
+ * plan is shared by all threads; scratch memory lives in a caller-owned
+ * Workspace, one per thread.
+ */
+class RealFft
+{
+  public:
+    /**
+     * Per-thread scratch for forward()
+     */
+    struct Workspace
+    {
+        std::vector<float> re;           // N/2 packed complex values
+        std::vector<float> im;
+        std::vector<float> spectrum_re;  // power(): N/2 + 1 bins
+        std::vector<float> spectrum_im;
+    };
+
+    /**
+     * Shared plan for a size; plans are built on first use and cached for the process lifetime
+     * @param size Power of two, >= 16
+     */
+    static std::shared_ptr<const RealFft> plan(int size);
+
+    explicit RealFft(int size);
+
+    int size() const
+    {
+        return size_;
+    }
+
+    // Bins of the one-sided spectrum (DC .. Nyquist)
+    int bins() const
+    {
+        return size_ / 2 + 1;
+    }
+
+    /**
+     * Spectrum of size() real samples
+     * @param input size() samples
+     * @param re,im bins() outputs each
+     */
+    void forward(const float* input, float* re, float* im, Workspace& workspace) const;
+
+    /**
+     * Squared magnitude |X_k|^2 of the first `bins` bins
+     * @param power bins outputs (bins <= bins())
+     */
+    void power(const float* input, float* power, int bins, Workspace& workspace) const;
+
+  private:
+    void transform(float* re, float* im) const;
+
+    int size_ = 0;
+    int half_ = 0;                  // Complex transform length (size_ / 2)
+    std::vector<int> bit_reverse_;  // half_ entries
+    std::vector<float> stage_re_;   // Stage with h butterflies per group: twiddles [h - 1, 2h - 1)
+    std::vector<float> stage_im_;
+    std::vector<float> split_re_;  // exp(-2 pi i k / size_), k in [0, half_]
+    std::vector<float> split_im_;
+};
+
+}  // namespace elda::dsp
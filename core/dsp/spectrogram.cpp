@@ -0,0 +1,231 @@
+#include "spectrogram.h"
+
+#include "core/simd.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace elda::dsp
+{
+
+namespace
+{
+constexpr double k_two_pi = 6.283185307179586476925286766559;
+constexpr int k_overlap = 8;           // Frames per fft_size samples
+constexpr float k_min_power = 1e-10f;  // Keeps log10 finite (== k_floor_db)
+constexpr int k_min_fft_size = 16;
+
+// Frame start that is still safe to read: one frame of slack ahead of the producer's overwrite point
+uint64_t first_safe_frame(uint64_t published, int capacity, int fft_size, int hop)
+{
+    const uint64_t retained = std::min<uint64_t>(published, static_cast<uint64_t>(capacity));
+    const uint64_t oldest = published - retained + static_cast<uint64_t>(fft_size);
+    return (oldest + static_cast<uint64_t>(hop) - 1) / static_cast<uint64_t>(hop);
+}
+}  // namespace
+
+SpectrogramShape SpectrogramShape::for_rate(double sample_rate_hz, double max_hz, int history)
+{
+    SpectrogramShape shape;
+    shape.fft_size = k_min_fft_size;
+    while (shape.fft_size < sample_rate_hz)
+    {
+        shape.fft_size *= 2;
+    }
+    shape.hop = shape.fft_size / k_overlap;
+
+    const double bin_hz = sample_rate_hz / shape.fft_size;
+    const int all_bins = shape.fft_size / 2 + 1;
+    shape.bins = std::clamp(static_cast<int>(std::ceil(max_hz / bin_hz)) + 1, 1, all_bins);
+    shape.history = std::max(1, history);
+    return shape;
+}
+
+void StreamingSpectrogram::configure(const std::vector<int>& channels,
+                                     double sample_rate_hz,
+                                     const SpectrogramShape& shape,
+                                     const Montage* montage)
+{
+    channels_ = channels;
+    montage_ = montage;
+    montage_generation_ = montage ? montage->generation() : 0;
+    sample_rate_hz_ = sample_rate_hz;
+    shape_ = shape;
+    fft_ = RealFft::plan(shape_.fft_size);
+
+    window_.resize(static_cast<size_t>(shape_.fft_size));
+    double window_power = 0.0;
+    for (int n = 0; n < shape_.fft_size; ++n)
+    {
+        const double w = 0.5 - 0.5 * std::cos(k_two_pi * n / shape_.fft_size);
+        window_[n] = static_cast<float>(w);
+        window_power += w * w;
+    }
+    psd_scale_ = static_cast<float>(2.0 / (sample_rate_hz_ * window_power));
+
+    columns_.assign(static_cast<size_t>(shape_.history) * column_stride(), k_floor_db);
+    next_frame_ = 0;
+    first_valid_ = 0;
+    last_published_ = 0;
+    ++generation_;
+}
+
+int StreamingSpectrogram::advance(const SampleRing& ring,
+                                  uint64_t published,
+                                  int64_t budget,
+                                  WorkerPool& pool,
+                                  const SampleRing* average)
+{
+    if (channels_.empty() || !fft_)
+    {
+        return 0;
+    }
+
+    // The ring restarted (new monitoring session): frame indices start over
+    if (published < last_published_)
+    {
+        std::fill(columns_.begin(), columns_.end(), k_floor_db);
+        next_frame_ = 0;
+        first_valid_ = 0;
+        ++generation_;
+    }
+    last_published_ = published;
+
+    const auto fft_size = static_cast<uint64_t>(shape_.fft_size);
+    const auto hop = static_cast<uint64_t>(shape_.hop);
+    const auto history = static_cast<uint64_t>(shape_.history);
+    if (published < fft_size)
+    {
+        return 0;
+    }
+
+    // Frames [next_frame_, end_frame) are complete; skip what scrolled out or is no longer retained
+    const uint64_t end_frame = (published - fft_size) / hop + 1;
+    const uint64_t first_kept = end_frame > history ? end_frame - history : 0;
+    const uint64_t first_retained = first_safe_frame(published, ring.capacity(), shape_.fft_size, shape_.hop);
+    const uint64_t first = std::max(first_kept, first_retained);
+    if (next_frame_ < first)
+    {
+        clear_frames(next_frame_, first);
+        next_frame_ = first;
+        first_valid_ = first;
+    }
+    if (next_frame_ >= end_frame)
+    {
+        return 0;
+    }
+
+    const int64_t frame_cost = static_cast<int64_t>(fft_size) * rows();
+    const auto affordable = static_cast<uint64_t>(std::max<int64_t>(1, budget / std::max<int64_t>(1, frame_cost)));
+    const auto frames = static_cast<int>(std::min(end_frame - next_frame_, affordable));
+
+    const uint64_t first_frame = next_frame_;
+    const int row_count = rows();
+    pool.parallel_for(frames * row_count,
+                      [&](int index)
+                      {
+                          const uint64_t frame = first_frame + static_cast<uint64_t>(index / row_count);
+                          transform_row(ring, average, frame, index % row_count);
+                      });
+
+    next_frame_ += static_cast<uint64_t>(frames);
+    return frames;
+}
+
+double StreamingSpectrogram::band_power(int row, double low_hz, double high_hz, int frames) const
+{
+    const auto history = static_cast<uint64_t>(shape_.history);
+    const uint64_t wanted = std::min<uint64_t>(static_cast<uint64_t>(std::max(1, frames)), history);
+    const uint64_t first = std::max(first_valid_, next_frame_ > wanted ? next_frame_ - wanted : 0);
+    if (row < 0 || row >= rows() || first >= next_frame_)
+    {
+        return 0.0;
+    }
+
+    const int low_bin = std::max(0, static_cast<int>(std::ceil(low_hz / bin_hz())));
+    const int high_bin = std::min(shape_.bins - 1, static_cast<int>(std::floor(high_hz / bin_hz())));
+    double sum = 0.0;
+    for (uint64_t frame = first; frame < next_frame_; ++frame)
+    {
+        const float* values = column(frame) + static_cast<size_t>(row) * shape_.bins;
+        for (int k = low_bin; k <= high_bin; ++k)
+        {
+            sum += std::pow(10.0, values[k] / 10.0);
+        }
+    }
+    return sum * bin_hz() / static_cast<double>(next_frame_ - first);
+}
+
+void StreamingSpectrogram::clear_frames(uint64_t first, uint64_t end)
+{
+    const auto history = static_cast<uint64_t>(shape_.history);
+    first = std::max(first, end > history ? end - history : 0);
+    for (uint64_t frame = first; frame < end; ++frame)
+    {
+        float* column = columns_.data() + static_cast<size_t>(frame % history) * column_stride();
+        std::fill(column, column + column_stride(), k_floor_db);
+    }
+}
+
+void StreamingSpectrogram::transform_row(const SampleRing& ring, const SampleRing* average, uint64_t frame, int row)
+{
+    using namespace simd;
+
+    const auto slot = static_cast<size_t>(frame % static_cast<uint64_t>(shape_.history));
+    float* out = columns_.data() + slot * column_stride() + static_cast<size_t>(row) * shape_.bins;
+    const int channel = channels_[row];
+    const bool valid = montage_ ? channel >= 0 && channel < montage_->rows() && !montage_->empty(channel)
+                                : channel >= 0 && channel < ring.channels();
+    if (!valid)
+    {
+        std::fill(out, out + shape_.bins, k_floor_db);
+        return;
+    }
+
+    // Scratch per pool thread; sized by the first frame it sees
+    thread_local std::vector<float> windowed;
+    thread_local RealFft::Workspace workspace;
+    windowed.resize(static_cast<size_t>(shape_.fft_size));
+
+    // Gather the frame in ring runs (ring end, tile edges) and apply the window on the way
+    uint64_t index = frame * static_cast<uint64_t>(shape_.hop);
+    if (montage_)
+    {
+        montage_->evaluate(ring, average, channel, index, shape_.fft_size, windowed.data());
+        int k = 0;
+        for (; k + 4 <= shape_.fft_size; k += 4)
+        {
+            store(windowed.data() + k, mul(load(windowed.data() + k), load(window_.data() + k)));
+        }
+        for (; k < shape_.fft_size; ++k)
+        {
+            windowed[k] *= window_[k];
+        }
+    }
+    int n = montage_ ? shape_.fft_size : 0;
+    while (n < shape_.fft_size)
+    {
+        int length = 0;
+        const float* src = ring.run(channel, ring.slot_of(index), length);
+        const int count = std::min(length, shape_.fft_size - n);
+        int k = 0;
+        for (; k + 4 <= count; k += 4)
+        {
+            store(windowed.data() + n + k, mul(load(src + k), load(window_.data() + n + k)));
+        }
+        for (; k < count; ++k)
+        {
+            windowed[n + k] = src[k] * window_[n + k];
+        }
+        n += count;
+        index += static_cast<uint64_t>(count);
+    }
+
+    fft_->power(windowed.data(), out, shape_.bins, workspace);
+    for (int k = 0; k < shape_.bins; ++k)
+    {
+        out[k] = 10.0f * std::log10(std::max(out[k] * psd_scale_, k_min_power));
+    }
+}
+
+}  // namespace elda::dsp
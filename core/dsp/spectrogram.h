@@ -0,0 +1,175 @@
+#pragma once
+
+#include "core/dsp/montage.h"
+#include "core/dsp/real_fft.h"
+#include "core/sample_ring.h"
+#include "core/worker_pool.h"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace elda::dsp
+{
+
+/**
+ * Frame geometry of a spectrogram
+ */
+struct SpectrogramShape
+{
+    int fft_size = 1024;  // Samples per frame (power of two)
+    int hop = 128;        // Samples between frame starts
+    int bins = 0;         // Bins kept from DC up
+    int history = 256;    // Columns retained
+
+    /**
+     * About 1 Hz bins, 8x overlap, and the bins up to max_hz
+     */
+    static SpectrogramShape for_rate(double sample_rate_hz, double max_hz, int history);
+
+    bool operator==(const SpectrogramShape& other) const
+    {
+        return fft_size == other.fft_size && hop == other.hop && bins == other.bins && history == other.history;
+    }
+    bool operator!=(const SpectrogramShape& other) const
+    {
+        return !(*this == other);
+    }
+};
+
+/**
+ * StreamingSpectrogram - Hann-windowed short-time power spectra of several ring channels
+ *
+ * Frame f covers ring samples [f * hop, f * hop + fft_size), so frames line up
+ * across channels and column f of every row describes the same time span.
+ * advance() transforms the frames that completed since the previous call and
+ * stores them as dB power spectral density (µV²/Hz) in a ring of history()
+ * columns: frame f lands in column slot f % history(), laid out [row][bin].
+ *
+ * Work is capped per call, so a backlog (first start, or a window switched to
+ * the spectrogram after minutes of monitoring) is worked off over several UI
+ * frames. Frames older than the history, or no longer retained by the ring,
+ * are skipped; their slots are cleared to the floor.
+ *
+ * With a montage, rows are montage rows: each frame is evaluated from the ring
+ * (and the common average ring) before windowing. The montage must not be
+ * rebuilt while advance() runs; a rebuilt montage needs configure() again.
+ *
+ * Threading contract: one caller (the UI thread); each call fans its rows out on
+ * the pool. Column data is stable between calls.
+ */
+class StreamingSpectrogram
+{
+  public:
+    /**
+     * Re-shape and clear
+     * @param channels Ring channel per row (-1 = row left at the floor); montage row when montage is set
+     * @param montage Rows as combinations of ring channels (nullptr = referential)
+     */
+    void configure(const std::vector<int>& channels,
+                   double sample_rate_hz,
+                   const SpectrogramShape& shape,
+                   const Montage* montage = nullptr);
+
+    /**
+     * Transform the frames completed by `published`, oldest first
+     * @param budget Samples to transform this call (frame size x rows per frame); one frame always runs when due
+     * @param average Common average ring read by the montage
+     * @return Frames completed this call
+     */
+    int advance(const SampleRing& ring,
+                uint64_t published,
+                int64_t budget,
+                WorkerPool& pool,
+                const SampleRing* average = nullptr);
+
+    /**
+     * Frame index one past the newest completed frame
+     */
+    uint64_t next_frame() const
+    {
+        return next_frame_;
+    }
+
+    /**
+     * Bumped whenever every column was reset (configure, ring restart); consumers mirroring the columns start over
+     */
+    uint64_t generation() const
+    {
+        return generation_;
+    }
+
+    /**
+     * dB values of one frame's column, [row][bin]
+     */
+    const float* column(uint64_t frame) const
+    {
+        return columns_.data() + static_cast<size_t>(frame % static_cast<uint64_t>(shape_.history)) * column_stride();
+    }
+
+    /**
+     * Power of one row in [low_hz, high_hz], averaged over the newest computed frames (Welch-style)
+     * @param frames Frames to average; fewer are used until that many were computed
+     * @return µV² (integral of the PSD over the band); 0 before the first frame
+     */
+    double band_power(int row, double low_hz, double high_hz, int frames) const;
+
+    const SpectrogramShape& shape() const
+    {
+        return shape_;
+    }
+    const std::vector<int>& channels() const
+    {
+        return channels_;
+    }
+    int rows() const
+    {
+        return static_cast<int>(channels_.size());
+    }
+    double sample_rate_hz() const
+    {
+        return sample_rate_hz_;
+    }
+    const Montage* montage() const
+    {
+        return montage_;
+    }
+    // Montage::generation() the rows were configured for
+    uint64_t montage_generation() const
+    {
+        return montage_generation_;
+    }
+    double bin_hz() const
+    {
+        return sample_rate_hz_ / shape_.fft_size;
+    }
+
+    // dB written for bins without data
+    static constexpr float k_floor_db = -100.0f;
+
+  private:
+    size_t column_stride() const
+    {
+        return static_cast<size_t>(rows()) * shape_.bins;
+    }
+
+    void clear_frames(uint64_t first, uint64_t end);
+    void transform_row(const SampleRing& ring, const SampleRing* average, uint64_t frame, int row);
+
+    std::vector<int> channels_;
+    const Montage* montage_ = nullptr;
+    uint64_t montage_generation_ = 0;
+    double sample_rate_hz_ = 0.0;
+    SpectrogramShape shape_;
+    std::shared_ptr<const RealFft> fft_;
+    std::vector<float> window_;  // Hann, fft_size
+    float psd_scale_ = 1.0f;     // |X|^2 -> one-sided PSD
+
+    std::vector<float> columns_;  // history x rows x bins
+    uint64_t next_frame_ = 0;
+    uint64_t first_valid_ = 0;  // Frames below this were skipped (floor), not computed
+    uint64_t last_published_ = 0;
+    uint64_t generation_ = 0;
+};
+
+}  // namespace elda::dsp
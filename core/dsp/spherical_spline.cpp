@@ -0,0 +1,212 @@
+#include "spherical_spline.h"
+
+#include "core/simd.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+namespace elda::dsp
+{
+
+namespace
+{
+constexpr double k_four_pi = 12.566370614359172953850573533118;
+
+// Legendre series of g: weight[n] = (2n + 1) / (n (n + 1))^order / (4 pi), plus the P_n recurrence
+// coefficients P_{n+1} = a[n] x P_n - b[n] P_{n-1}, so evaluating g needs no divisions
+struct Series
+{
+    std::vector<double> weight;
+    std::vector<double> a;
+    std::vector<double> b;
+};
+
+Series make_series(const SphericalSpline::Options& options)
+{
+    Series series;
+    const auto size = static_cast<size_t>(std::max(1, options.terms)) + 1;
+    series.weight.assign(size, 0.0);
+    series.a.assign(size, 0.0);
+    series.b.assign(size, 0.0);
+    for (size_t n = 1; n < size; ++n)
+    {
+        const auto nd = static_cast<double>(n);
+        series.weight[n] = (2.0 * nd + 1.0) / std::pow(nd * (nd + 1.0), options.order) / k_four_pi;
+        series.a[n] = (2.0 * nd + 1.0) / (nd + 1.0);
+        series.b[n] = nd / (nd + 1.0);
+    }
+    return series;
+}
+
+double g(double cosine, const Series& series)
+{
+    const double x = std::clamp(cosine, -1.0, 1.0);
+    const size_t size = series.weight.size();
+    double p_previous = 1.0;  // P_0
+    double p = x;             // P_1
+    double sum = series.weight[1] * p;
+    for (size_t n = 1; n + 1 < size; ++n)
+    {
+        const double p_next = series.a[n] * x * p - series.b[n] * p_previous;
+        p_previous = p;
+        p = p_next;
+        sum += series.weight[n + 1] * p;
+    }
+    return sum;
+}
+
+double dot(const SpherePoint& a, const SpherePoint& b)
+{
+    return a.x * b.x + a.y * b.y + a.z * b.z;
+}
+
+// In-place Gauss-Jordan inverse with partial pivoting; false if singular
+bool invert(std::vector<double>& a, int n)
+{
+    std::vector<double> inverse(static_cast<size_t>(n) * n, 0.0);
+    for (int i = 0; i < n; ++i)
+    {
+        inverse[static_cast<size_t>(i) * n + i] = 1.0;
+    }
+
+    for (int column = 0; column < n; ++column)
+    {
+        int pivot = column;
+        double largest = std::abs(a[static_cast<size_t>(column) * n + column]);
+        for (int row = column + 1; row < n; ++row)
+        {
+            const double magnitude = std::abs(a[static_cast<size_t>(row) * n + column]);
+            if (magnitude > largest)
+            {
+                pivot = row;
+                largest = magnitude;
+            }
+        }
+        if (largest < 1e-300)
+        {
+            return false;
+        }
+        if (pivot != column)
+        {
+            std::swap_ranges(a.begin() + static_cast<std::ptrdiff_t>(pivot) * n,
+                             a.begin() + static_cast<std::ptrdiff_t>(pivot + 1) * n,
+                             a.begin() + static_cast<std::ptrdiff_t>(column) * n);
+            std::swap_ranges(inverse.begin() + static_cast<std::ptrdiff_t>(pivot) * n,
+                             inverse.begin() + static_cast<std::ptrdiff_t>(pivot + 1) * n,
+                             inverse.begin() + static_cast<std::ptrdiff_t>(column) * n);
+        }
+
+        double* pivot_row = a.data() + static_cast<size_t>(column) * n;
+        double* pivot_inverse = inverse.data() + static_cast<size_t>(column) * n;
+        const double scale = 1.0 / pivot_row[column];
+        for (int k = 0; k < n; ++k)
+        {
+            pivot_row[k] *= scale;
+            pivot_inverse[k] *= scale;
+        }
+
+        for (int row = 0; row < n; ++row)
+        {
+            const double factor = a[static_cast<size_t>(row) * n + column];
+            if (row == column || factor == 0.0)
+            {
+                continue;
+            }
+            double* target = a.data() + static_cast<size_t>(row) * n;
+            double* target_inverse = inverse.data() + static_cast<size_t>(row) * n;
+            for (int k = 0; k < n; ++k)
+            {
+                target[k] -= factor * pivot_row[k];
+                target_inverse[k] -= factor * pivot_inverse[k];
+            }
+        }
+    }
+
+    a.swap(inverse);
+    return true;
+}
+}  // namespace
+
+bool SphericalSpline::build(const std::vector<SpherePoint>& electrodes,
+                            const std::vector<SpherePoint>& targets,
+                            const Options& options)
+{
+    electrodes_ = 0;
+    targets_ = 0;
+    stride_ = 0;
+    weights_.clear();
+    if (electrodes.empty())
+    {
+        return false;
+    }
+
+    const int e = static_cast<int>(electrodes.size());
+    const int n = e + 1;
+    const Series series = make_series(options);
+
+    // [G + lambda I, 1; 1^T, 0]; symmetric, so its inverse is too
+    std::vector<double> system(static_cast<size_t>(n) * n, 0.0);
+    for (int i = 0; i < e; ++i)
+    {
+        for (int j = i; j < e; ++j)
+        {
+            const double value = g(dot(electrodes[i], electrodes[j]), series) + (i == j ? options.lambda : 0.0);
+            system[static_cast<size_t>(i) * n + j] = value;
+            system[static_cast<size_t>(j) * n + i] = value;
+        }
+        system[static_cast<size_t>(i) * n + e] = 1.0;
+        system[static_cast<size_t>(e) * n + i] = 1.0;
+    }
+    if (!invert(system, n))
+    {
+        return false;
+    }
+
+    // weights[i][t] = sum_k [g(t, k) | 1] * inverse[i][k] (inverse is symmetric): value at t per unit at i
+    electrodes_ = e;
+    targets_ = static_cast<int>(targets.size());
+    stride_ = (targets_ + 3) & ~3;
+    weights_.assign(static_cast<size_t>(e) * stride_, 0.0f);
+
+    std::vector<double> row(static_cast<size_t>(n));
+    for (int t = 0; t < targets_; ++t)
+    {
+        for (int k = 0; k < e; ++k)
+        {
+            row[k] = g(dot(targets[t], electrodes[k]), series);
+        }
+        row[e] = 1.0;
+
+        for (int i = 0; i < e; ++i)
+        {
+            double sum = 0.0;
+            for (int k = 0; k < n; ++k)
+            {
+                sum += row[k] * system[static_cast<size_t>(i) * n + k];
+            }
+            weights_[static_cast<size_t>(i) * stride_ + t] = static_cast<float>(sum);
+        }
+    }
+    return true;
+}
+
+void SphericalSpline::interpolate(const float* values, float* out) const
+{
+    using namespace simd;
+
+    accumulator_.assign(static_cast<size_t>(stride_), 0.0f);
+    float* sum = accumulator_.data();
+    for (int i = 0; i < electrodes_; ++i)
+    {
+        const float* column = weights_.data() + static_cast<size_t>(i) * stride_;
+        const f32x4 value = set1(values[i]);
+        for (int t = 0; t < stride_; t += 4)
+        {
+            store(sum + t, madd(load(column + t), value, load(sum + t)));
+        }
+    }
+    std::copy(sum, sum + targets_, out);
+}
+
+}  // namespace elda::dsp
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <vector>
+
+namespace elda::dsp
+{
+
+/**
+ * Point on the unit sphere
+ */
+struct SpherePoint
+{
+    double x = 0.0;
+    double y = 0.0;
+    double z = 1.0;
+};
+
+/**
+ * SphericalSpline - precomputed spherical-spline interpolation (Perrin et al., 1989)
+ *
+ * The interpolant through electrode values v_i is
+ *     V(r) = c0 + sum_i c_i g(cos(r, r_i)),
+ *     g(x) = 1/(4 pi) sum_{n=1..terms} (2n + 1) / (n (n + 1))^order P_n(x),
+ * with c and c0 solved from [G + lambda I, 1; 1^T, 0] [c; c0] = [v; 0].
+ * Everything except v is fixed by the geometry, so build() folds the solve and
+ * the evaluation at every target into one targets x electrodes matrix, and each
+ * update is a single matrix-vector product.
+ *
+ * The matrix is stored electrode-major with the target count padded to four, so
+ * interpolate() accumulates one electrode's column into all targets at a time
+ * with core/simd.h lanes and no horizontal sums.
+ */
+class SphericalSpline
+{
+  public:
+    struct Options
+    {
+        int order = 4;         // m: stiffness of the spline
+        int terms = 50;        // Legendre terms of g
+        double lambda = 1e-5;  // Smoothing added to the diagonal of G
+    };
+
+    /**
+     * Precompute the interpolation matrix for one electrode layout
+     * @return false if the system is singular (e.g. two electrodes at the same spot)
+     */
+    bool build(const std::vector<SpherePoint>& electrodes,
+               const std::vector<SpherePoint>& targets,
+               const Options& options);
+
+    bool build(const std::vector<SpherePoint>& electrodes, const std::vector<SpherePoint>& targets)
+    {
+        return build(electrodes, targets, Options{});
+    }
+
+    /**
+     * @param values electrodes() values
+     * @param out targets() values
+     */
+    void interpolate(const float* values, float* out) const;
+
+    int electrodes() const
+    {
+        return electrodes_;
+    }
+    int targets() const
+    {
+        return targets_;
+    }
+
+  private:
+    int electrodes_ = 0;
+    int targets_ = 0;
+    int stride_ = 0;              // targets_ rounded up to 4
+    std::vector<float> weights_;  // [electrode][target]
+    mutable std::vector<float> accumulator_;
+};
+
+}  // namespace elda::dsp
@@ -0,0 +1,37 @@
+#include "frame_pacer.h"
+
+#include <algorithm>
+
+namespace elda
+{
+
+double FramePacer::wait_timeout(double now, bool animating, double cap_hz) const
+{
+    if (!animating && settle_left_ > 0)
+    {
+        return 0.0;
+    }
+
+    const double interval = animating && cap_hz > 0.0 ? 1.0 / cap_hz : settings_.idle_timeout_seconds;
+    return std::max(0.0, last_frame_ + interval - now);
+}
+
+void FramePacer::on_event(bool animating)
+{
+    // While animating the next frame is already on its way; input just rides along with it
+    if (!animating)
+    {
+        settle_left_ = std::max(1, settings_.settle_frames + 1);
+    }
+}
+
+void FramePacer::frame_presented(double now)
+{
+    last_frame_ = now;
+    if (settle_left_ > 0)
+    {
+        --settle_left_;
+    }
+}
+
+}  // namespace elda
@@ -0,0 +1,62 @@
+#pragma once
+
+namespace elda
+{
+
+/**
+ * FramePacer - decides when the main loop draws its next frame
+ *
+ * While something animates (the sweep during monitoring, a toast fading) frames
+ * are spaced by the monitoring cap; anything faster than the cap just waits out
+ * the rest of the interval, so a busy mouse cannot push the frame rate past it.
+ * Otherwise the loop sleeps in glfwWaitEventsTimeout() and only draws when input
+ * arrives, plus a few settle frames so ImGui can finish hover/active state changes,
+ * and once per idle timeout so the text caret keeps blinking.
+ *
+ * Pure timing logic: the caller owns the clock and the event wait.
+ *
+ *     for (double t; (t = pacer.wait_timeout(now(), animating, cap)) > 0.0;)
+ *         if (wait_events(t) returned early) pacer.on_event(animating);
+ *     ... draw ...
+ *     pacer.frame_presented(now());
+ */
+class FramePacer
+{
+  public:
+    struct Settings
+    {
+        double idle_timeout_seconds = 0.5;  // Longest sleep without input (caret blink, tooltip delays)
+        int settle_frames = 2;              // Extra frames drawn after input while idle
+    };
+
+    FramePacer() = default;
+    explicit FramePacer(Settings settings) : settings_(settings)
+    {
+    }
+
+    /**
+     * Time left before the next frame is due
+     * @param now Current time (seconds, same clock as frame_presented())
+     * @param animating Something on screen changes without input
+     * @param cap_hz Frame-rate cap while animating
+     * @return Seconds to wait for events; 0 = draw now
+     */
+    double wait_timeout(double now, bool animating, double cap_hz) const;
+
+    /**
+     * An event woke the wait before its timeout
+     */
+    void on_event(bool animating);
+
+    /**
+     * A frame was drawn and swapped
+     */
+    void frame_presented(double now);
+
+  private:
+    Settings settings_;
+    double last_frame_ = 0.0;
+    int settle_left_ = 0;
+};
+
+}  // namespace elda
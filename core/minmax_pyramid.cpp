@@ -0,0 +1,265 @@
+#include "minmax_pyramid.h"
+
+#include "core/simd.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace elda
+{
+
+namespace
+{
+constexpr float k_empty_lo = std::numeric_limits<float>::infinity();
+constexpr float k_empty_hi = -std::numeric_limits<float>::infinity();
+
+// Fold ring samples [first, last) of one channel, walking contiguous runs
+void fold_samples(const SampleRing& ring, int channel, uint64_t first, uint64_t last, float& lo, float& hi)
+{
+    while (first < last)
+    {
+        int length = 0;
+        const float* src = ring.run(channel, ring.slot_of(first), length);
+        const int count = static_cast<int>(std::min<uint64_t>(static_cast<uint64_t>(length), last - first));
+        simd::fold_minmax(src, count, lo, hi);
+        first += static_cast<uint64_t>(count);
+    }
+}
+
+// First bin index whose data is still retained, given the newest count and the ring size
+uint64_t oldest_retained(uint64_t published, uint64_t capacity)
+{
+    return published > capacity ? published - capacity : 0;
+}
+}  // namespace
+
+MinMaxPyramid::MinMaxPyramid(const SampleRing& ring)
+{
+    configure(ring);
+}
+
+void MinMaxPyramid::configure(const SampleRing& ring)
+{
+    channels_ = ring.channels();
+    const auto retained = static_cast<uint64_t>(ring.capacity());
+
+    level_count_ = 0;
+    for (int l = 1; l <= k_max_levels; ++l)
+    {
+        Level& level = levels_[l - 1];
+        const uint64_t bins = retained / bin_samples(l);
+        if (bins < 2)
+        {
+            // Too coarse to help: release what an earlier, longer session used
+            level.capacity = 0;
+            level.lo = AlignedBuffer<float>();
+            level.hi = AlignedBuffer<float>();
+            continue;
+        }
+
+        // +2: the bin being built and one of slack for readers holding an older snapshot
+        level.capacity = static_cast<int>(bins) + 2;
+        const size_t values = static_cast<size_t>(channels_) * level.capacity;
+        if (level.lo.size() != values)
+        {
+            level.lo = AlignedBuffer<float>(values);
+            level.hi = AlignedBuffer<float>(values);
+        }
+        level_count_ = l;
+    }
+
+    reset();
+}
+
+void MinMaxPyramid::reset()
+{
+    for (Level& level : levels_)
+    {
+        level.begin.store(0, std::memory_order_relaxed);
+        level.published.store(0, std::memory_order_release);
+    }
+}
+
+size_t MinMaxPyramid::memory_bytes() const
+{
+    size_t bytes = 0;
+    for (const Level& level : levels_)
+    {
+        bytes += level.lo.bytes() + level.hi.bytes();
+    }
+    return bytes;
+}
+
+// ===== PRODUCER =====
+
+void MinMaxPyramid::update(const SampleRing& ring)
+{
+    if (level_count_ == 0)
+    {
+        return;
+    }
+
+    const uint64_t head = ring.published();
+    if (head < levels_[0].published.load(std::memory_order_relaxed) * k_fan_out)
+    {
+        reset();  // ring was rewound
+    }
+
+    build_level_one(ring, head);
+    for (int l = 2; l <= level_count_; ++l)
+    {
+        build_level(l);
+    }
+}
+
+void MinMaxPyramid::build_level_one(const SampleRing& ring, uint64_t head)
+{
+    Level& level = levels_[0];
+    const uint64_t end = head / k_fan_out;
+    uint64_t first = level.published.load(std::memory_order_relaxed);
+
+    // Lapped (or first block larger than the ring): restart at the oldest whole bin still in the ring
+    const uint64_t oldest = (oldest_retained(head, static_cast<uint64_t>(ring.capacity())) + k_fan_out - 1) / k_fan_out;
+    if (first < oldest)
+    {
+        first = oldest;
+        level.begin.store(first, std::memory_order_relaxed);
+    }
+    if (end <= first)
+    {
+        return;
+    }
+
+    const auto capacity = static_cast<uint64_t>(level.capacity);
+    for (int c = 0; c < channels_; ++c)
+    {
+        float* lo_row = level.lo.data() + static_cast<size_t>(c) * level.capacity;
+        float* hi_row = level.hi.data() + static_cast<size_t>(c) * level.capacity;
+        for (uint64_t bin = first; bin < end; ++bin)
+        {
+            float lo = k_empty_lo;
+            float hi = k_empty_hi;
+            fold_samples(ring, c, bin * k_fan_out, (bin + 1) * k_fan_out, lo, hi);
+            const auto slot = static_cast<size_t>(bin % capacity);
+            lo_row[slot] = lo;
+            hi_row[slot] = hi;
+        }
+    }
+
+    level.published.store(end, std::memory_order_release);
+}
+
+void MinMaxPyramid::build_level(int l)
+{
+    const Level& child = levels_[l - 2];
+    Level& level = levels_[l - 1];
+
+    const uint64_t child_published = child.published.load(std::memory_order_relaxed);
+    const auto child_capacity = static_cast<uint64_t>(child.capacity);
+    const uint64_t child_oldest = std::max(child.begin.load(std::memory_order_relaxed),
+                                           oldest_retained(child_published, child_capacity));
+
+    const uint64_t end = child_published / k_fan_out;
+    uint64_t first = level.published.load(std::memory_order_relaxed);
+    const uint64_t oldest = (child_oldest + k_fan_out - 1) / k_fan_out;
+    if (first < oldest)
+    {
+        first = oldest;
+        level.begin.store(first, std::memory_order_relaxed);
+    }
+    if (end <= first)
+    {
+        return;
+    }
+
+    const auto capacity = static_cast<uint64_t>(level.capacity);
+    for (int c = 0; c < channels_; ++c)
+    {
+        const float* child_lo = child.lo.data() + static_cast<size_t>(c) * child.capacity;
+        const float* child_hi = child.hi.data() + static_cast<size_t>(c) * child.capacity;
+        float* lo_row = level.lo.data() + static_cast<size_t>(c) * level.capacity;
+        float* hi_row = level.hi.data() + static_cast<size_t>(c) * level.capacity;
+        for (uint64_t bin = first; bin < end; ++bin)
+        {
+            float lo = k_empty_lo;
+            float hi = k_empty_hi;
+            for (uint64_t k = bin * k_fan_out; k < (bin + 1) * k_fan_out; ++k)
+            {
+                const auto child_slot = static_cast<size_t>(k % child_capacity);
+                lo = std::min(lo, child_lo[child_slot]);
+                hi = std::max(hi, child_hi[child_slot]);
+            }
+            const auto slot = static_cast<size_t>(bin % capacity);
+            lo_row[slot] = lo;
+            hi_row[slot] = hi;
+        }
+    }
+
+    level.published.store(end, std::memory_order_release);
+}
+
+// ===== CONSUMER =====
+
+MinMaxPyramid::Snapshot MinMaxPyramid::snapshot() const
+{
+    Snapshot snapshot;
+    snapshot.levels = level_count_;
+    for (int l = 0; l < level_count_; ++l)
+    {
+        const Level& level = levels_[l];
+        snapshot.published[l] = level.published.load(std::memory_order_acquire);
+        snapshot.oldest[l] = std::max(level.begin.load(std::memory_order_relaxed),
+                                      oldest_retained(snapshot.published[l], static_cast<uint64_t>(level.capacity)));
+    }
+    return snapshot;
+}
+
+void MinMaxPyramid::query(const Snapshot& snapshot,
+                          const SampleRing& ring,
+                          int channel,
+                          uint64_t first,
+                          uint64_t last,
+                          float& lo,
+                          float& hi) const
+{
+    const int top = std::min(snapshot.levels, level_count_);
+    auto built = [&snapshot](int l, uint64_t bin)
+    {
+        return bin >= snapshot.oldest[l - 1] && bin < snapshot.published[l - 1];
+    };
+
+    // Climb while the position is aligned to the next coarser bin and it fits; descend near the end
+    int l = 0;
+    uint64_t index = first;
+    while (index < last)
+    {
+        while (l < top && (index & (bin_samples(l + 1) - 1)) == 0 && last - index >= bin_samples(l + 1) &&
+               built(l + 1, index >> (3 * (l + 1))))
+        {
+            ++l;
+        }
+        while (l > 0 && (last - index < bin_samples(l) || !built(l, index >> (3 * l))))
+        {
+            --l;
+        }
+
+        if (l == 0)
+        {
+            // Raw samples up to the next level-1 boundary (unaligned edge or not built yet)
+            const uint64_t stop = std::min(last, (index | (k_fan_out - 1)) + 1);
+            fold_samples(ring, channel, index, stop, lo, hi);
+            index = stop;
+            continue;
+        }
+
+        const Level& level = levels_[l - 1];
+        const uint64_t bin = index >> (3 * l);
+        const size_t at = static_cast<size_t>(channel) * level.capacity +
+                          static_cast<size_t>(bin % static_cast<uint64_t>(level.capacity));
+        lo = std::min(lo, level.lo[at]);
+        hi = std::max(hi, level.hi[at]);
+        index += bin_samples(l);
+    }
+}
+
+}  // namespace elda
@@ -0,0 +1,149 @@
+#pragma once
+
+#include "core/aligned_buffer.h"
+#include "core/sample_ring.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace elda
+{
+
+/**
+ * MinMaxPyramid - per-channel multi-resolution min/max summaries of a SampleRing
+ *
+ * Level l (1..levels()) holds one (min, max) bin per k_fan_out^l samples. Bins
+ * are aligned to absolute sample indices: bin k of level l covers
+ * [k * w, (k + 1) * w) with w = bin_samples(l). Each level is a ring of its own,
+ * sized to cover the SampleRing's retention, so the pyramid adds about 2/7 of
+ * the sample slab.
+ *
+ * update() folds only what was published since the previous call: complete
+ * level-1 bins from ring samples, then complete level-(l+1) bins from level l.
+ * query() answers the min/max of any sample range from the coarsest bins that
+ * fit, so a display column costs O(k_fan_out * levels()) whatever its span.
+ *
+ * Threading contract (same as SampleRing):
+ *  - The ring's producer thread is the only caller of update().
+ *  - Any number of consumers call query() concurrently; they never write.
+ *  - Each level release-stores its count of complete bins after writing them, so a
+ *    bin below the count is completely written when a consumer can see it.
+ *  - Bins that are not built yet (the newest < w samples) are answered from finer
+ *    levels or raw samples, so query() is exact for any published, retained range.
+ */
+class MinMaxPyramid
+{
+  public:
+    static constexpr int k_fan_out = 8;
+    static constexpr int k_max_levels = 8;
+
+    MinMaxPyramid() = default;
+
+    /**
+     * @param ring Ring to summarize (shape only; no samples are read)
+     */
+    explicit MinMaxPyramid(const SampleRing& ring);
+
+    MinMaxPyramid(const MinMaxPyramid&) = delete;
+    MinMaxPyramid& operator=(const MinMaxPyramid&) = delete;
+
+    /**
+     * Re-shape for the ring's channel count and retention, then clear like reset()
+     * NOT thread-safe: call alongside SampleRing::configure() while the producer is stopped
+     */
+    void configure(const SampleRing& ring);
+
+    /**
+     * Drop all bins
+     * NOT thread-safe: call only while the producer is stopped
+     */
+    void reset();
+
+    // === PRODUCER ===
+
+    /**
+     * Fold samples the ring published since the previous call into every level
+     * If the ring lapped the pyramid, building restarts at the oldest retained sample.
+     */
+    void update(const SampleRing& ring);
+
+    // === CONSUMER ===
+
+    /**
+     * Usable bin range [oldest, published) of every level at one instant
+     * Take one per frame (like a published() snapshot) and reuse it for all queries.
+     */
+    struct Snapshot
+    {
+        int levels = 0;
+        uint64_t published[k_max_levels] = {};
+        uint64_t oldest[k_max_levels] = {};
+    };
+
+    Snapshot snapshot() const;
+
+    /**
+     * Min and max of one channel over samples [first, last)
+     * @param snapshot Bins visible to this reader (see snapshot())
+     * @param ring The ring this pyramid summarizes; [first, last) must be published and retained
+     * @param lo In/out: lowered to the range minimum
+     * @param hi In/out: raised to the range maximum
+     */
+    void query(const Snapshot& snapshot,
+               const SampleRing& ring,
+               int channel,
+               uint64_t first,
+               uint64_t last,
+               float& lo,
+               float& hi) const;
+
+    // Number of built levels (0 if the ring is too short to summarize)
+    int levels() const
+    {
+        return level_count_;
+    }
+
+    /**
+     * Coarsest level whose bins are at most 1/4 of a span (0 = raw samples)
+     * Display columns snapped to these bins move by under a quarter column.
+     */
+    int level_for_span(double samples) const
+    {
+        int level = 0;
+        while (level < level_count_ && static_cast<double>(bin_samples(level + 1)) * 4.0 <= samples)
+        {
+            ++level;
+        }
+        return level;
+    }
+
+    // Samples summarized by one bin of a level (level 0 = one raw sample)
+    static uint64_t bin_samples(int level)
+    {
+        return uint64_t{1} << (3 * level);
+    }
+
+    size_t memory_bytes() const;
+
+  private:
+    static_assert(k_fan_out == 8, "bin_samples() assumes 8 samples per bin per level");
+
+    struct Level
+    {
+        int capacity = 0;                    // Bins retained per channel
+        AlignedBuffer<float> lo;             // [channel][slot]
+        AlignedBuffer<float> hi;             // [channel][slot]
+        std::atomic<uint64_t> begin{0};      // First bin built since the last restart
+        std::atomic<uint64_t> published{0};  // Bins complete (absolute count)
+    };
+
+    void build_level_one(const SampleRing& ring, uint64_t head);
+    void build_level(int level);
+
+    int channels_ = 0;
+    int level_count_ = 0;
+    Level levels_[k_max_levels];  // levels_[l - 1] holds level l
+};
+
+}  // namespace elda
@@ -23,4 +23,10 @@ class IScreen
 
     // Called every frame to render the screen
     virtual void render() = 0;
+
+    // True while the screen changes without input (the main loop then keeps drawing at the frame cap)
+    virtual bool wants_continuous_redraw() const
+    {
+        return false;
+    }
 };
@@ -0,0 +1,231 @@
+#include "sample_ring.h"
+
+#include "core/simd.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace elda
+{
+
+namespace
+{
+int round_tile(int tile_samples)
+{
+    int tile = 1;
+    while (tile < tile_samples)
+    {
+        tile <<= 1;
+    }
+    return tile;
+}
+
+// Interleaved frames -> channel rows (dst + c * dst_stride). 4x4 tiles go through SIMD registers, edges are scalar.
+void transpose_interleaved(const float* src, int channels, int frames, float* dst, size_t dst_stride)
+{
+    using namespace elda::simd;
+
+    const int channels4 = channels & ~3;
+    const int frames4 = frames & ~3;
+    for (int f = 0; f < frames4; f += 4)
+    {
+        const float* rows = src + static_cast<size_t>(f) * channels;
+        for (int c = 0; c < channels4; c += 4)
+        {
+            f32x4 r0 = load(rows + c);
+            f32x4 r1 = load(rows + channels + c);
+            f32x4 r2 = load(rows + 2 * channels + c);
+            f32x4 r3 = load(rows + 3 * channels + c);
+            transpose4(r0, r1, r2, r3);
+            float* out = dst + static_cast<size_t>(c) * dst_stride + f;
+            store(out, r0);
+            store(out + dst_stride, r1);
+            store(out + 2 * dst_stride, r2);
+            store(out + 3 * dst_stride, r3);
+        }
+        for (int c = channels4; c < channels; ++c)
+        {
+            float* out = dst + static_cast<size_t>(c) * dst_stride + f;
+            for (int k = 0; k < 4; ++k)
+            {
+                out[k] = rows[k * channels + c];
+            }
+        }
+    }
+    for (int f = frames4; f < frames; ++f)
+    {
+        const float* row = src + static_cast<size_t>(f) * channels;
+        for (int c = 0; c < channels; ++c)
+        {
+            dst[static_cast<size_t>(c) * dst_stride + f] = row[c];
+        }
+    }
+}
+
+int rounded_capacity(int capacity, SampleLayout layout, int tile)
+{
+    capacity = std::max(1, capacity);
+    if (layout == SampleLayout::Blocked)
+    {
+        capacity = ((capacity + tile - 1) / tile) * tile;
+    }
+    return capacity;
+}
+}  // namespace
+
+SampleRing::SampleRing(int channels, int capacity, double sample_rate_hz, SampleLayout layout, int tile_samples)
+{
+    configure(channels, capacity, sample_rate_hz, layout, tile_samples);
+}
+
+void SampleRing::configure(int channels, int capacity, double sample_rate_hz, SampleLayout layout, int tile_samples)
+{
+    channels_ = std::max(1, channels);
+    sample_rate_hz_ = sample_rate_hz;
+    layout_ = layout;
+
+    tile_samples_ = 0;
+    tile_shift_ = 0;
+    tile_mask_ = 0;
+    tile_stride_ = 0;
+    if (layout_ == SampleLayout::Blocked)
+    {
+        tile_samples_ = round_tile(std::max(1, tile_samples));
+        tile_mask_ = tile_samples_ - 1;
+        while ((1 << tile_shift_) < tile_samples_)
+        {
+            ++tile_shift_;
+        }
+    }
+
+    capacity_ = rounded_capacity(capacity, layout_, tile_samples_);
+
+    if (layout_ == SampleLayout::Planar)
+    {
+        channel_stride_ = static_cast<size_t>(capacity_);
+    }
+    else
+    {
+        channel_stride_ = static_cast<size_t>(tile_samples_);
+        tile_stride_ = static_cast<size_t>(channels_) * tile_samples_;
+    }
+
+    const size_t values = static_cast<size_t>(channels_) * capacity_;
+    if (slab_.size() == values)
+    {
+        reset();
+        return;
+    }
+
+    slab_ = AlignedBuffer<float>(values);
+    reserve_index_.store(0, std::memory_order_relaxed);
+    write_index_.store(0, std::memory_order_release);
+}
+
+size_t SampleRing::bytes_required(int channels, int capacity, SampleLayout layout, int tile_samples)
+{
+    const int tile = (layout == SampleLayout::Blocked) ? round_tile(std::max(1, tile_samples)) : 0;
+    const auto slots = static_cast<size_t>(rounded_capacity(capacity, layout, tile));
+    return static_cast<size_t>(std::max(1, channels)) * slots * sizeof(float);
+}
+
+void SampleRing::reset()
+{
+    slab_.fill(0.0f);
+    reserve_index_.store(0, std::memory_order_relaxed);
+    write_index_.store(0, std::memory_order_release);
+}
+
+void SampleRing::push_block(const float* src, int frames, FrameFormat format, int src_stride)
+{
+    if (src_stride <= 0)
+    {
+        src_stride = frames;
+    }
+
+    push_with(frames,
+              [&](int src_offset, int count, float* dst, size_t channel_stride)
+              {
+                  if (format == FrameFormat::Planar)
+                  {
+                      for (int c = 0; c < channels_; ++c)
+                      {
+                          std::memcpy(dst + static_cast<size_t>(c) * channel_stride,
+                                      src + static_cast<size_t>(c) * src_stride + src_offset,
+                                      sizeof(float) * count);
+                      }
+                  }
+                  else
+                  {
+                      transpose_interleaved(
+                          src + static_cast<size_t>(src_offset) * channels_, channels_, count, dst, channel_stride);
+                  }
+              });
+}
+
+int SampleRing::read(ReadCursor& cursor, float* dst, int dst_stride, int max_frames) const
+{
+    const auto capacity = static_cast<uint64_t>(capacity_);
+    const uint64_t head = write_index_.load(std::memory_order_acquire);
+
+    // Fell behind the overwrite horizon: skip to the oldest retained sample
+    if (head > capacity && cursor.next < head - capacity)
+    {
+        cursor.overruns += (head - capacity) - cursor.next;
+        cursor.next = head - capacity;
+    }
+
+    const int frames = static_cast<int>(std::min<uint64_t>(head - cursor.next, static_cast<uint64_t>(max_frames)));
+    if (frames <= 0)
+    {
+        return 0;
+    }
+
+    // Stream each channel run by run: two runs when Planar (wrap at the ring end), one per tile when Blocked
+    const int first_slot = slot_of(cursor.next);
+    for (int c = 0; c < channels_; ++c)
+    {
+        float* out = dst + static_cast<size_t>(c) * dst_stride;
+        int slot = first_slot;
+        int copied = 0;
+        while (copied < frames)
+        {
+            int length = 0;
+            const float* src = run(c, slot, length);
+            length = std::min(length, frames - copied);
+            std::memcpy(out + copied, src, sizeof(float) * length);
+            copied += length;
+            slot += length;
+            if (slot >= capacity_)
+            {
+                slot = 0;
+            }
+        }
+    }
+
+    // Validate after copying: the producer may have lapped the oldest samples we just read.
+    // A push reserves its whole block before writing, so every slot it may be overwriting right now (up to a
+    // capacity's worth for one block) belongs to an index below reserve_after - capacity. If the copy saw any
+    // byte of such a block, the fence pair makes its reservation visible here.
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const uint64_t reserve_after = reserve_index_.load(std::memory_order_relaxed);
+    const uint64_t horizon = (reserve_after > capacity) ? reserve_after - capacity : 0;
+
+    int torn = 0;
+    if (cursor.next < horizon)
+    {
+        torn = static_cast<int>(std::min<uint64_t>(horizon - cursor.next, static_cast<uint64_t>(frames)));
+        const int kept = frames - torn;
+        for (int c = 0; c < channels_ && kept > 0; ++c)
+        {
+            float* out = dst + static_cast<size_t>(c) * dst_stride;
+            std::memmove(out, out + torn, sizeof(float) * kept);
+        }
+        cursor.overruns += static_cast<uint64_t>(torn);
+    }
+
+    cursor.next += static_cast<uint64_t>(frames);
+    return frames - torn;
+}
+
+}  // namespace elda
@@ -0,0 +1,354 @@
+#pragma once
+
+#include "core/aligned_buffer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace elda
+{
+
+/**
+ * Memory layout of the ring slab
+ *  Planar  - [ch][slot]: each channel is one contiguous run (best for per-channel readers)
+ *  Blocked - [tile][ch][tile_samples]: tile_samples consecutive samples of a channel are
+ *            contiguous and all channels of a tile sit together (best for block ingest)
+ */
+enum class SampleLayout
+{
+    Planar = 0,
+    Blocked
+};
+
+/**
+ * Source layout for SampleRing::push_block()
+ *  Interleaved - src[frame * channels + ch] (amplifier packet order)
+ *  Planar      - src[ch * src_stride + frame]
+ */
+enum class FrameFormat
+{
+    Interleaved = 0,
+    Planar
+};
+
+/**
+ * IRingStage - in-place processing of freshly written frames before they are published (filters)
+ */
+class IRingStage
+{
+  public:
+    virtual ~IRingStage() = default;
+
+    /**
+     * Process count frames in place: channel c of frame k is data[c * channel_stride + k]
+     * Called on the producer thread once per contiguous slab run, in time order.
+     * @param first Sample index of frame 0 (runs a long block skipped leave a gap before it)
+     */
+    virtual void process(uint64_t first, float* data, size_t channel_stride, int count) = 0;
+};
+
+/**
+ * SampleRing - lock-free single-producer ring of multi-channel samples
+ *
+ * Storage is a single 64-byte aligned slab. Capacity is rounded up to a whole
+ * number of tiles in Blocked layout so every tile starts on a cache line.
+ *
+ * Time base: samples are identified by a monotonically increasing 64-bit index
+ * (published() is the index of the next sample). Timestamps are derived on
+ * demand as index / sample_rate_hz(), so positioning stays exact for multi-day
+ * sessions and no per-sample time array is stored.
+ *
+ * Threading contract:
+ *  - Exactly one producer thread (the acquisition thread) calls push() / push_block().
+ *  - Any number of consumers (chart, recorder, DSP) read concurrently. Each consumer
+ *    owns its ReadCursor; consumers never write shared state.
+ *  - The producer first reserves the block (stores the index it will publish up to),
+ *    fills the slots, then publishes the new total sample count with a release
+ *    store. Consumers load it with acquire, so every sample below published() is
+ *    completely written when it becomes visible.
+ *  - Neither side locks, waits or retries: push(), push_block() and read() are wait-free.
+ *
+ * Overrun policy (slow readers):
+ *  - The producer never waits; it always overwrites the oldest slot.
+ *  - A reader that fell more than capacity() samples behind skips forward to the
+ *    oldest retained sample; the skipped count is added to ReadCursor::overruns.
+ *  - Samples the producer may have overwritten while read() was copying them (any
+ *    index below reserved() - capacity() once the copy is done) are dropped from
+ *    the front of the result and also counted as overruns, so a reader never
+ *    returns a torn sample.
+ *  - Random-access readers (the chart) must stay inside the retained window less
+ *    one block: a push overwrites up to its block length (capacity() at most) of
+ *    the oldest slots before published() moves. The acquisition thread pushes at
+ *    most max(1024, 16 ticks) frames per block and the longest display window is
+ *    BUFFER_SECONDS minus several seconds, which leaves the slack.
+ */
+class SampleRing
+{
+  public:
+    static_assert(std::atomic<uint64_t>::is_always_lock_free, "SampleRing requires lock-free 64-bit atomics");
+
+    /**
+     * Per-consumer read position
+     */
+    struct ReadCursor
+    {
+        uint64_t next = 0;      // Absolute index of the next sample to read
+        uint64_t overruns = 0;  // Samples lost because this reader fell behind
+    };
+
+    /**
+     * @param channels Number of channels
+     * @param capacity Samples retained per channel (rounded up to whole tiles when Blocked)
+     * @param sample_rate_hz Device rate; timestamps are index / rate
+     * @param layout Slab layout
+     * @param tile_samples Samples per channel tile for Blocked layout (power of two, e.g. 8 or 16)
+     */
+    SampleRing(int channels,
+               int capacity,
+               double sample_rate_hz,
+               SampleLayout layout = SampleLayout::Planar,
+               int tile_samples = 16);
+
+    /**
+     * Re-shape the ring for a new session format (channel count, rate, capacity)
+     * Reallocates only when the slab size changes, then clears like reset().
+     * NOT thread-safe: call only while the producer is stopped and no reader holds a snapshot
+     */
+    void configure(int channels,
+                   int capacity,
+                   double sample_rate_hz,
+                   SampleLayout layout = SampleLayout::Planar,
+                   int tile_samples = 16);
+
+    /**
+     * Clear all samples and rewind the write index
+     * NOT thread-safe: call only while the producer is stopped
+     */
+    void reset();
+
+    /**
+     * Bytes needed for a ring with the given shape (for capacity planning)
+     */
+    static size_t bytes_required(int channels, int capacity, SampleLayout layout, int tile_samples = 16);
+
+    /**
+     * Bytes currently held by this ring
+     */
+    size_t memory_bytes() const
+    {
+        return slab_.bytes();
+    }
+
+    // === PRODUCER ===
+
+    /**
+     * Run a stage over every pushed run before it is published (nullptr = none)
+     * NOT thread-safe: call only while the producer is stopped
+     */
+    void set_stage(IRingStage* stage)
+    {
+        stage_ = stage;
+    }
+
+    /**
+     * Append one sample (one value per channel) and publish it
+     */
+    inline void push(const std::vector<float>& sample)
+    {
+        const uint64_t index = write_index_.load(std::memory_order_relaxed);
+        reserve(index + 1);
+        const int slot = slot_of(index);
+        float* base = slab_.data() + offset_of(0, slot);
+        for (int c = 0; c < channels_; ++c)
+        {
+            base[static_cast<size_t>(c) * channel_stride_] = sample[c];
+        }
+        if (stage_)
+        {
+            stage_->process(index, base, channel_stride_, 1);
+        }
+        write_index_.store(index + 1, std::memory_order_release);
+    }
+
+    /**
+     * Append a block of frames and publish them with a single release store
+     * Wraps at the ring end in at most two segments and never allocates;
+     * interleaved input is transposed into the slab with 4x4 SIMD tiles.
+     * A block longer than capacity() keeps only its newest capacity() frames.
+     * @param src Sample block in the given format
+     * @param frames Samples per channel in the block
+     * @param format Interleaved or Planar source
+     * @param src_stride Planar only: distance between channels in src (0 = frames)
+     */
+    void push_block(const float* src, int frames, FrameFormat format, int src_stride = 0);
+
+    /**
+     * Append frames written in place by a producer stage (decoder, DSP), then publish them
+     * with a single release store. Saves the staging copy push_block() would need.
+     * writer(src_offset, count, dst, channel_stride) fills frames [src_offset, src_offset + count)
+     * of the block: channel c of frame src_offset + k goes to dst[c * channel_stride + k].
+     * It is called once per contiguous slab run (ring end; tile edges when Blocked); the
+     * stage (set_stage()) then runs over the same run.
+     * A block longer than capacity() only writes its newest capacity() frames.
+     */
+    template <typename Writer>
+    void push_with(int frames, Writer&& writer)
+    {
+        if (frames <= 0)
+        {
+            return;
+        }
+
+        const uint64_t first = write_index_.load(std::memory_order_relaxed);
+        const uint64_t end = first + static_cast<uint64_t>(frames);
+
+        reserve(end);
+
+        const int skip = frames > capacity_ ? frames - capacity_ : 0;
+        uint64_t index = first + static_cast<uint64_t>(skip);
+        int src_offset = skip;
+        while (index < end)
+        {
+            const int slot = slot_of(index);
+            int length = 0;
+            run(0, slot, length);
+            const int count = static_cast<int>(std::min<uint64_t>(end - index, static_cast<uint64_t>(length)));
+            float* dst = slab_.data() + offset_of(0, slot);
+            writer(src_offset, count, dst, channel_stride_);
+            if (stage_)
+            {
+                stage_->process(index, dst, channel_stride_, count);
+            }
+            index += static_cast<uint64_t>(count);
+            src_offset += count;
+        }
+
+        write_index_.store(end, std::memory_order_release);
+    }
+
+    // === CONSUMER ===
+
+    /**
+     * Total number of samples published so far (acquire)
+     */
+    uint64_t published() const
+    {
+        return write_index_.load(std::memory_order_acquire);
+    }
+
+    /**
+     * End of the block being written (== published() between pushes)
+     * Slots of indices below reserved() - capacity() may already hold newer samples.
+     */
+    uint64_t reserved() const
+    {
+        return reserve_index_.load(std::memory_order_acquire);
+    }
+
+    /**
+     * Copy samples after cursor.next into dst and advance the cursor
+     * @param cursor Reader position, updated in place
+     * @param dst Planar output: channel c starts at dst + c * dst_stride
+     * @param dst_stride Distance between channels in dst (>= max_frames)
+     * @param max_frames Maximum samples per channel to copy
+     * @return Number of valid samples written per channel
+     */
+    int read(ReadCursor& cursor, float* dst, int dst_stride, int max_frames) const;
+
+    // === RANDOM ACCESS (for readers holding a published() snapshot) ===
+
+    int slot_of(uint64_t index) const
+    {
+        return static_cast<int>(index % static_cast<uint64_t>(capacity_));
+    }
+
+    float sample(int channel, int slot) const
+    {
+        return slab_[offset_of(channel, slot)];
+    }
+
+    /**
+     * Contiguous samples of one channel starting at slot
+     * @param length Out: samples readable from the returned pointer before the
+     *               next tile or the ring end
+     */
+    const float* run(int channel, int slot, int& length) const
+    {
+        length = (layout_ == SampleLayout::Planar) ? capacity_ - slot : tile_samples_ - (slot & tile_mask_);
+        return slab_.data() + offset_of(channel, slot);
+    }
+
+    /**
+     * Absolute time (seconds since reset) of the sample with the given index
+     */
+    double time_at(uint64_t index) const
+    {
+        return static_cast<double>(index) / sample_rate_hz_;
+    }
+
+    int channels() const
+    {
+        return channels_;
+    }
+
+    int capacity() const
+    {
+        return capacity_;
+    }
+
+    double sample_rate_hz() const
+    {
+        return sample_rate_hz_;
+    }
+
+    SampleLayout layout() const
+    {
+        return layout_;
+    }
+
+    int tile_samples() const
+    {
+        return tile_samples_;
+    }
+
+  private:
+    // Announce the block end before its first slot is written; the fence orders the store before the slot writes
+    void reserve(uint64_t end)
+    {
+        reserve_index_.store(end, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+    }
+
+    size_t offset_of(int channel, int slot) const
+    {
+        if (layout_ == SampleLayout::Planar)
+        {
+            return static_cast<size_t>(channel) * channel_stride_ + slot;
+        }
+        return static_cast<size_t>(slot >> tile_shift_) * tile_stride_ + static_cast<size_t>(channel) * channel_stride_ +
+               (slot & tile_mask_);
+    }
+
+    int channels_ = 0;
+    int capacity_ = 0;
+    double sample_rate_hz_ = 0.0;
+    SampleLayout layout_ = SampleLayout::Planar;
+
+    int tile_samples_ = 0;       // Blocked: samples per channel tile
+    int tile_shift_ = 0;         // log2(tile_samples_)
+    int tile_mask_ = 0;          // tile_samples_ - 1
+    size_t channel_stride_ = 0;  // Planar: capacity_; Blocked: tile_samples_
+    size_t tile_stride_ = 0;     // Blocked: channels_ * tile_samples_
+
+    AlignedBuffer<float> slab_;     // all channels, one allocation
+    IRingStage* stage_ = nullptr;  // producer-side, not owned
+
+    // Own cache line: the producer's hot store must not false-share with the read-only fields above
+    alignas(64) std::atomic<uint64_t> write_index_{0};
+    std::atomic<uint64_t> reserve_index_{0};  // producer-only writes, same line as write_index_
+};
+
+}  // namespace elda
@@ -0,0 +1,519 @@
+#pragma once
+
+// Thin 4-lane float / uint32 (and 2-lane double) wrapper over SSE2 / NEON with a scalar fallback.
+// Kernels are written once against f32x4 / u32x4 / f64x2 and compile to the native ISA.
+
+#include <cstdint>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define ELDA_SIMD_SSE2 1
+    #include <emmintrin.h>
+    #if defined(__SSSE3__) || defined(__AVX__)
+        #define ELDA_SIMD_SSSE3 1
+        #include <tmmintrin.h>
+    #endif
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #define ELDA_SIMD_NEON 1
+    #include <arm_neon.h>
+#endif
+
+namespace elda::simd
+{
+
+// Signed 24-bit little-endian sample -> int32 (top-align, then arithmetic shift to sign-extend)
+inline int32_t s24_to_i32(const uint8_t* p)
+{
+    const uint32_t u = (static_cast<uint32_t>(p[0]) << 8) | (static_cast<uint32_t>(p[1]) << 16) |
+                       (static_cast<uint32_t>(p[2]) << 24);
+    return static_cast<int32_t>(u) >> 8;
+}
+
+// ============================================================================
+// f32x4
+// ============================================================================
+
+#if defined(ELDA_SIMD_SSE2)
+
+struct f32x4
+{
+    __m128 v;
+};
+
+inline f32x4 load(const float* p)
+{
+    return {_mm_loadu_ps(p)};
+}
+inline void store(float* p, f32x4 a)
+{
+    _mm_storeu_ps(p, a.v);
+}
+inline f32x4 set1(float x)
+{
+    return {_mm_set1_ps(x)};
+}
+inline f32x4 add(f32x4 a, f32x4 b)
+{
+    return {_mm_add_ps(a.v, b.v)};
+}
+inline f32x4 sub(f32x4 a, f32x4 b)
+{
+    return {_mm_sub_ps(a.v, b.v)};
+}
+inline f32x4 mul(f32x4 a, f32x4 b)
+{
+    return {_mm_mul_ps(a.v, b.v)};
+}
+inline f32x4 min(f32x4 a, f32x4 b)
+{
+    return {_mm_min_ps(a.v, b.v)};
+}
+inline f32x4 max(f32x4 a, f32x4 b)
+{
+    return {_mm_max_ps(a.v, b.v)};
+}
+inline void transpose4(f32x4& r0, f32x4& r1, f32x4& r2, f32x4& r3)
+{
+    _MM_TRANSPOSE4_PS(r0.v, r1.v, r2.v, r3.v);
+}
+
+struct u32x4
+{
+    __m128i v;
+};
+
+inline u32x4 load_u32(const uint32_t* p)
+{
+    return {_mm_loadu_si128(reinterpret_cast<const __m128i*>(p))};
+}
+inline void store_u32(uint32_t* p, u32x4 a)
+{
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(p), a.v);
+}
+inline u32x4 bit_xor(u32x4 a, u32x4 b)
+{
+    return {_mm_xor_si128(a.v, b.v)};
+}
+template <int N>
+inline u32x4 shl(u32x4 a)
+{
+    return {_mm_slli_epi32(a.v, N)};
+}
+template <int N>
+inline u32x4 shr(u32x4 a)
+{
+    return {_mm_srli_epi32(a.v, N)};
+}
+// Top 24 bits as a float in [0, 1)
+inline f32x4 to_unit_float(u32x4 a)
+{
+    return {_mm_mul_ps(_mm_cvtepi32_ps(_mm_srli_epi32(a.v, 8)), _mm_set1_ps(1.0f / 16777216.0f))};
+}
+// Four packed signed 24-bit LE samples (12 bytes) as floats.
+// The SSSE3 path loads 16 bytes: p must stay readable 4 bytes past the last sample.
+inline f32x4 load_s24(const uint8_t* p)
+{
+    #if defined(ELDA_SIMD_SSSE3)
+    const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    const __m128i top_align = _mm_setr_epi8(-1, 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11);
+    return {_mm_cvtepi32_ps(_mm_srai_epi32(_mm_shuffle_epi8(bytes, top_align), 8))};
+    #else
+    return {_mm_cvtepi32_ps(_mm_setr_epi32(s24_to_i32(p), s24_to_i32(p + 3), s24_to_i32(p + 6), s24_to_i32(p + 9)))};
+    #endif
+}
+
+#elif defined(ELDA_SIMD_NEON)
+
+struct f32x4
+{
+    float32x4_t v;
+};
+
+inline f32x4 load(const float* p)
+{
+    return {vld1q_f32(p)};
+}
+inline void store(float* p, f32x4 a)
+{
+    vst1q_f32(p, a.v);
+}
+inline f32x4 set1(float x)
+{
+    return {vdupq_n_f32(x)};
+}
+inline f32x4 add(f32x4 a, f32x4 b)
+{
+    return {vaddq_f32(a.v, b.v)};
+}
+inline f32x4 sub(f32x4 a, f32x4 b)
+{
+    return {vsubq_f32(a.v, b.v)};
+}
+inline f32x4 mul(f32x4 a, f32x4 b)
+{
+    return {vmulq_f32(a.v, b.v)};
+}
+inline f32x4 min(f32x4 a, f32x4 b)
+{
+    return {vminq_f32(a.v, b.v)};
+}
+inline f32x4 max(f32x4 a, f32x4 b)
+{
+    return {vmaxq_f32(a.v, b.v)};
+}
+inline void transpose4(f32x4& r0, f32x4& r1, f32x4& r2, f32x4& r3)
+{
+    const float32x4x2_t t01 = vtrnq_f32(r0.v, r1.v);
+    const float32x4x2_t t23 = vtrnq_f32(r2.v, r3.v);
+    r0.v = vcombine_f32(vget_low_f32(t01.val[0]), vget_low_f32(t23.val[0]));
+    r1.v = vcombine_f32(vget_low_f32(t01.val[1]), vget_low_f32(t23.val[1]));
+    r2.v = vcombine_f32(vget_high_f32(t01.val[0]), vget_high_f32(t23.val[0]));
+    r3.v = vcombine_f32(vget_high_f32(t01.val[1]), vget_high_f32(t23.val[1]));
+}
+
+struct u32x4
+{
+    uint32x4_t v;
+};
+
+inline u32x4 load_u32(const uint32_t* p)
+{
+    return {vld1q_u32(p)};
+}
+inline void store_u32(uint32_t* p, u32x4 a)
+{
+    vst1q_u32(p, a.v);
+}
+inline u32x4 bit_xor(u32x4 a, u32x4 b)
+{
+    return {veorq_u32(a.v, b.v)};
+}
+template <int N>
+inline u32x4 shl(u32x4 a)
+{
+    return {vshlq_n_u32(a.v, N)};
+}
+template <int N>
+inline u32x4 shr(u32x4 a)
+{
+    return {vshrq_n_u32(a.v, N)};
+}
+// Top 24 bits as a float in [0, 1)
+inline f32x4 to_unit_float(u32x4 a)
+{
+    return {vmulq_n_f32(vcvtq_f32_u32(vshrq_n_u32(a.v, 8)), 1.0f / 16777216.0f)};
+}
+// Four packed signed 24-bit LE samples (12 bytes) as floats.
+// The AArch64 path loads 16 bytes: p must stay readable 4 bytes past the last sample.
+inline f32x4 load_s24(const uint8_t* p)
+{
+    #if defined(__aarch64__)
+    static const uint8_t k_top_align[16] = {255, 0, 1, 2, 255, 3, 4, 5, 255, 6, 7, 8, 255, 9, 10, 11};
+    const uint8x16_t bytes = vqtbl1q_u8(vld1q_u8(p), vld1q_u8(k_top_align));
+    return {vcvtq_f32_s32(vshrq_n_s32(vreinterpretq_s32_u8(bytes), 8))};
+    #else
+    const int32_t v[4] = {s24_to_i32(p), s24_to_i32(p + 3), s24_to_i32(p + 6), s24_to_i32(p + 9)};
+    return {vcvtq_f32_s32(vld1q_s32(v))};
+    #endif
+}
+
+#else
+
+struct f32x4
+{
+    float v[4];
+};
+
+inline f32x4 load(const float* p)
+{
+    return {{p[0], p[1], p[2], p[3]}};
+}
+inline void store(float* p, f32x4 a)
+{
+    for (int i = 0; i < 4; ++i)
+        p[i] = a.v[i];
+}
+inline f32x4 set1(float x)
+{
+    return {{x, x, x, x}};
+}
+inline f32x4 add(f32x4 a, f32x4 b)
+{
+    return {{a.v[0] + b.v[0], a.v[1] + b.v[1], a.v[2] + b.v[2], a.v[3] + b.v[3]}};
+}
+inline f32x4 sub(f32x4 a, f32x4 b)
+{
+    return {{a.v[0] - b.v[0], a.v[1] - b.v[1], a.v[2] - b.v[2], a.v[3] - b.v[3]}};
+}
+inline f32x4 mul(f32x4 a, f32x4 b)
+{
+    return {{a.v[0] * b.v[0], a.v[1] * b.v[1], a.v[2] * b.v[2], a.v[3] * b.v[3]}};
+}
+inline f32x4 min(f32x4 a, f32x4 b)
+{
+    f32x4 r;
+    for (int i = 0; i < 4; ++i)
+        r.v[i] = a.v[i] < b.v[i] ? a.v[i] : b.v[i];
+    return r;
+}
+inline f32x4 max(f32x4 a, f32x4 b)
+{
+    f32x4 r;
+    for (int i = 0; i < 4; ++i)
+        r.v[i] = a.v[i] > b.v[i] ? a.v[i] : b.v[i];
+    return r;
+}
+inline void transpose4(f32x4& r0, f32x4& r1, f32x4& r2, f32x4& r3)
+{
+    f32x4* rows[4] = {&r0, &r1, &r2, &r3};
+    for (int i = 0; i < 4; ++i)
+        for (int j = i + 1; j < 4; ++j)
+        {
+            const float t = rows[i]->v[j];
+            rows[i]->v[j] = rows[j]->v[i];
+            rows[j]->v[i] = t;
+        }
+}
+
+struct u32x4
+{
+    uint32_t v[4];
+};
+
+inline u32x4 load_u32(const uint32_t* p)
+{
+    return {{p[0], p[1], p[2], p[3]}};
+}
+inline void store_u32(uint32_t* p, u32x4 a)
+{
+    for (int i = 0; i < 4; ++i)
+        p[i] = a.v[i];
+}
+inline u32x4 bit_xor(u32x4 a, u32x4 b)
+{
+    return {{a.v[0] ^ b.v[0], a.v[1] ^ b.v[1], a.v[2] ^ b.v[2], a.v[3] ^ b.v[3]}};
+}
+template <int N>
+inline u32x4 shl(u32x4 a)
+{
+    return {{a.v[0] << N, a.v[1] << N, a.v[2] << N, a.v[3] << N}};
+}
+template <int N>
+inline u32x4 shr(u32x4 a)
+{
+    return {{a.v[0] >> N, a.v[1] >> N, a.v[2] >> N, a.v[3] >> N}};
+}
+// Top 24 bits as a float in [0, 1)
+inline f32x4 to_unit_float(u32x4 a)
+{
+    f32x4 r;
+    for (int i = 0; i < 4; ++i)
+        r.v[i] = static_cast<float>(a.v[i] >> 8) * (1.0f / 16777216.0f);
+    return r;
+}
+// Four packed signed 24-bit LE samples (12 bytes) as floats
+inline f32x4 load_s24(const uint8_t* p)
+{
+    return {{static_cast<float>(s24_to_i32(p)),
+             static_cast<float>(s24_to_i32(p + 3)),
+             static_cast<float>(s24_to_i32(p + 6)),
+             static_cast<float>(s24_to_i32(p + 9))}};
+}
+
+#endif
+
+// ============================================================================
+// f64x2 - for recursive state that float cannot hold (see dsp::IirFilterBank)
+// ============================================================================
+
+#if defined(ELDA_SIMD_SSE2)
+
+struct f64x2
+{
+    __m128d v;
+};
+
+inline f64x2 load_f64(const double* p)
+{
+    return {_mm_loadu_pd(p)};
+}
+inline void store_f64(double* p, f64x2 a)
+{
+    _mm_storeu_pd(p, a.v);
+}
+inline f64x2 set1_f64(double x)
+{
+    return {_mm_set1_pd(x)};
+}
+inline f64x2 add(f64x2 a, f64x2 b)
+{
+    return {_mm_add_pd(a.v, b.v)};
+}
+inline f64x2 sub(f64x2 a, f64x2 b)
+{
+    return {_mm_sub_pd(a.v, b.v)};
+}
+inline f64x2 mul(f64x2 a, f64x2 b)
+{
+    return {_mm_mul_pd(a.v, b.v)};
+}
+// Lanes 0-1 / 2-3 of a as doubles
+inline f64x2 widen_lo(f32x4 a)
+{
+    return {_mm_cvtps_pd(a.v)};
+}
+inline f64x2 widen_hi(f32x4 a)
+{
+    return {_mm_cvtps_pd(_mm_movehl_ps(a.v, a.v))};
+}
+// (lo[0], lo[1], hi[0], hi[1]) rounded to float
+inline f32x4 narrow(f64x2 lo, f64x2 hi)
+{
+    return {_mm_movelh_ps(_mm_cvtpd_ps(lo.v), _mm_cvtpd_ps(hi.v))};
+}
+
+#elif defined(ELDA_SIMD_NEON) && defined(__aarch64__)
+
+struct f64x2
+{
+    float64x2_t v;
+};
+
+inline f64x2 load_f64(const double* p)
+{
+    return {vld1q_f64(p)};
+}
+inline void store_f64(double* p, f64x2 a)
+{
+    vst1q_f64(p, a.v);
+}
+inline f64x2 set1_f64(double x)
+{
+    return {vdupq_n_f64(x)};
+}
+inline f64x2 add(f64x2 a, f64x2 b)
+{
+    return {vaddq_f64(a.v, b.v)};
+}
+inline f64x2 sub(f64x2 a, f64x2 b)
+{
+    return {vsubq_f64(a.v, b.v)};
+}
+inline f64x2 mul(f64x2 a, f64x2 b)
+{
+    return {vmulq_f64(a.v, b.v)};
+}
+// Lanes 0-1 / 2-3 of a as doubles
+inline f64x2 widen_lo(f32x4 a)
+{
+    return {vcvt_f64_f32(vget_low_f32(a.v))};
+}
+inline f64x2 widen_hi(f32x4 a)
+{
+    return {vcvt_high_f64_f32(a.v)};
+}
+// (lo[0], lo[1], hi[0], hi[1]) rounded to float
+inline f32x4 narrow(f64x2 lo, f64x2 hi)
+{
+    return {vcvt_high_f32_f64(vcvt_f32_f64(lo.v), hi.v)};
+}
+
+#else
+
+// Scalar doubles (also 32-bit NEON, which has no double lanes)
+struct f64x2
+{
+    double v[2];
+};
+
+inline f64x2 load_f64(const double* p)
+{
+    return {{p[0], p[1]}};
+}
+inline void store_f64(double* p, f64x2 a)
+{
+    p[0] = a.v[0];
+    p[1] = a.v[1];
+}
+inline f64x2 set1_f64(double x)
+{
+    return {{x, x}};
+}
+inline f64x2 add(f64x2 a, f64x2 b)
+{
+    return {{a.v[0] + b.v[0], a.v[1] + b.v[1]}};
+}
+inline f64x2 sub(f64x2 a, f64x2 b)
+{
+    return {{a.v[0] - b.v[0], a.v[1] - b.v[1]}};
+}
+inline f64x2 mul(f64x2 a, f64x2 b)
+{
+    return {{a.v[0] * b.v[0], a.v[1] * b.v[1]}};
+}
+// Lanes 0-1 / 2-3 of a as doubles
+inline f64x2 widen_lo(f32x4 a)
+{
+    float lanes[4];
+    store(lanes, a);
+    return {{lanes[0], lanes[1]}};
+}
+inline f64x2 widen_hi(f32x4 a)
+{
+    float lanes[4];
+    store(lanes, a);
+    return {{lanes[2], lanes[3]}};
+}
+// (lo[0], lo[1], hi[0], hi[1]) rounded to float
+inline f32x4 narrow(f64x2 lo, f64x2 hi)
+{
+    const float lanes[4] = {static_cast<float>(lo.v[0]),
+                            static_cast<float>(lo.v[1]),
+                            static_cast<float>(hi.v[0]),
+                            static_cast<float>(hi.v[1])};
+    return load(lanes);
+}
+
+#endif
+
+// a * b + c (not fused; keeps results identical across ISAs)
+inline f32x4 madd(f32x4 a, f32x4 b, f32x4 c)
+{
+    return add(mul(a, b), c);
+}
+inline f64x2 madd(f64x2 a, f64x2 b, f64x2 c)
+{
+    return add(mul(a, b), c);
+}
+
+// Fold src[0, count) into lo / hi (4 lanes at a time, scalar tail)
+inline void fold_minmax(const float* src, int count, float& lo, float& hi)
+{
+    int k = 0;
+    if (count >= 8)
+    {
+        f32x4 vlo = load(src);
+        f32x4 vhi = vlo;
+        for (k = 4; k + 4 <= count; k += 4)
+        {
+            const f32x4 v = load(src + k);
+            vlo = min(vlo, v);
+            vhi = max(vhi, v);
+        }
+        alignas(16) float lanes_lo[4];
+        alignas(16) float lanes_hi[4];
+        store(lanes_lo, vlo);
+        store(lanes_hi, vhi);
+        for (int i = 0; i < 4; ++i)
+        {
+            lo = lanes_lo[i] < lo ? lanes_lo[i] : lo;
+            hi = lanes_hi[i] > hi ? lanes_hi[i] : hi;
+        }
+    }
+    for (; k < count; ++k)
+    {
+        lo = src[k] < lo ? src[k] : lo;
+        hi = src[k] > hi ? src[k] : hi;
+    }
+}
+
+}  // namespace elda::simd
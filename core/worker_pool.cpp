@@ -0,0 +1,98 @@
+#include "worker_pool.h"
+
+namespace elda
+{
+
+namespace
+{
+// Beyond this, per-frame work is too small to split further
+constexpr int k_max_default_workers = 7;
+}  // namespace
+
+WorkerPool::WorkerPool(int workers)
+{
+    threads_.reserve(static_cast<size_t>(std::max(0, workers)));
+    for (int i = 0; i < workers; ++i)
+    {
+        threads_.emplace_back(&WorkerPool::worker_loop, this);
+    }
+}
+
+WorkerPool::~WorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_all();
+    for (std::thread& thread : threads_)
+    {
+        thread.join();
+    }
+}
+
+int WorkerPool::default_workers()
+{
+    const auto cores = static_cast<int>(std::thread::hardware_concurrency());
+    return std::clamp(cores - 2, 0, k_max_default_workers);
+}
+
+void WorkerPool::run(int count, Invoke invoke, void* body)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        invoke_ = invoke;
+        body_ = body;
+        count_ = count;
+        next_.store(0, std::memory_order_relaxed);
+        busy_ = static_cast<int>(threads_.size());
+        ++generation_;
+    }
+    wake_.notify_all();
+
+    drain();
+
+    // Every worker checks in, so none still holds this loop when the next one is posted
+    std::unique_lock<std::mutex> lock(mutex_);
+    idle_.wait(lock, [this] { return busy_ == 0; });
+}
+
+void WorkerPool::drain()
+{
+    for (int index = next_.fetch_add(1, std::memory_order_relaxed); index < count_;
+         index = next_.fetch_add(1, std::memory_order_relaxed))
+    {
+        invoke_(body_, index);
+    }
+}
+
+void WorkerPool::worker_loop()
+{
+    uint64_t seen = 0;
+    for (;;)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wake_.wait(lock, [&] { return stopping_ || generation_ != seen; });
+            if (stopping_)
+            {
+                return;
+            }
+            seen = generation_;
+        }
+
+        drain();
+
+        bool last = false;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            last = --busy_ == 0;
+        }
+        if (last)
+        {
+            idle_.notify_one();
+        }
+    }
+}
+
+}  // namespace elda
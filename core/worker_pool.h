@@ -0,0 +1,99 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace elda
+{
+
+/**
+ * WorkerPool - fixed set of threads that run one data-parallel loop at a time
+ *
+ * parallel_for() hands out indices one at a time from a shared counter, so
+ * uneven items (a channel whose cache must be rebuilt next to ones that only
+ * extend) balance themselves. The calling thread works on the loop too and
+ * returns once every index has run, so work can be fanned out in the middle of
+ * a frame without handing ownership of anything to the workers.
+ *
+ * Threading contract:
+ *  - One caller at a time (the UI thread); parallel_for() is not re-entrant.
+ *  - fn(index) runs concurrently for different indices: it must only write
+ *    state owned by that index.
+ *  - Everything fn writes is visible to the caller when parallel_for() returns.
+ */
+class WorkerPool
+{
+  public:
+    /**
+     * @param workers Threads to start besides the caller (0 = run every loop inline)
+     */
+    explicit WorkerPool(int workers);
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    /**
+     * Worker count that leaves a core each to the UI and acquisition threads
+     */
+    static int default_workers();
+
+    /**
+     * Run fn(i) for every i in [0, count) and wait for all of them
+     */
+    template <typename Fn>
+    void parallel_for(int count, Fn&& fn)
+    {
+        using Body = std::remove_reference_t<Fn>;
+        if (threads_.empty() || count <= 1)
+        {
+            for (int i = 0; i < count; ++i)
+            {
+                fn(i);
+            }
+            return;
+        }
+        run(
+            count,
+            [](void* body, int index)
+            {
+                (*static_cast<Body*>(body))(index);
+            },
+            const_cast<void*>(static_cast<const void*>(&fn)));
+    }
+
+    int workers() const
+    {
+        return static_cast<int>(threads_.size());
+    }
+
+  private:
+    using Invoke = void (*)(void* body, int index);
+
+    void run(int count, Invoke invoke, void* body);
+    void drain();
+    void worker_loop();
+
+    std::vector<std::thread> threads_;
+
+    std::mutex mutex_;
+    std::condition_variable wake_;  // New loop posted or stopping
+    std::condition_variable idle_;  // Last worker left the current loop
+    uint64_t generation_ = 0;       // Loops posted so far (guarded by mutex_)
+    int busy_ = 0;                  // Workers that have not finished the current loop (guarded by mutex_)
+    bool stopping_ = false;
+
+    // Current loop; written by the caller before the generation bump, read-only while it runs
+    Invoke invoke_ = nullptr;
+    void* body_ = nullptr;
+    int count_ = 0;
+    std::atomic<int> next_{0};
+};
+
+}  // namespace elda
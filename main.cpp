@@ -4,6 +4,7 @@
 #include "UI/toast/toast.h"
 #include "core/app_state_manager.h"
 #include "core/core.h"
+#include "core/frame_pacer.h"
 #include "core/router/IScreen.h"
 #include "core/router/app_router.h"
 #include "eeg_theme.h"
@@ -19,7 +20,9 @@
 #include "views/monitoring/monitoring_screen.h"
 #include "views/user_settings/user_settings_screen.h"
 
+#include <glad/glad.h>  // before GLFW so it provides the GL declarations
 #include <GLFW/glfw3.h>
+#include <cstdlib>
 #include <iostream>
 #include <memory>
 
@@ -57,6 +60,12 @@ int main()
     glfwMakeContextCurrent(window);
     glfwSwapInterval(1);
 
+    // GL entry points for the native trace renderer (the ImGui backend loads its own)
+    if (!gladLoadGLLoader(reinterpret_cast<GLADloadproc>(glfwGetProcAddress)))
+    {
+        std::cerr << "[Main] failed to load OpenGL entry points; chart traces stay on ImPlot" << std::endl;
+    }
+
     // ========================================================================
     // ImGui Setup
     // ========================================================================
@@ -96,8 +105,26 @@ int main()
     elda::AppStateManager state_manager(app_state);
 
     std::cout << "[Main] application state initialized" << std::endl;
-    std::cout << "[Main] channels: " << CHANNELS << std::endl;
-    std::cout << "[Main] sample rate: " << SAMPLE_RATE_HZ << " Hz" << std::endl;
+    std::cout << "[Main] channels: " << app_state.acquisition_format.channels << std::endl;
+    std::cout << "[Main] sample rate: " << app_state.acquisition_format.sample_rate_hz << " Hz" << std::endl;
+    std::printf("[Main] ring memory: %.2f MiB (%d slots x %d channels)\n",
+                app_state.ring.memory_bytes() / (1024.0 * 1024.0),
+                app_state.ring.capacity(),
+                app_state.ring.channels());
+
+    // ELDA_FRAME_CAP=30|60|120 picks the starting frame-rate cap while monitoring (the toolbar changes it live)
+    if (const char* cap = std::getenv("ELDA_FRAME_CAP"))
+    {
+        const int requested = std::atoi(cap);
+        for (int i = 0; i < FRAME_CAP_COUNT; ++i)
+        {
+            if (FRAME_CAP_OPTIONS[i] == requested)
+            {
+                state_manager.set_frame_cap(i);
+            }
+        }
+    }
+    std::printf("[Main] frame cap while monitoring: %d Hz\n", app_state.frame_cap_hz());
 
     // ========================================================================
     // Setup Router FIRST (before creating screens)
@@ -143,16 +170,29 @@ int main()
     // Main Loop
     // ========================================================================
     double last_time = glfwGetTime();
+    elda::FramePacer frame_pacer;
+    bool animating = false;  // As of the last frame: something moves without input
 
     while (!glfwWindowShouldClose(window))
     {
+        // Sleep until input arrives or the next frame is due (frame cap while animating, idle timeout otherwise)
+        const double cap_hz = app_state.frame_cap_hz();
+        for (double timeout; (timeout = frame_pacer.wait_timeout(glfwGetTime(), animating, cap_hz)) > 0.0;)
+        {
+            const double wait_start = glfwGetTime();
+            glfwWaitEventsTimeout(timeout);
+            if (glfwGetTime() - wait_start < timeout)
+            {
+                frame_pacer.on_event(animating);
+            }
+        }
+        glfwPollEvents();
+
         // delta_time
         double current_time = glfwGetTime();
         auto delta_time = static_cast<float>(current_time - last_time);
         last_time = current_time;
 
-        glfwPollEvents();
-
         // Start ImGui frame
         ImGui_ImplOpenGL3_NewFrame();
         ImGui_ImplGlfw_NewFrame();
@@ -242,6 +282,11 @@ int main()
         glClear(GL_COLOR_BUFFER_BIT);
         ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
         glfwSwapBuffers(window);
+
+        frame_pacer.frame_presented(glfwGetTime());
+        current_screen = router.get_current_screen();  // the hotkeys or a screen may have navigated
+        animating = (current_screen && current_screen->wants_continuous_redraw()) ||
+                    elda::ui::Toast::instance().is_visible();
     }
 
     // ========================================================================
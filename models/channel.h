@@ -21,6 +21,7 @@ struct Channel final : BaseModel
     bool filtered = false;
     double high_pass_cutoff = 0.0;
     double low_pass_cutoff = 0.0;
+    double notch_frequency = 0.0;
 
     float impedance_x = 0.0f;
     float impedance_y = 0.0f;
@@ -58,13 +59,18 @@ struct Channel final : BaseModel
         }
     }
 
-    void set_filtering(const bool enable, const double high_pass = 0.0, const double low_pass = 0.0)
+    void set_filtering(const bool enable,
+                       const double high_pass = 0.0,
+                       const double low_pass = 0.0,
+                       const double notch = 0.0)
     {
-        if (filtered != enable || high_pass_cutoff != high_pass || low_pass_cutoff != low_pass)
+        if (filtered != enable || high_pass_cutoff != high_pass || low_pass_cutoff != low_pass ||
+            notch_frequency != notch)
         {
             filtered = enable;
             high_pass_cutoff = high_pass;
             low_pass_cutoff = low_pass;
+            notch_frequency = notch;
             on_update();
         }
     }
@@ -28,7 +28,8 @@ ChannelManagementService::ChannelManagementService()
             {
                 oss << ch.get_id() << "|" << ch.name << "|" << ch.color << "|" << ch.selected << "|"
                     << ch.amplifier_channel << "|" << ch.signal_type << "|" << ch.sensor_gain << "|" << ch.sensor_offset
-                    << "|" << ch.filtered << "|" << ch.high_pass_cutoff << "|" << ch.low_pass_cutoff << "\n";
+                    << "|" << ch.filtered << "|" << ch.high_pass_cutoff << "|" << ch.low_pass_cutoff << "|"
+                    << ch.notch_frequency << "\n";
             }
             return oss.str();
         },
@@ -67,6 +68,10 @@ ChannelManagementService::ChannelManagementService()
                     ch.filtered = (tokens[8] == "1");
                     ch.high_pass_cutoff = std::stod(tokens[9]);
                     ch.low_pass_cutoff = std::stod(tokens[10]);
+                    if (tokens.size() >= 12)
+                    {
+                        ch.notch_frequency = std::stod(tokens[11]);
+                    }
                     channels.push_back(ch);
                 }
             }
@@ -55,6 +55,12 @@ void AdminSettingsPresenter::setup_callbacks()
         model_.set_active_tab(tab_index);
         std::cout << "[AdminSettings] Tab changed to: " << tab_index << "\n";
     };
+
+    view_.channels_presenter().set_on_channel_applied(
+        [this](const channels_config::ChannelConfig& config)
+        {
+            handle_channel_applied(config);
+        });
 }
 
 void AdminSettingsPresenter::sync_form_to_model()
@@ -117,6 +123,30 @@ void AdminSettingsPresenter::handle_save()
     router_.return_to_previous_mode();
 }
 
+void AdminSettingsPresenter::handle_channel_applied(const channels_config::ChannelConfig& config)
+{
+    // The config's source is the 1-based amplifier channel; filters reach the acquisition via models::Channel
+    const auto* channels = state_manager_.get_state().available_channels;
+    if (!channels)
+    {
+        return;
+    }
+    for (const auto& channel : *channels)
+    {
+        if (channel.amplifier_channel != config.source_main - 1)
+        {
+            continue;
+        }
+        models::Channel updated = channel;
+        channels_config::apply_filtering(config, updated);
+        if (auto result = state_manager_.update_channel(updated); !result)
+        {
+            std::cout << "[AdminSettings] Channel " << config.id << " filters not applied: " << result.message << "\n";
+        }
+        return;
+    }
+}
+
 void AdminSettingsPresenter::handle_close()
 {
     std::cout << "[AdminSettings] Close without saving\n";
@@ -26,6 +26,7 @@ class AdminSettingsPresenter
     void sync_form_to_model();
     void handle_save();
     void handle_close();
+    void handle_channel_applied(const channels_config::ChannelConfig& config);
 
     AdminSettingsModel& model_;
     AdminSettingsView& view_;
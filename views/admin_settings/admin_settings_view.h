@@ -50,6 +50,11 @@ class AdminSettingsView
         return channels_model_;
     }
 
+    channels_config::ChannelsConfigPresenter& channels_presenter()
+    {
+        return *channels_presenter_;
+    }
+
   private:
     void setup_tabs();
     void render_tab_bar(const AdminSettingsViewData& data, const AdminSettingsViewCallbacks& callbacks);
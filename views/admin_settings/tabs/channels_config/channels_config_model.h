@@ -1,5 +1,8 @@
 #pragma once
 
+#include "models/channel.h"
+
+#include <algorithm>
 #include <string>
 #include <vector>
 
@@ -50,6 +53,12 @@ inline const char* signal_type_to_string(SignalType type)
     }
 }
 
+// True for an ECG/EMG channel's models::Channel::signal_type (also the "ECG" / "EMG" of older channel files)
+inline bool is_ecg_emg(const std::string& signal_type)
+{
+    return signal_type == signal_type_to_string(SignalType::ECG_EMG) || signal_type == "ECG" || signal_type == "EMG";
+}
+
 // Source differential mode
 enum class SourceDiff
 {
@@ -102,6 +111,24 @@ inline const char* hpf_to_string(HPFOption hpf)
     }
 }
 
+// Cutoff in Hz (models::Channel::high_pass_cutoff; 0 = DC coupled)
+inline double hpf_cutoff_hz(HPFOption hpf)
+{
+    switch (hpf)
+    {
+        case HPFOption::HPF_0001:
+            return 0.001;
+        case HPFOption::HPF_001:
+            return 0.01;
+        case HPFOption::HPF_01:
+            return 0.1;
+        case HPFOption::HPF_1:
+            return 1.0;
+        default:
+            return 0.0;
+    }
+}
+
 // LPF options (Low-pass filter)
 enum class LPFOption
 {
@@ -125,6 +152,20 @@ inline const char* lpf_to_string(LPFOption lpf)
     }
 }
 
+// Cutoff in Hz (models::Channel::low_pass_cutoff; 0 = off)
+inline double lpf_cutoff_hz(LPFOption lpf)
+{
+    switch (lpf)
+    {
+        case LPFOption::LPF_250:
+            return 250.0;
+        case LPFOption::LPF_500:
+            return 500.0;
+        default:
+            return 0.0;
+    }
+}
+
 // ADF options (Notch filter)
 enum class ADFOption
 {
@@ -148,6 +189,20 @@ inline const char* adf_to_string(ADFOption adf)
     }
 }
 
+// Notch frequency in Hz (models::Channel::notch_frequency; 0 = off)
+inline double adf_frequency_hz(ADFOption adf)
+{
+    switch (adf)
+    {
+        case ADFOption::ADF_50:
+            return 50.0;
+        case ADFOption::ADF_60:
+            return 60.0;
+        default:
+            return 0.0;
+    }
+}
+
 // Single channel configuration
 struct ChannelConfig
 {
@@ -165,6 +220,15 @@ struct ChannelConfig
     std::string color = "#1ACC94";        // Display color (hex)
 };
 
+// Copy a config's HPF / LPF / ADF choices onto the acquisition channel it maps to
+inline void apply_filtering(const ChannelConfig& config, models::Channel& channel)
+{
+    channel.set_filtering(config.hpf != HPFOption::DC || config.lpf != LPFOption::NONE || config.adf != ADFOption::OFF,
+                          hpf_cutoff_hz(config.hpf),
+                          lpf_cutoff_hz(config.lpf),
+                          adf_frequency_hz(config.adf));
+}
+
 // Model for managing all channels
 class ChannelsConfigModel
 {
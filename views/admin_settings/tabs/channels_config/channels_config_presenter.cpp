@@ -19,6 +19,10 @@ void ChannelsConfigPresenter::setup_callbacks()
         {
             *ch = updated;
             std::cout << "[ChannelsConfig] Channel " << id << " updated\n";
+            if (on_channel_applied_)
+            {
+                on_channel_applied_(*ch);
+            }
         }
     };
 }
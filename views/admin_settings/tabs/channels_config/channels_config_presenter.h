@@ -3,6 +3,9 @@
 #include "channels_config_model.h"
 #include "channels_config_view.h"
 
+#include <functional>
+#include <utility>
+
 namespace elda::views::channels_config
 {
 
@@ -13,12 +16,19 @@ class ChannelsConfigPresenter
 
     void render();
 
+    // Called with each channel config after an edit is applied to the model
+    void set_on_channel_applied(std::function<void(const ChannelConfig&)> callback)
+    {
+        on_channel_applied_ = std::move(callback);
+    }
+
   private:
     void setup_callbacks();
 
     ChannelsConfigModel& model_;
     ChannelsConfigView& view_;
     ChannelsConfigCallbacks callbacks_;
+    std::function<void(const ChannelConfig&)> on_channel_applied_;
 };
 
 }  // namespace elda::views::channels_config
@@ -1,5 +1,6 @@
 #include "impedance_viewer_model.h"
 
+#include "UI/chart/chart.h"
 #include "services/channel_management_service.h"
 
 #include <algorithm>
@@ -10,6 +11,15 @@
 namespace elda::views::impedance_viewer
 {
 
+namespace
+{
+constexpr double k_topomap_hz = 15.0;      // Map refresh rate while monitoring
+constexpr double k_topomap_max_hz = 45.0;  // Top of the highest band
+constexpr int k_topomap_frames = 8;        // Frames averaged per electrode (1 s of 8x-overlapped frames)
+constexpr float k_range_smoothing = 0.2f;  // Weight of the newest range per update
+constexpr float k_min_range_db = 3.0f;
+}  // namespace
+
 ImpedanceViewerModel::ImpedanceViewerModel(const std::vector<elda::models::Channel>& available_channels,
                                            AppStateManager& state_manager)
     : available_channels_(available_channels), state_manager_(state_manager)
@@ -19,7 +29,94 @@ ImpedanceViewerModel::ImpedanceViewerModel(const std::vector<elda::models::Chann
 
 void ImpedanceViewerModel::update()
 {
-    // Update logic if needed (e.g., real-time impedance readings)
+    if (is_topomap_live())
+    {
+        const auto now = std::chrono::steady_clock::now();
+        if (now - last_topomap_update_ >= std::chrono::duration<double>(1.0 / k_topomap_hz))
+        {
+            last_topomap_update_ = now;
+            update_topomap();
+        }
+    }
+}
+
+void ImpedanceViewerModel::toggle_topomap()
+{
+    topomap_enabled_ = !topomap_enabled_;
+    clear_selection();
+    std::cout << "[ImpedanceViewerModel] Topomap " << (topomap_enabled_ ? "on" : "off") << "\n";
+}
+
+void ImpedanceViewerModel::select_topomap_band(int band)
+{
+    if (band >= 0 && band < k_topomap_band_count && band != topomap_band_)
+    {
+        topomap_band_ = band;
+        last_topomap_update_ = {};  // refresh now
+    }
+}
+
+void ImpedanceViewerModel::update_topomap()
+{
+    const SampleRing& ring = state_manager_.get_state().ring;
+
+    // Electrodes with a ring channel: the amplifier index when it is valid, else the channel's list position
+    std::vector<int> electrodes;
+    std::vector<int> channels;
+    for (size_t i = 0; i < electrode_positions_.size(); ++i)
+    {
+        const models::Channel* channel = get_channel_by_id(electrode_positions_[i].channel_id);
+        if (!channel)
+        {
+            continue;
+        }
+        int ring_channel = channel->amplifier_channel;
+        if (ring_channel < 0 || ring_channel >= ring.channels())
+        {
+            ring_channel = static_cast<int>(channel - available_channels_.data());
+        }
+        if (ring_channel < ring.channels())
+        {
+            electrodes.push_back(static_cast<int>(i));
+            channels.push_back(ring_channel);
+        }
+    }
+
+    const double rate = ring.sample_rate_hz();
+    const dsp::SpectrogramShape shape = dsp::SpectrogramShape::for_rate(rate, k_topomap_max_hz, k_topomap_frames);
+    if (channels != band_spectrogram_.channels() || rate != band_spectrogram_.sample_rate_hz() ||
+        shape != band_spectrogram_.shape())
+    {
+        band_spectrogram_.configure(channels, rate, shape);
+    }
+    band_spectrogram_.advance(ring, ring.published(), INT64_MAX, chart_worker_pool());
+
+    const FrequencyBand& band = k_topomap_bands[topomap_band_];
+    topomap_.electrodes = std::move(electrodes);
+    topomap_.values_db.resize(topomap_.electrodes.size());
+    float low = 0.0f;
+    float high = 0.0f;
+    for (size_t row = 0; row < topomap_.values_db.size(); ++row)
+    {
+        const double power =
+            band_spectrogram_.band_power(static_cast<int>(row), band.low_hz, band.high_hz, k_topomap_frames);
+        const float db = static_cast<float>(10.0 * std::log10(std::max(power, 1e-10)));
+        topomap_.values_db[row] = db;
+        low = row == 0 ? db : std::min(low, db);
+        high = row == 0 ? db : std::max(high, db);
+    }
+
+    // Follow the spread of the electrodes without flickering on every update
+    if (high - low < k_min_range_db)
+    {
+        const float mid = 0.5f * (low + high);
+        low = mid - 0.5f * k_min_range_db;
+        high = mid + 0.5f * k_min_range_db;
+    }
+    const bool first = topomap_.generation == 0;
+    topomap_.low_db = first ? low : topomap_.low_db + k_range_smoothing * (low - topomap_.low_db);
+    topomap_.high_db = first ? high : topomap_.high_db + k_range_smoothing * (high - topomap_.high_db);
+    ++topomap_.generation;
 }
 
 void ImpedanceViewerModel::initialize_from_channels()
@@ -1,7 +1,9 @@
 #pragma once
 #include "core/app_state_manager.h"
+#include "core/dsp/spectrogram.h"
 #include "models/channel.h"
 
+#include <chrono>
 #include <map>
 #include <string>
 #include <vector>
@@ -17,6 +19,37 @@ struct ElectrodePosition
     bool is_dragging = false;
 };
 
+/**
+ * EEG band mapped by the topomap
+ */
+struct FrequencyBand
+{
+    const char* name;
+    double low_hz;
+    double high_hz;
+};
+
+inline constexpr FrequencyBand k_topomap_bands[] = {
+    {"Delta", 1.0, 4.0},
+    {"Theta", 4.0, 8.0},
+    {"Alpha", 8.0, 13.0},
+    {"Beta", 13.0, 30.0},
+    {"Gamma", 30.0, 45.0},
+};
+inline constexpr int k_topomap_band_count = sizeof(k_topomap_bands) / sizeof(k_topomap_bands[0]);
+
+/**
+ * Latest band power per mapped electrode
+ */
+struct TopomapFrame
+{
+    std::vector<int> electrodes;   // Indices into the electrode positions that have a ring channel
+    std::vector<float> values_db;  // 10 log10(µV²), aligned with electrodes
+    float low_db = 0.0f;           // Colour range, smoothed across updates
+    float high_db = 1.0f;
+    uint64_t generation = 0;  // Bumped on every update
+};
+
 class ImpedanceViewerModel
 {
   public:
@@ -34,6 +67,22 @@ class ImpedanceViewerModel
     {
         return selected_electrode_index_;
     }
+    bool is_topomap_enabled() const
+    {
+        return topomap_enabled_;
+    }
+    bool is_topomap_live() const
+    {
+        return topomap_enabled_ && state_manager_.is_monitoring();
+    }
+    int get_topomap_band() const
+    {
+        return topomap_band_;
+    }
+    const TopomapFrame& get_topomap() const
+    {
+        return topomap_;
+    }
 
     void update();
     void initialize_from_channels();
@@ -42,6 +91,8 @@ class ImpedanceViewerModel
     void stop_dragging(size_t index);
     void select_electrode(int index);
     void clear_selection();
+    void toggle_topomap();
+    void select_topomap_band(int band);
 
     void save_positions_to_state();
     void discard_changes();
@@ -52,6 +103,7 @@ class ImpedanceViewerModel
   private:
     void notify_position_changed();
     void initialize_default_positions();
+    void update_topomap();
 
     std::vector<ElectrodePosition> electrode_positions_;
     std::map<std::string, std::pair<float, float>> original_positions_;
@@ -60,6 +112,13 @@ class ImpedanceViewerModel
 
     int selected_electrode_index_ = -1;
     const float cap_radius_ = 0.48f;
+
+    // Topomap: band power from a short Welch average over the live ring, refreshed at a fixed rate
+    bool topomap_enabled_ = false;
+    int topomap_band_ = 2;  // Alpha
+    TopomapFrame topomap_;
+    dsp::StreamingSpectrogram band_spectrogram_;
+    std::chrono::steady_clock::time_point last_topomap_update_{};
 };
 
 }  // namespace elda::views::impedance_viewer
@@ -37,6 +37,9 @@ void ImpedanceViewerPresenter::render()
     viewData.electrodes = &model_.get_electrode_positions();
     viewData.available_channels = &model_.get_available_channels();
     viewData.selected_electrode_index = model_.get_selected_electrode_index();
+    viewData.topomap = model_.is_topomap_enabled() ? &model_.get_topomap() : nullptr;
+    viewData.topomap_live = model_.is_topomap_live();
+    viewData.topomap_band = model_.get_topomap_band();
 
     view_.render(viewData, callbacks_);
 }
@@ -70,6 +73,16 @@ void ImpedanceViewerPresenter::setup_callbacks()
         router_.transition_to(AppMode::USER_SETTINGS);
     };
 
+    callbacks_.on_toggle_topomap = [this]()
+    {
+        model_.toggle_topomap();
+    };
+
+    callbacks_.on_topomap_band_selected = [this](int band)
+    {
+        model_.select_topomap_band(band);
+    };
+
     callbacks_.on_monitoring = [this]()
     {
         std::cout << "[ImpedanceViewer] Monitoring\n";
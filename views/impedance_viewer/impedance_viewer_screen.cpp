@@ -31,4 +31,10 @@ void ImpedanceViewerScreen::render()
     presenter_.render();
 }
 
+bool ImpedanceViewerScreen::wants_continuous_redraw() const
+{
+    // A live topomap refreshes on its own; electrode editing only changes on input
+    return model_.is_topomap_live();
+}
+
 }  // namespace elda::views::impedance_viewer
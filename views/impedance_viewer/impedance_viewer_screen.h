@@ -18,6 +18,7 @@ class ImpedanceViewerScreen : public IScreen
     void on_exit() override;
     void update(float dt) override;
     void render() override;
+    bool wants_continuous_redraw() const override;
 
   private:
     ImpedanceViewerModel model_;
@@ -1,5 +1,6 @@
 #include "impedance_viewer_view.h"
 
+#include "UI/colormap/colormap.h"
 #include "UI/impedance_range/impedance_range.h"
 #include "UI/screen_header/screen_header.h"
 #include "imgui_internal.h"
@@ -7,6 +8,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstdio>
 
 namespace elda::views::impedance_viewer
 {
@@ -29,7 +31,12 @@ void ImpedanceViewerView::render(const ImpedanceViewerViewData& data, const Impe
     ui::render_screen_header({.title = "Impedance Setup",
                               .show_back_button = true,
                               .on_back = callbacks.on_back,
-                              .buttons = {{.label = "SETTINGS",
+                              .buttons = {{.label = data.topomap ? "ELECTRODES" : "TOPOMAP",
+                                           .on_click = callbacks.on_toggle_topomap,
+                                           .enabled = true,
+                                           .primary = false,
+                                           .width = 110.0f},
+                                          {.label = "SETTINGS",
                                            .on_click = callbacks.on_settings,
                                            .enabled = true,
                                            .primary = false,
@@ -65,6 +72,12 @@ void ImpedanceViewerView::render_body(const ImpedanceViewerViewData& data,
         "impedance_canvas", canvas_size_, ImGuiButtonFlags_MouseButtonLeft | ImGuiButtonFlags_MouseButtonRight);
     const bool canvas_hovered = ImGui::IsItemHovered();
 
+    if (data.topomap)
+    {
+        render_topomap(draw_list, data, callbacks);
+        return;
+    }
+
     draw_cap_outline(draw_list, center_pos_, pixel_cap_radius_);
     if (k_show_grid_default_)
         draw_cap_grid(draw_list, center_pos_, pixel_cap_radius_);
@@ -125,6 +138,118 @@ void ImpedanceViewerView::render_body(const ImpedanceViewerViewData& data,
     }
 }
 
+void ImpedanceViewerView::render_topomap(ImDrawList* draw_list,
+                                         const ImpedanceViewerViewData& data,
+                                         const ImpedanceViewerViewCallbacks& callbacks)
+{
+    const TopomapFrame& frame = *data.topomap;
+    const std::vector<ElectrodePosition>& electrodes = *data.electrodes;
+
+    // The interpolation is rebuilt only when the mapped electrodes moved or changed
+    if (frame.generation != topomap_generation_ && topomap_renderer_.available())
+    {
+        std::vector<ImVec2> layout;
+        layout.reserve(frame.electrodes.size());
+        for (int index : frame.electrodes)
+        {
+            layout.emplace_back(electrodes[index].x, electrodes[index].y);
+        }
+        if (topomap_renderer_.set_layout(layout))
+        {
+            topomap_renderer_.update(frame.values_db, frame.low_db, frame.high_db);
+        }
+        topomap_generation_ = frame.generation;
+    }
+
+    topomap_renderer_.draw(draw_list, center_pos_, pixel_cap_radius_);
+    draw_cap_outline(draw_list, center_pos_, pixel_cap_radius_);
+
+    // Mapped electrodes as small markers with their names
+    for (int index : frame.electrodes)
+    {
+        const ElectrodePosition& electrode = electrodes[index];
+        const ImVec2 pos = cap_normalized_to_screen(center_pos_, pixel_cap_radius_, electrode.x, electrode.y);
+        draw_list->AddCircleFilled(pos, 2.5f, IM_COL32(0, 0, 0, 255));
+
+        const elda::models::Channel* channel = nullptr;
+        for (const auto& c : *data.available_channels)
+        {
+            if (c.id == electrode.channel_id)
+            {
+                channel = &c;
+                break;
+            }
+        }
+        if (channel)
+        {
+            draw_list->AddText(ImVec2(pos.x + 4.0f, pos.y - ImGui::GetTextLineHeight()),
+                               IM_COL32(235, 235, 240, 255),
+                               channel->name.c_str());
+        }
+    }
+
+    if (!data.topomap_live || !topomap_renderer_.has_map())
+    {
+        const char* note = topomap_renderer_.available() ? "Start monitoring to map band power"
+                                                         : "Topomap needs an OpenGL 3.2 context";
+        const ImVec2 note_size = ImGui::CalcTextSize(note);
+        draw_list->AddText(ImVec2(center_pos_.x - note_size.x * 0.5f, center_pos_.y - note_size.y * 0.5f),
+                           ImGui::GetColorU32(ImGuiCol_Text),
+                           note);
+    }
+
+    // Band selector and colour scale below the cap, where the impedance range panel sits otherwise
+    const float panel_width = std::min(420.0f, canvas_size_.x * 0.60f);
+    ImVec2 panel_pos(center_pos_.x - panel_width * 0.5f, center_pos_.y + pixel_cap_radius_ + 40.0f);
+    ImGui::SetCursorScreenPos(panel_pos);
+    for (int band = 0; band < k_topomap_band_count; ++band)
+    {
+        if (band > 0)
+        {
+            ImGui::SameLine();
+        }
+        const bool active = band == data.topomap_band;
+        if (active)
+        {
+            ImGui::PushStyleColor(ImGuiCol_Button, ImGui::GetStyleColorVec4(ImGuiCol_ButtonActive));
+        }
+        if (ImGui::Button(k_topomap_bands[band].name) && callbacks.on_topomap_band_selected)
+        {
+            callbacks.on_topomap_band_selected(band);
+        }
+        if (active)
+        {
+            ImGui::PopStyleColor();
+        }
+    }
+
+    const float bar_top = panel_pos.y + ImGui::GetFrameHeightWithSpacing() + 6.0f;
+    const float bar_height = 12.0f;
+    const uint32_t* colormap = ui::viridis_colormap();
+    constexpr int segments = 16;
+    for (int s = 0; s < segments; ++s)
+    {
+        const float x0 = panel_pos.x + panel_width * s / segments;
+        const float x1 = panel_pos.x + panel_width * (s + 1) / segments;
+        const ImU32 left = colormap[(ui::k_colormap_size - 1) * s / segments];
+        const ImU32 right = colormap[(ui::k_colormap_size - 1) * (s + 1) / segments];
+        draw_list->AddRectFilledMultiColor(
+            ImVec2(x0, bar_top), ImVec2(x1, bar_top + bar_height), left, right, right, left);
+    }
+
+    const FrequencyBand& band = k_topomap_bands[data.topomap_band];
+    char scale[96];
+    std::snprintf(scale,
+                  sizeof(scale),
+                  "%s %.0f-%.0f Hz   %.1f .. %.1f dB uV^2",
+                  band.name,
+                  band.low_hz,
+                  band.high_hz,
+                  frame.low_db,
+                  frame.high_db);
+    draw_list->AddText(ImVec2(panel_pos.x, bar_top + bar_height + 4.0f), ImGui::GetColorU32(ImGuiCol_Text), scale);
+}
+
 void ImpedanceViewerView::render_electrodes(ImDrawList* draw_list,
                                             const std::vector<ElectrodePosition>& electrodes,
                                             const std::vector<elda::models::Channel>& available_channels,
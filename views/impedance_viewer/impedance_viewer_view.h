@@ -1,5 +1,6 @@
 #pragma once
 #include "UI/screen_header/screen_header.h"
+#include "UI/topomap/topomap_renderer.h"
 #include "imgui.h"
 #include "impedance_viewer_model.h"
 
@@ -17,6 +18,8 @@ struct ImpedanceViewerViewCallbacks
     std::function<void()> on_back;
     std::function<void()> on_settings;
     std::function<void()> on_monitoring;
+    std::function<void()> on_toggle_topomap;
+    std::function<void(int band)> on_topomap_band_selected;
 };
 
 struct ImpedanceViewerViewData
@@ -24,6 +27,11 @@ struct ImpedanceViewerViewData
     const std::vector<ElectrodePosition>* electrodes = nullptr;
     const std::vector<elda::models::Channel>* available_channels = nullptr;
     int selected_electrode_index = -1;
+
+    // Topomap mode (nullptr = electrode editing)
+    const TopomapFrame* topomap = nullptr;
+    bool topomap_live = false;
+    int topomap_band = 0;
 };
 
 class ImpedanceViewerView
@@ -43,8 +51,15 @@ class ImpedanceViewerView
     ImVec2 center_pos_{};
     float pixel_cap_radius_ = 0.0f;
 
+    ui::TopomapRenderer topomap_renderer_;
+    uint64_t topomap_generation_ = 0;  // Frame last uploaded
+
     void render_body(const ImpedanceViewerViewData& data, const ImpedanceViewerViewCallbacks& callbacks);
 
+    void render_topomap(ImDrawList* draw_list,
+                        const ImpedanceViewerViewData& data,
+                        const ImpedanceViewerViewCallbacks& callbacks);
+
     void render_electrodes(ImDrawList* draw_list,
                            const std::vector<ElectrodePosition>& electrodes,
                            const std::vector<elda::models::Channel>& available_channels,
@@ -2,6 +2,8 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
 
 namespace elda::views::monitoring
@@ -11,22 +13,44 @@ MonitoringModel::MonitoringModel(AppState& state, elda::AppStateManager& state_m
     : models::MVPBaseModel(state_manager), state_(state), state_manager_(state_manager)
 {
     initialize_buffers();
+    state_observer_ = add_state_observer(
+        [this](StateField field)
+        {
+            on_state_changed(field);
+        });
+}
+
+MonitoringModel::~MonitoringModel()
+{
+    remove_state_observer(state_observer_);
 }
 
 void MonitoringModel::initialize_buffers()
 {
-    chart_data_.num_channels = CHANNELS;
-    chart_data_.sample_rate_hz = (int)SAMPLE_RATE_HZ;
-    chart_data_.buffer_size = kBufferSize;
+    chart_data_.num_channels = state_.ring.channels();
+    chart_data_.sample_rate_hz = (int)state_.ring.sample_rate_hz();
+    chart_data_.buffer_size = state_.ring.capacity();
     chart_data_.amplitude_pp_uv = state_.amp_pp_uv();
     chart_data_.window_seconds = state_.window_sec();
     chart_data_.gain_multiplier = state_.gain_mul();
     chart_data_.playhead_seconds = 0.0;
 
-    chart_data_.ring.t_abs.clear();
-    chart_data_.ring.data.clear();
+    chart_data_.ring.source = &state_.ring;
+    chart_data_.ring.published = 0;
     chart_data_.ring.write = 0;
     chart_data_.ring.filled = false;
+    chart_data_.pyramid = &state_.pyramid;
+    chart_data_.average = &state_.average_ring;
+
+    rebuild_render_cache();
+    chart_data_.channels = &render_cache_;
+
+    // ELDA_CHART_BACKEND=opengl starts on the GPU trace renderer (e.g. CI under Mesa llvmpipe)
+    const char* backend = std::getenv("ELDA_CHART_BACKEND");
+    if (backend && std::strcmp(backend, "opengl") == 0)
+    {
+        chart_data_.backend = ChartBackend::OpenGL;
+    }
 }
 
 void MonitoringModel::start_acquisition()
@@ -39,13 +63,13 @@ void MonitoringModel::stop_acquisition()
     std::cout << "[Model] Stop acquisition" << std::endl;
 }
 
-void MonitoringModel::update(float delta_time)
+void MonitoringModel::update(float /*delta_time*/)
 {
     if (state_manager_.is_monitoring())
     {
+        // Samples are ingested by the acquisition thread; the frame only snapshots them
         state_.tick_display(true);
         update_chart_data();
-        generate_synthetic_data(delta_time);
     }
     else
     {
@@ -53,53 +77,75 @@ void MonitoringModel::update(float delta_time)
     }
 }
 
-void MonitoringModel::generate_synthetic_data(float /*delta_time*/)
+void MonitoringModel::update_chart_data()
 {
-    static SynthEEG synth_gen;
-    std::vector<float> sample(CHANNELS);
+    chart_data_.window_seconds = state_.window_sec();
 
-    int samples_this_frame = state_.sampler.due();
+    // One acquire load pins the snapshot; everything below `published` is complete.
+    // The chart reads the ring in place, so this is O(1) regardless of buffer size.
+    // Sessions faster than the display rate are drawn from the resampled display stream.
+    const bool resampled = state_.acquisition_format.resamples_display();
+    const auto& ring = resampled ? state_.display_ring : state_.ring;
+    const uint64_t published = ring.published();
+    chart_data_.playhead_seconds = ring.time_at(published);
+
+    // Format can change between sessions (ring is re-shaped when monitoring starts)
+    chart_data_.num_channels = ring.channels();
+    chart_data_.sample_rate_hz = (int)ring.sample_rate_hz();
+
+    chart_data_.ring.source = &ring;
+    chart_data_.ring.published = published;
+    chart_data_.ring.write = ring.slot_of(published);
+    chart_data_.ring.filled = published >= static_cast<uint64_t>(ring.capacity());
+    chart_data_.pyramid = resampled ? &state_.display_pyramid : &state_.pyramid;
+    chart_data_.average = resampled ? &state_.display_average_ring : &state_.average_ring;
+    chart_data_.buffer_size = ring.capacity();
+}
 
-    for (int i = 0; i < samples_this_frame; ++i)
+void MonitoringModel::on_state_changed(StateField field)
+{
+    switch (field)
     {
-        synth_gen.next(sample);
-
-        for (int ch = 0; ch < CHANNELS; ++ch)
-        {
-            sample[ch] *= state_.noise_scale;
-        }
-
-        state_.ring.push(sample);
+        case StateField::ChannelConfig:
+        case StateField::Monitoring:  // starting re-shapes the ring, which bounds the amplifier indices
+            rebuild_render_cache();
+            break;
+        case StateField::DisplayAmplitude:
+            chart_data_.amplitude_pp_uv = state_.amp_pp_uv();
+            chart_data_.gain_multiplier = state_.gain_mul();
+            break;
+        default:
+            break;
     }
 }
 
-void MonitoringModel::update_chart_data()
+void MonitoringModel::rebuild_render_cache()
 {
-    chart_data_.amplitude_pp_uv = state_.amp_pp_uv();
-    chart_data_.window_seconds = state_.window_sec();
-    chart_data_.gain_multiplier = state_.gain_mul();
-    chart_data_.playhead_seconds = state_.ring.now;
-
-    chart_data_.ring.t_abs.resize(BUFFER_SIZE);
-    chart_data_.ring.data.resize(CHANNELS);
-
-    for (int i = 0; i < BUFFER_SIZE; ++i)
+    render_cache_.rebuild(state_.selected_channels, state_.ring.channels());
+    if (montage_kind_ == dsp::MontageKind::Referential)
     {
-        chart_data_.ring.t_abs[i] = static_cast<double>(state_.ring.t_abs[i]);
+        chart_data_.montage = nullptr;
+        return;
     }
 
-    for (int ch = 0; ch < CHANNELS; ++ch)
+    // Electrodes as the referential rows resolved them (amplifier index, name, colour)
+    const std::vector<ui::ChannelRenderDescriptor> referential = render_cache_.rows();
+    const std::vector<const models::Channel*>& selected = state_.selected_channels;
+    std::vector<dsp::MontageElectrode> electrodes(referential.size());
+    for (size_t row = 0; row < referential.size(); ++row)
     {
-        chart_data_.ring.data[ch].resize(BUFFER_SIZE);
-        for (int i = 0; i < BUFFER_SIZE; ++i)
+        dsp::MontageElectrode& electrode = electrodes[row];
+        electrode.channel = referential[row].channel;
+        electrode.name = referential[row].label;
+        if (row < selected.size() && selected[row])
         {
-            chart_data_.ring.data[ch][i] = static_cast<double>(state_.ring.data[ch][i]);
+            electrode.x = selected[row]->impedance_x;
+            electrode.y = selected[row]->impedance_y;
         }
     }
-
-    chart_data_.ring.write = state_.ring.write;
-    chart_data_.ring.filled = state_.ring.filled;
-    chart_data_.buffer_size = BUFFER_SIZE;
+    montage_.build(montage_kind_, electrodes, state_.ring.channels());
+    render_cache_.rebuild(montage_, referential);
+    chart_data_.montage = &montage_;
 }
 
 // ============================================================================
@@ -119,15 +165,32 @@ void MonitoringModel::toggle_monitoring() const
     else
     {
         std::printf("[Model] Monitor toggle SUCCESS - new: %s\n", !monitoring ? "MONITORING" : "IDLE");
+    }
+}
 
-        if (!monitoring)
-        {
-            std::printf("[Model] Resetting ring buffer\n");
-            state_.ring.reset();
-            state_.playhead_seconds = 0.0;
-            state_.sampler = SampleClock(SAMPLE_RATE_HZ);
-        }
+void MonitoringModel::toggle_chart_backend()
+{
+    chart_data_.backend =
+        chart_data_.backend == ChartBackend::OpenGL ? ChartBackend::ImPlot : ChartBackend::OpenGL;
+    std::printf("[Model] Chart backend: %s\n", chart_data_.backend == ChartBackend::OpenGL ? "OpenGL" : "ImPlot");
+}
+
+void MonitoringModel::toggle_chart_view()
+{
+    chart_data_.view = chart_data_.view == ChartView::Spectrogram ? ChartView::Sweep : ChartView::Spectrogram;
+    std::printf("[Model] Chart view: %s\n", chart_data_.view == ChartView::Spectrogram ? "Spectrogram" : "Sweep");
+}
+
+void MonitoringModel::select_montage(dsp::MontageKind kind)
+{
+    if (kind == montage_kind_)
+    {
+        return;
     }
+    // Rows are re-derived from the ring at read time: no acquisition or ring change
+    montage_kind_ = kind;
+    rebuild_render_cache();
+    std::printf("[Model] Montage: %s\n", dsp::montage_to_string(kind));
 }
 
 void MonitoringModel::stop_recording() const
@@ -203,6 +266,22 @@ void MonitoringModel::decrease_amplitude() const
     }
 }
 
+void MonitoringModel::increase_frame_cap() const
+{
+    if (state_.frame_cap_idx < FRAME_CAP_COUNT - 1)
+    {
+        state_manager_.set_frame_cap(state_.frame_cap_idx + 1);
+    }
+}
+
+void MonitoringModel::decrease_frame_cap() const
+{
+    if (state_.frame_cap_idx > 0)
+    {
+        state_manager_.set_frame_cap(state_.frame_cap_idx - 1);
+    }
+}
+
 void MonitoringModel::refresh_available_groups() const
 {
     auto& service = services::ChannelManagementService::get_instance();
@@ -1,9 +1,11 @@
 #ifndef ELDA_MONITORING_MODEL_H
 #define ELDA_MONITORING_MODEL_H
 
+#include "UI/chart/channel_render_cache.h"
 #include "UI/chart/chart_data.h"
 #include "core/app_state_manager.h"
 #include "core/core.h"
+#include "core/dsp/montage.h"
 #include "models/channels_group.h"
 #include "models/mvp_base_model.h"
 #include "services/channel_management_service.h"
@@ -15,7 +17,7 @@ class MonitoringModel : public models::MVPBaseModel
 {
   public:
     MonitoringModel(AppState& state, elda::AppStateManager& state_manager);
-    ~MonitoringModel() = default;
+    ~MonitoringModel() override;
 
     // Lifecycle
     void start_acquisition();
@@ -32,7 +34,12 @@ class MonitoringModel : public models::MVPBaseModel
     void decrease_window() const;
     void increase_amplitude() const;
     void decrease_amplitude() const;
+    void increase_frame_cap() const;
+    void decrease_frame_cap() const;
     void apply_channel_configuration(const elda::models::ChannelsGroup& group) const;
+    void toggle_chart_backend();
+    void toggle_chart_view();
+    void select_montage(dsp::MontageKind kind);
 
     void refresh_available_groups() const;
 
@@ -86,9 +93,25 @@ class MonitoringModel : public models::MVPBaseModel
     {
         return state_manager_.get_amplitude_micro_volts();
     }
+    int get_frame_cap_hz() const
+    {
+        return state_manager_.get_frame_cap_hz();
+    }
+    ChartBackend get_chart_backend() const
+    {
+        return chart_data_.backend;
+    }
+    ChartView get_chart_view() const
+    {
+        return chart_data_.view;
+    }
+    dsp::MontageKind get_montage() const
+    {
+        return montage_kind_;
+    }
     double get_sample_rate_hz() const
     {
-        return SAMPLE_RATE_HZ;
+        return state_.ring.sample_rate_hz();
     }
 
     const std::vector<models::ChannelsGroup>& get_available_groups() const
@@ -98,15 +121,24 @@ class MonitoringModel : public models::MVPBaseModel
 
     int get_active_group_index() const;
 
+    acquisition::AcquisitionStats get_acquisition_stats() const
+    {
+        return state_manager_.get_acquisition_stats();
+    }
+
   private:
     AppState& state_;
     AppStateManager& state_manager_;
     ChartData chart_data_;
-    static constexpr int kBufferSize = 25000;
+    ui::ChannelRenderCache render_cache_;  // Row colours/labels/IDs for chart_data_
+    dsp::MontageKind montage_kind_ = dsp::MontageKind::Referential;
+    dsp::Montage montage_;  // Rows of chart_data_ unless referential
+    AppStateManager::ObserverHandle state_observer_ = 0;
 
     void initialize_buffers();
-    void generate_synthetic_data(float delta_time);
     void update_chart_data();
+    void on_state_changed(StateField field);
+    void rebuild_render_cache();
 };
 
 }  // namespace elda::views::monitoring
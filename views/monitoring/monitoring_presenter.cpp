@@ -59,7 +59,11 @@ void MonitoringPresenter::render()
     view_data.currently_paused = model_.is_currently_paused();
     view_data.window_seconds = model_.get_window_seconds();
     view_data.amplitude_micro_volts = model_.get_amplitude_micro_volts();
+    view_data.frame_cap_hz = model_.get_frame_cap_hz();
     view_data.sample_rate_hz = model_.get_sample_rate_hz();
+    view_data.chart_backend = model_.get_chart_backend();
+    view_data.chart_view = model_.get_chart_view();
+    view_data.montage = model_.get_montage();
     view_data.active_group_index = model_.get_active_group_index();
     view_data.selected_channels = &model_.get_selected_channels();
 
@@ -111,6 +115,26 @@ void MonitoringPresenter::setup_callbacks()
     {
         model_.decrease_amplitude();
     };
+    callbacks_.on_increase_frame_cap = [this]()
+    {
+        model_.increase_frame_cap();
+    };
+    callbacks_.on_decrease_frame_cap = [this]()
+    {
+        model_.decrease_frame_cap();
+    };
+    callbacks_.on_toggle_chart_backend = [this]()
+    {
+        model_.toggle_chart_backend();
+    };
+    callbacks_.on_toggle_chart_view = [this]()
+    {
+        model_.toggle_chart_view();
+    };
+    callbacks_.on_montage_selected = [this](dsp::MontageKind kind)
+    {
+        model_.select_montage(kind);
+    };
 
     callbacks_.on_create_channel_group = [this]()
     {
@@ -53,4 +53,10 @@ void MonitoringScreen::render()
     presenter_->render();
 }
 
+bool MonitoringScreen::wants_continuous_redraw() const
+{
+    // The sweep (and the recording dot) only move while monitoring; a stopped chart is static
+    return model_->is_monitoring();
+}
+
 }  // namespace elda::views::monitoring
\ No newline at end of file
@@ -24,6 +24,7 @@ class MonitoringScreen : public IScreen
     void on_exit() override;
     void render() override;
     void update(float dt) override;
+    bool wants_continuous_redraw() const override;
 
   private:
     std::unique_ptr<MonitoringModel> model_;
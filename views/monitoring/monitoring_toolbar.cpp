@@ -253,6 +253,36 @@ render_amplitude_controls(const MonitoringViewData& data, const MonitoringViewCa
     }
 }
 
+// -----------------------------------------------------------------------------
+// Frame-rate Cap Controls (fixed)
+// -----------------------------------------------------------------------------
+static void
+render_frame_cap_controls(const MonitoringViewData& data, const MonitoringViewCallbacks& callbacks, float /*toolbar_h*/)
+{
+    ImGui::SameLine();
+    ImGui::Dummy(ImVec2(12, 1));
+    ImGui::SameLine();
+
+    if (square_button("-##fps"))
+    {
+        if (callbacks.on_decrease_frame_cap)
+            callbacks.on_decrease_frame_cap();
+    }
+
+    ImGui::SameLine();
+    ImGui::AlignTextToFramePadding();  // << aligns label with buttons
+    ImGui::Text("%d fps", data.frame_cap_hz);
+    if (ImGui::IsItemHovered(ImGuiHoveredFlags_DelayNormal))
+        ImGui::SetTooltip("Frame-rate cap while monitoring");
+
+    ImGui::SameLine();
+    if (square_button("+##fps"))
+    {
+        if (callbacks.on_increase_frame_cap)
+            callbacks.on_increase_frame_cap();
+    }
+}
+
 // -----------------------------------------------------------------------------
 // Section: Impedance Viewer Ω Button (perfectly centered icon)
 // -----------------------------------------------------------------------------
@@ -295,6 +325,103 @@ static void render_impedance_button(const MonitoringViewCallbacks& callbacks)
         ImGui::SetTooltip("Open Impedance Viewer");
 }
 
+// -----------------------------------------------------------------------------
+// Section: Chart backend toggle (ImPlot / OpenGL traces)
+// -----------------------------------------------------------------------------
+static void render_backend_toggle(const MonitoringViewData& data, const MonitoringViewCallbacks& callbacks)
+{
+    ImGui::SameLine();
+
+    const bool gl = data.chart_backend == ChartBackend::OpenGL;
+    if (gl)
+    {
+        ImGui::PushStyleColor(ImGuiCol_Button, ImGui::GetStyleColorVec4(ImGuiCol_ButtonActive));
+    }
+    if (square_button("GL##chart_backend", 8.0f))
+    {
+        if (callbacks.on_toggle_chart_backend)
+            callbacks.on_toggle_chart_backend();
+    }
+    if (gl)
+    {
+        ImGui::PopStyleColor();
+    }
+
+    if (ImGui::IsItemHovered(ImGuiHoveredFlags_DelayNormal))
+        ImGui::SetTooltip(gl ? "Traces: OpenGL (click for ImPlot)" : "Traces: ImPlot (click for OpenGL)");
+}
+
+// -----------------------------------------------------------------------------
+// Section: Chart view toggle (sweep / spectrogram)
+// -----------------------------------------------------------------------------
+static void render_view_toggle(const MonitoringViewData& data, const MonitoringViewCallbacks& callbacks)
+{
+    ImGui::SameLine();
+
+    const bool spectrogram = data.chart_view == ChartView::Spectrogram;
+    if (spectrogram)
+    {
+        ImGui::PushStyleColor(ImGuiCol_Button, ImGui::GetStyleColorVec4(ImGuiCol_ButtonActive));
+    }
+    if (square_button("FFT##chart_view", 8.0f))
+    {
+        if (callbacks.on_toggle_chart_view)
+            callbacks.on_toggle_chart_view();
+    }
+    if (spectrogram)
+    {
+        ImGui::PopStyleColor();
+    }
+
+    if (ImGui::IsItemHovered(ImGuiHoveredFlags_DelayNormal))
+        ImGui::SetTooltip(spectrogram ? "View: spectrogram (click for traces)"
+                                      : "View: traces (click for spectrogram)");
+}
+
+// -----------------------------------------------------------------------------
+// Section: Montage selector (rows of the active group tab)
+// -----------------------------------------------------------------------------
+static void render_montage_selector(const MonitoringViewData& data, const MonitoringViewCallbacks& callbacks)
+{
+    static constexpr dsp::MontageKind k_montages[] = {dsp::MontageKind::Referential,
+                                                      dsp::MontageKind::CommonAverage,
+                                                      dsp::MontageKind::Bipolar,
+                                                      dsp::MontageKind::Laplacian};
+    static constexpr const char* k_tooltips[] = {"Montage: referential (as recorded)",
+                                                 "Montage: common average reference",
+                                                 "Montage: longitudinal bipolar (double banana)",
+                                                 "Montage: Laplacian (nearest neighbours on the cap)"};
+
+    ImGui::SameLine();
+    ImGui::TextDisabled("|");
+
+    for (int i = 0; i < 4; ++i)
+    {
+        const dsp::MontageKind kind = k_montages[i];
+        const bool active = data.montage == kind;
+
+        ImGui::SameLine();
+        ImGui::PushID(i);
+        if (active)
+        {
+            ImGui::PushStyleColor(ImGuiCol_Button, ImGui::GetStyleColorVec4(ImGuiCol_ButtonActive));
+        }
+        if (square_button(dsp::montage_to_string(kind), 8.0f) && !active)
+        {
+            if (callbacks.on_montage_selected)
+                callbacks.on_montage_selected(kind);
+        }
+        if (active)
+        {
+            ImGui::PopStyleColor();
+        }
+        ImGui::PopID();
+
+        if (ImGui::IsItemHovered(ImGuiHoveredFlags_DelayNormal))
+            ImGui::SetTooltip("%s", k_tooltips[i]);
+    }
+}
+
 // ======================= status (right) =======================
 static void render_status_info(const MonitoringViewData& data, float /*toolbar_h*/)
 {
@@ -341,7 +468,11 @@ float MonitoringToolbar(const MonitoringViewData& data, const MonitoringViewCall
     render_recording_controls(data, callbacks, header_h);
     render_window_controls(data, callbacks, header_h);
     render_amplitude_controls(data, callbacks, header_h);
+    render_frame_cap_controls(data, callbacks, header_h);
     render_impedance_button(callbacks);
+    render_backend_toggle(data, callbacks);
+    render_view_toggle(data, callbacks);
+    render_montage_selector(data, callbacks);
     render_status_info(data, header_h);
 
     ImGui::EndChild();
@@ -8,7 +8,7 @@ namespace elda::views::monitoring
  * Reusable Toolbar Component
  *
  * Renders a horizontal toolbar with monitoring controls, recording buttons,
- * window/amplitude adjustments, and status indicators.
+ * window/amplitude/frame-cap adjustments, and status indicators.
  *
  * @param data - MonitoringViewData containing display state
  * @param callbacks - MonitoringViewCallbacks for user interactions
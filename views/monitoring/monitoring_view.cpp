@@ -26,9 +26,13 @@ void MonitoringView::render(const MonitoringViewData& data, const MonitoringView
     ImVec2 available_size = ImGui::GetContentRegionAvail();
     ImGui::BeginChild("ChartArea", ImVec2(available_size.x, available_size.y), false, ImGuiWindowFlags_NoScrollbar);
 
-    if (data.chart_data)
+    if (data.chart_data && data.chart_data->view == ChartView::Spectrogram)
     {
-        draw_chart(*data.chart_data, *data.selected_channels);
+        draw_spectrogram(*data.chart_data);
+    }
+    else if (data.chart_data)
+    {
+        draw_chart(*data.chart_data);
     }
 
     ImGui::EndChild();
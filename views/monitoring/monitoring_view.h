@@ -2,6 +2,7 @@
 #include "UI/chart/chart_data.h"
 #include "UI/tabbar/tabbar.h"
 #include "core/core.h"
+#include "core/dsp/montage.h"
 #include "models/channel.h"
 #include "models/channels_group.h"
 
@@ -28,7 +29,11 @@ struct MonitoringViewData
     bool currently_paused = false;
     int window_seconds = 10;
     int amplitude_micro_volts = 100;
+    int frame_cap_hz = 60;
     double sample_rate_hz = 1000.0;
+    ChartBackend chart_backend = ChartBackend::ImPlot;
+    ChartView chart_view = ChartView::Sweep;
+    dsp::MontageKind montage = dsp::MontageKind::Referential;
     RecordingState recording_state;
 
     // Tab bar
@@ -50,8 +55,13 @@ struct MonitoringViewCallbacks
     std::function<void()> on_decrease_window;
     std::function<void()> on_increase_amplitude;
     std::function<void()> on_decrease_amplitude;
+    std::function<void()> on_increase_frame_cap;
+    std::function<void()> on_decrease_frame_cap;
     std::function<void()> on_open_impedance_viewer;
     std::function<void()> on_stop_recording;
+    std::function<void()> on_toggle_chart_backend;
+    std::function<void()> on_toggle_chart_view;
+    std::function<void(dsp::MontageKind)> on_montage_selected;
 
     // Tab actions
     std::function<void()> on_create_channel_group;
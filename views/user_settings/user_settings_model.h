@@ -41,7 +41,9 @@ struct MRISettings
 {
     std::string scanner_id;
     int tr_ms = 2000;
+    int trigger_channel = 0;  // Amplifier channel carrying the volume trigger (1-based; 0 = onsets every tr_ms)
     bool gradient_correction = false;
+    bool pulse_correction = false;  // Ballistocardiogram removal, R-peaks from the ECG/EMG channel
 };
 
 // Custom/NVX acquisition settings
@@ -49,6 +51,8 @@ struct CustomSettings
 {
     int nvx_mode = 0;                // 0=Normal, 1=Active Shield, 2=Impedance, 3=Test Signal
     int sampling_rate = 1000;        // 250, 500, 1000, 5000, 10000, 25000
+    int display_rate = 500;          // Chart stream: 0 = sampling rate, 250, 500, 1000
+    int storage_rate = 0;            // Recorder stream: 0 = sampling rate, 250 .. 5000
     int nvx_gain = 0;                // 0, 1
     int nvx_power_save = 1;          // 0=Disable, 1=Enable
     int nvx_scan_freq = 0;           // 0=30Hz, 1=80Hz
@@ -80,7 +80,9 @@ void UserSettingsPresenter::sync_form_to_model()
         auto& mri = model_.mri_settings();
         mri.scanner_id = form.get_string("scanner_id");
         mri.tr_ms = form.get_int("tr_ms");
+        mri.trigger_channel = form.get_int("trigger_channel");
         mri.gradient_correction = form.get_bool("gradient_correction");
+        mri.pulse_correction = form.get_bool("pulse_correction");
     }
 
     // Custom/NVX settings
@@ -89,6 +91,8 @@ void UserSettingsPresenter::sync_form_to_model()
         auto& custom = model_.custom_settings();
         custom.nvx_mode = form.get_selected_value("nvx_mode");
         custom.sampling_rate = form.get_selected_value("sampling_rate");
+        custom.display_rate = form.get_selected_value("display_rate");
+        custom.storage_rate = form.get_selected_value("storage_rate");
         custom.nvx_gain = form.get_selected_value("nvx_gain");
         custom.nvx_power_save = form.get_selected_value("nvx_power_save");
         custom.nvx_scan_freq = form.get_selected_value("nvx_scan_freq");
@@ -125,6 +129,10 @@ void UserSettingsPresenter::handle_proceed()
         const auto& custom = model_.custom_settings();
         std::cout << "  NVX Mode: " << custom.nvx_mode << "\n"
                   << "  Sampling Rate: " << custom.sampling_rate << " Hz\n"
+                  << "  Display Rate: "
+                  << (custom.display_rate > 0 ? std::to_string(custom.display_rate) + " Hz" : "Sampling rate") << "\n"
+                  << "  Storage Rate: "
+                  << (custom.storage_rate > 0 ? std::to_string(custom.storage_rate) + " Hz" : "Sampling rate") << "\n"
                   << "  NVX Gain: " << custom.nvx_gain << "\n"
                   << "  Power Save: " << (custom.nvx_power_save ? "Enable" : "Disable") << "\n"
                   << "  Scan Freq: " << (custom.nvx_scan_freq ? "80Hz" : "30Hz") << "\n"
@@ -132,6 +140,61 @@ void UserSettingsPresenter::handle_proceed()
                   << "  SW Impedance Reduction: " << (custom.sw_impedance_reduction ? "On" : "Off") << "\n";
     }
 
+    if (model_.get_mode() == AcquisitionMode::MRI)
+    {
+        const auto& mri = model_.mri_settings();
+        std::cout << "  Scanner: " << mri.scanner_id << "\n"
+                  << "  TR: " << mri.tr_ms << " ms\n"
+                  << "  Trigger Channel: " << (mri.trigger_channel > 0 ? std::to_string(mri.trigger_channel) : "None")
+                  << "\n"
+                  << "  Gradient Correction: " << (mri.gradient_correction ? "On" : "Off") << "\n"
+                  << "  Pulse Correction: " << (mri.pulse_correction ? "On" : "Off") << "\n";
+    }
+
+    // Custom mode drives the NVX136 at the chosen rate; channel count stays with the current montage
+    AcquisitionFormat format = state_manager_.get_acquisition_format();
+    if (model_.get_mode() == AcquisitionMode::CUSTOM)
+    {
+        const auto& custom = model_.custom_settings();
+        format.sample_rate_hz = static_cast<float>(custom.sampling_rate);
+        format.display_rate_hz = static_cast<float>(custom.display_rate);
+        format.storage_rate_hz = static_cast<float>(custom.storage_rate);
+        format.amplifier = AmplifierKind::SimulatedNvx136;
+    }
+    else
+    {
+        format.display_rate_hz = DEFAULT_DISPLAY_RATE_HZ;
+        format.storage_rate_hz = 0.0f;
+        format.amplifier = AmplifierKind::Synthetic;
+    }
+    if (auto result = state_manager_.set_acquisition_format(format); !result)
+    {
+        std::cout << "[UserSettings] Acquisition format rejected: " << result.message << "\n";
+        return;
+    }
+
+    // Only MRI sessions subtract the scanner's gradient and pulse artifacts
+    dsp::GradientCorrectionSpec gradient;
+    dsp::PulseCorrectionSpec pulse;
+    if (model_.get_mode() == AcquisitionMode::MRI)
+    {
+        const auto& mri = model_.mri_settings();
+        gradient.enabled = mri.gradient_correction;
+        gradient.tr_ms = mri.tr_ms;
+        gradient.trigger_channel = mri.trigger_channel - 1;
+        pulse.enabled = mri.pulse_correction;
+    }
+    if (auto result = state_manager_.set_gradient_correction(gradient); !result)
+    {
+        std::cout << "[UserSettings] Gradient correction rejected: " << result.message << "\n";
+        return;
+    }
+    if (auto result = state_manager_.set_pulse_correction(pulse); !result)
+    {
+        std::cout << "[UserSettings] Pulse correction rejected: " << result.message << "\n";
+        return;
+    }
+
     router_.transition_to(AppMode::CAP_PLACEMENT);
 }
 
@@ -1,5 +1,7 @@
 #include "user_settings_view.h"
 
+#include "core/core.h"
+
 #include <cstring>
 
 namespace elda::views::user_settings
@@ -24,6 +26,17 @@ void UserSettingsView::setup_form()
 
     form_.add_multiline("notes", "Notes").size(250.0f, 80.0f);
 
+    // MRI fields
+    form_.add_text("scanner_id", "Scanner ID").width(180.0f);
+
+    form_.add_int("tr_ms", "TR (ms)").range(100, 20000).default_value(2000);
+
+    form_.add_int("trigger_channel", "Trigger Channel").range(0, MAX_CHANNELS).default_value(0);
+
+    form_.add_checkbox("gradient_correction", "Gradient Correction").default_value(true);
+
+    form_.add_checkbox("pulse_correction", "Pulse (BCG) Correction").default_value(true);
+
     // Custom/NVX fields
     form_.add_select("nvx_mode", "NVX Mode")
         .options({{"Normal Acquisition", 0}, {"Active Shield", 1}, {"Impedance", 2}, {"Test Signal", 3}})
@@ -39,6 +52,20 @@ void UserSettingsView::setup_form()
         .width(180.0f)
         .default_index(2);
 
+    form_.add_select("display_rate", "Display Rate")
+        .options({{"Sampling rate", 0}, {"1000 Hz", 1000}, {"500 Hz", 500}, {"250 Hz", 250}})
+        .width(180.0f)
+        .default_index(2);
+
+    form_.add_select("storage_rate", "Storage Rate")
+        .options({{"Sampling rate", 0},
+                  {"5000 Hz", 5000},
+                  {"2000 Hz", 2000},
+                  {"1000 Hz", 1000},
+                  {"500 Hz", 500},
+                  {"250 Hz", 250}})
+        .width(180.0f);
+
     form_.add_select("nvx_gain", "NVX Gain").options({{"0", 0}, {"1", 1}}).width(80.0f);
 
     form_.add_select("nvx_power_save", "Power Save")
@@ -119,7 +146,9 @@ void UserSettingsView::render_content()
     ImGui::BeginGroup();
 
     const float label_width = 130.0f;
+    bool is_mri = form_.get_selected_index("mode") == 1;
     bool is_custom = form_.get_selected_index("mode") == 2;
+    bool has_settings_column = is_mri || is_custom;
 
     // Section: Acquisition Mode
     ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(0.85f, 0.87f, 0.90f, 1.0f));
@@ -134,10 +163,10 @@ void UserSettingsView::render_content()
     ImGui::Spacing();
     ImGui::Spacing();
 
-    // Two columns: Patient Info | Hardware Config (if custom)
-    float col_width = is_custom ? max_form_width / 2.0f : max_form_width;
-    ImGui::Columns(is_custom ? 2 : 1, nullptr, false);
-    if (is_custom)
+    // Two columns: Patient Info | MRI Settings (if MRI) or Hardware Config (if custom)
+    float col_width = has_settings_column ? max_form_width / 2.0f : max_form_width;
+    ImGui::Columns(has_settings_column ? 2 : 1, nullptr, false);
+    if (has_settings_column)
     {
         ImGui::SetColumnWidth(0, col_width);
         ImGui::SetColumnWidth(1, col_width);
@@ -161,6 +190,36 @@ void UserSettingsView::render_content()
     if (auto* f = form_.get_field("notes"))
         f->render(label_width);
 
+    // Right column: MRI Settings (only if MRI mode)
+    if (is_mri)
+    {
+        ImGui::NextColumn();
+
+        const float mri_label_width = 145.0f;
+
+        ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(0.85f, 0.87f, 0.90f, 1.0f));
+        ImGui::Text("MRI Settings");
+        ImGui::PopStyleColor();
+        ImGui::Spacing();
+
+        if (auto* f = form_.get_field("scanner_id"))
+            f->render(mri_label_width);
+        ImGui::Spacing();
+        if (auto* f = form_.get_field("tr_ms"))
+            f->render(mri_label_width);
+        ImGui::Spacing();
+        if (auto* f = form_.get_field("trigger_channel"))
+            f->render(mri_label_width);
+        ImGui::TextDisabled("0 = volume onsets every TR");
+        ImGui::Spacing();
+        if (auto* f = form_.get_field("gradient_correction"))
+            f->render(mri_label_width);
+        ImGui::Spacing();
+        if (auto* f = form_.get_field("pulse_correction"))
+            f->render(mri_label_width);
+        ImGui::TextDisabled("R-peaks from the ECG/EMG channel");
+    }
+
     // Right column: Hardware Configuration (only if Custom mode)
     if (is_custom)
     {
@@ -179,6 +238,13 @@ void UserSettingsView::render_content()
         if (auto* f = form_.get_field("sampling_rate"))
             f->render(hw_label_width);
         ImGui::Spacing();
+        if (auto* f = form_.get_field("display_rate"))
+            f->render(hw_label_width);
+        ImGui::Spacing();
+        if (auto* f = form_.get_field("storage_rate"))
+            f->render(hw_label_width);
+        ImGui::TextDisabled("Rates at or above the sampling rate use it as is");
+        ImGui::Spacing();
         if (auto* f = form_.get_field("nvx_gain"))
             f->render(hw_label_width);
         ImGui::Spacing();